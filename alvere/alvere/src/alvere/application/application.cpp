@@ -11,14 +11,16 @@
 #include "alvere/debug/command_console/param.hpp"
 #include "alvere/debug/exceptions.hpp"
 #include "alvere/debug/logging.hpp"
+#include "alvere/graphics/frame_constants.hpp"
 #include "alvere/graphics/render_commands.hpp"
+#include "alvere/graphics/texture_loader.hpp"
 
 namespace alvere
 {
 	static std::unique_ptr<console::Command> s_quitCommand;
 
 	Application::Application(const Window::Properties & properties)
-		: m_window(Window::create(properties)), m_targetFrameRate(60.0f), m_running(true)
+		: m_window(Window::create(properties)), m_targetFrameRate(60.0f), m_tickInterpolation(0.0f), m_running(true)
 	{
 		m_windowCloseEventHandler.setFunction([&]() {
 			m_running = false;
@@ -50,6 +52,7 @@ namespace alvere
 		int framesThisSecond = 0;
 
 		auto tickStartTime = std::chrono::high_resolution_clock::now();
+		auto runStartTime = tickStartTime;
 		std::chrono::nanoseconds timeStep((int)timeStepNanoseconds);
 		std::chrono::nanoseconds deltaTimeChrono;
 		std::chrono::nanoseconds lag(0);
@@ -84,6 +87,14 @@ namespace alvere
 					update(timeStepSeconds);
 				}
 
+				m_tickInterpolation = (float) lag.count() / (float) timeStep.count();
+
+				std::chrono::duration<float> runTime = std::chrono::high_resolution_clock::now() - runStartTime;
+				FrameConstants::get().setTime(runTime.count());
+
+				TextureLoader::get().uploadPending();
+
+				//Still submitted on this thread, see RenderThread for what moving it needs
 				m_window->getRenderingContext().bindFrameBuffer();
 
 				render();
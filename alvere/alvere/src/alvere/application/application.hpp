@@ -26,6 +26,9 @@ namespace alvere
 
 		float m_targetFrameRate;
 
+		//How far the current frame is between the last fixed update and the next one, in [0, 1)
+		float m_tickInterpolation;
+
 	private:
 
 		bool m_running;
@@ -8,6 +8,7 @@
 #include <glad/gl.h>
 
 #include "graphics_api/opengl/opengl_errors.hpp"
+#include "graphics_api/opengl/opengl_state_cache.hpp"
 #include "graphics_api/opengl/opengl_vertex_array.hpp"
 
 #include "alvere/application/window.hpp"
@@ -195,6 +196,19 @@ namespace alvere::console
 				_outputContent->clear();
 				return CompositeText(_defaultTextFormatting);
 			}));
+
+			_builtInCommands.emplace_back(std::make_unique<Command>(
+				"render.gl_state",
+				"Displays how many OpenGL state changes were made and how many were skipped as redundant during the last frame.",
+				std::vector<IParam *> {},
+				[&](std::vector<const IArg *> args) -> CompositeText
+			{
+				const graphics_api::opengl::StateCache::Counters & counters = graphics_api::opengl::StateCache::get().getFrameCounters();
+
+				CompositeText output(_defaultTextFormatting);
+				output.append("Last frame: " + std::to_string(counters.issued) + " state changes made, " + std::to_string(counters.skipped) + " skipped.");
+				return output;
+			}));
 			/*
 			_builtInCommands.emplace_back(std::make_unique<Command>(
 				"console.expand",
@@ -389,7 +403,7 @@ namespace alvere::console
 			_vao->AddVertexBuffer(_vbo);
 
 
-			_spriteBatcher = SpriteBatcher::New();
+			_spriteBatcher = SpriteBatcher::New(4096);
 
 			_initialised = true;
 
@@ -510,6 +524,8 @@ namespace alvere::console
 				_spriteBatcher->submit(*bitmap, pageCounter, Vector2(_window->getSize().x - (3.0f + bitmap->getTextSize(pageCounter).x), 6.0f));
 			}
 
+			graphics_api::opengl::StateCache::get().setCapability(GL_BLEND, false);
+
 			_shaderProgram->bind();
 			_shaderProgram->sendUniformInt1("u_outputLineCount", lineCount < _maxOutputLineCount ? lineCount : _maxOutputLineCount);
 			_vao->Bind();
@@ -49,4 +49,9 @@ namespace alvere
 	{
 		return m_Count;
 	}
+
+	unsigned int IndexBuffer::GetIndexSize() const
+	{
+		return m_IndexSize;
+	}
 }
\ No newline at end of file
@@ -65,6 +65,9 @@ namespace alvere
 	public:
 		static IndexBuffer * New(const unsigned int * indices, unsigned int count);
 
+		//Half the size, for meshes of no more than 65536 vertices
+		static IndexBuffer * New(const unsigned short * indices, unsigned int count);
+
 		IndexBuffer() = default;
 		IndexBuffer(const IndexBuffer& vertexBuffer) = delete;
 		IndexBuffer& operator=(const IndexBuffer& vertexBuffer) = delete;
@@ -72,10 +75,14 @@ namespace alvere
 
 		unsigned int GetCount() const;
 
+		//Bytes per index, 2 or 4
+		unsigned int GetIndexSize() const;
+
 		virtual void Bind() = 0;
 		virtual void Unbind() = 0;
 
 	protected:
 		unsigned int m_Count;
+		unsigned int m_IndexSize;
 	};
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "alvere/graphics/camera.hpp"
 
+#include <algorithm>
+#include <limits>
+
 #include "alvere/math/matrix/transformations.hpp"
 
 namespace alvere
@@ -121,4 +124,26 @@ namespace alvere
 	{
 		return getProjectionMatrix().inverse() * Vector4(worldPosition.x, worldPosition.y, worldPosition.z, 1.0f);
 	}
-}
\ No newline at end of file
+
+	alvere::Rect Camera::getVisibleBounds() const
+	{
+		Matrix4 inverseProjectionView = getProjectionViewMatrix().inverse();
+
+		Vector2 lower(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+		Vector2 upper(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			Vector4 clip((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : -1.0f, 1.0f);
+			Vector4 world = inverseProjectionView * clip;
+
+			world.x /= world.w;
+			world.y /= world.w;
+
+			lower = Vector2(std::min(lower.x, world.x), std::min(lower.y, world.y));
+			upper = Vector2(std::max(upper.x, world.x), std::max(upper.y, world.y));
+		}
+
+		return Rect(lower, upper - lower);
+	}
+}
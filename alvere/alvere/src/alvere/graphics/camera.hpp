@@ -4,6 +4,7 @@
 #include "alvere/math/quaternion.hpp"
 #include "alvere/math/vector/vector_2.hpp"
 #include "alvere/math/vector/vector_3.hpp"
+#include "alvere/utils/shapes.hpp"
 
 namespace alvere
 {
@@ -33,6 +34,10 @@ namespace alvere
 		Vector3 screenToWorld(const Vector2 & screenPosition, int windowWidth, int windowHeight) const;
 		Vector2 worldToScreen(const Vector3 & worldPosition) const;
 
+		//The world space area on the xy plane that the camera can see, found by unprojecting the corners of
+		//clip space. Exact for an unrotated orthographic camera and a conservative fit for anything else.
+		Rect getVisibleBounds() const;
+
 	private:
 		Vector3 m_position;
 		Quaternion m_rotation;
@@ -0,0 +1,105 @@
+#include "alvere/graphics/command_list.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace alvere
+{
+	static std::size_t alignSize(std::size_t size)
+	{
+		const std::size_t alignment = alignof(std::max_align_t);
+		return (size + alignment - 1) & ~(alignment - 1);
+	}
+
+	CommandList::CommandList(std::size_t blockSize)
+		: m_blockSize(blockSize), m_currentBlock(0), m_commandCount(0), m_byteCount(0)
+	{
+	}
+
+	CommandList::~CommandList()
+	{
+		clear();
+	}
+
+	void CommandList::execute()
+	{
+		consume<true>();
+	}
+
+	void CommandList::clear()
+	{
+		consume<false>();
+	}
+
+	void * CommandList::allocate(std::size_t size, void (*execute)(void *), void (*destroy)(void *))
+	{
+		std::size_t headerSize = alignSize(sizeof(Header));
+		std::size_t stride = headerSize + alignSize(size);
+
+		while (m_currentBlock < m_blocks.size() && m_blocks[m_currentBlock].m_used + stride > m_blocks[m_currentBlock].m_capacity)
+		{
+			++m_currentBlock;
+		}
+
+		if (m_currentBlock == m_blocks.size())
+		{
+			//Commands bigger than a block get a block of their own
+			std::size_t capacity = std::max(m_blockSize, stride);
+			m_blocks.push_back(Block{ std::make_unique<unsigned char[]>(capacity), capacity, 0 });
+		}
+
+		Block & block = m_blocks[m_currentBlock];
+		unsigned char * memory = block.m_data.get() + block.m_used;
+		block.m_used += stride;
+		m_byteCount += stride;
+
+		new (memory) Header{ execute, destroy, stride };
+
+		return memory + headerSize;
+	}
+
+	template <bool Execute>
+	void CommandList::consume()
+	{
+		std::size_t headerSize = alignSize(sizeof(Header));
+		std::exception_ptr exception;
+
+		for (std::size_t i = 0; i < m_blocks.size() && i <= m_currentBlock; ++i)
+		{
+			Block & block = m_blocks[i];
+
+			for (std::size_t offset = 0; offset < block.m_used;)
+			{
+				Header * header = reinterpret_cast<Header *>(block.m_data.get() + offset);
+				void * command = block.m_data.get() + offset + headerSize;
+
+				//Once a command has thrown the rest are only destroyed, so the list is always left empty
+				if (Execute && exception == nullptr)
+				{
+					try
+					{
+						header->m_execute(command);
+					}
+					catch (...)
+					{
+						exception = std::current_exception();
+					}
+				}
+
+				header->m_destroy(command);
+				offset += header->m_stride;
+			}
+
+			block.m_used = 0;
+		}
+
+		m_currentBlock = 0;
+		m_commandCount = 0;
+		m_byteCount = 0;
+
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace alvere
+{
+	//A list of commands recorded on one thread and executed, in order, later or on another thread.
+	//Commands are any callable and don't care which graphics API they end up calling into. They are stored
+	//inline in blocks the list keeps between frames, so recording doesn't allocate once the list has warmed up.
+	//Anything a command reads must be captured by value, or outlive the list's execution.
+	class CommandList
+	{
+	public:
+
+		CommandList(std::size_t blockSize = 64 * 1024);
+
+		~CommandList();
+
+		CommandList(const CommandList &) = delete;
+		CommandList & operator=(const CommandList &) = delete;
+
+		template <typename Function>
+		void record(Function && function)
+		{
+			using Command = std::decay_t<Function>;
+			static_assert(alignof(Command) <= alignof(std::max_align_t), "Commands cannot be over aligned");
+
+			void * memory = allocate(sizeof(Command), &executeCommand<Command>, &destroyCommand<Command>);
+			new (memory) Command(std::forward<Function>(function));
+			++m_commandCount;
+		}
+
+		//Runs every command in the order they were recorded, then clears the list
+		void execute();
+
+		//Throws the commands away without running them
+		void clear();
+
+		std::size_t getCommandCount() const { return m_commandCount; }
+
+		//Bytes taken by the commands recorded since the last clear
+		std::size_t getByteCount() const { return m_byteCount; }
+
+	private:
+
+		struct Header
+		{
+			void (*m_execute)(void *);
+			void (*m_destroy)(void *);
+
+			//From the start of this header to the start of the next
+			std::size_t m_stride;
+		};
+
+		struct Block
+		{
+			std::unique_ptr<unsigned char[]> m_data;
+			std::size_t m_capacity;
+			std::size_t m_used;
+		};
+
+		std::size_t m_blockSize;
+		std::vector<Block> m_blocks;
+		std::size_t m_currentBlock;
+
+		std::size_t m_commandCount;
+		std::size_t m_byteCount;
+
+		//Reserves space for a header and a command and returns where the command goes
+		void * allocate(std::size_t size, void (*execute)(void *), void (*destroy)(void *));
+
+		//Runs the function on every command, then destroys them
+		template <bool Execute>
+		void consume();
+
+		template <typename Command>
+		static void executeCommand(void * command)
+		{
+			(*static_cast<Command *>(command))();
+		}
+
+		template <typename Command>
+		static void destroyCommand(void * command)
+		{
+			static_cast<Command *>(command)->~Command();
+		}
+	};
+}
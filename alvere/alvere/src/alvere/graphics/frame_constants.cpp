@@ -0,0 +1,49 @@
+#include "alvere/graphics/frame_constants.hpp"
+
+#include <cstring>
+
+namespace alvere
+{
+	static_assert(sizeof(FrameConstants::Block) == 208, "FrameConstants::Block must match the std140 layout of the shader block");
+
+	FrameConstants::FrameConstants()
+		: m_block{ Matrix4::identity, Matrix4::identity, Matrix4::identity, 0.0f, {} }, m_changed(true), m_uploadCount(0)
+	{ }
+
+	void FrameConstants::setCamera(const Camera & camera)
+	{
+		setCamera(camera.getProjectionMatrix(), camera.getViewMatrix());
+	}
+
+	void FrameConstants::setCamera(const Matrix4 & projectionMatrix, const Matrix4 & viewMatrix)
+	{
+		//Most frames draw everything with one camera, so beginning again with it shouldn't cause another upload
+		if (std::memcmp(&m_block.m_projectionMatrix, &projectionMatrix, sizeof(Matrix4)) == 0
+			&& std::memcmp(&m_block.m_viewMatrix, &viewMatrix, sizeof(Matrix4)) == 0)
+			return;
+
+		m_block.m_projectionMatrix = projectionMatrix;
+		m_block.m_viewMatrix = viewMatrix;
+		m_block.m_projectionViewMatrix = projectionMatrix * viewMatrix;
+		m_changed = true;
+	}
+
+	void FrameConstants::setTime(float time)
+	{
+		if (m_block.m_time == time)
+			return;
+
+		m_block.m_time = time;
+		m_changed = true;
+	}
+
+	void FrameConstants::upload()
+	{
+		if (m_changed == false)
+			return;
+
+		uploadBlock(m_block);
+		m_changed = false;
+		++m_uploadCount;
+	}
+}
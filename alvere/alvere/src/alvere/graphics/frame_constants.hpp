@@ -0,0 +1,74 @@
+#pragma once
+
+#include "alvere/graphics/camera.hpp"
+#include "alvere/math/matrix/matrix_4.hpp"
+
+//The uniform block binding point every engine shader reads the frame constants from
+#define ALV_FRAME_CONSTANTS_BINDING 0
+#define ALV_FRAME_CONSTANTS_BLOCK_NAME "FrameConstants"
+
+namespace alvere
+{
+	//Values that are the same for every draw in a frame, kept in one uniform buffer that all shader programs share.
+	//Shaders read them by declaring the block below, which is bound to ALV_FRAME_CONSTANTS_BINDING when they're built:
+	//
+	//	layout(std140) uniform FrameConstants
+	//	{
+	//		mat4 u_projectionMatrix;
+	//		mat4 u_viewMatrix;
+	//		mat4 u_projectionViewMatrix;
+	//		float u_time;
+	//	};
+	//
+	//Setting values only marks the block as changed. It's uploaded by upload(), which Renderer::begin calls.
+	class FrameConstants
+	{
+	public:
+
+		//Laid out to match the block under std140
+		struct Block
+		{
+			Matrix4 m_projectionMatrix;
+			Matrix4 m_viewMatrix;
+			Matrix4 m_projectionViewMatrix;
+			float m_time;
+			float m_padding[3];
+		};
+
+		//The current graphics API's frame constants, made the first time they're needed
+		static FrameConstants & get();
+
+		FrameConstants(const FrameConstants & frameConstants) = delete;
+
+		virtual ~FrameConstants() = default;
+
+		void setCamera(const Camera & camera);
+
+		void setCamera(const Matrix4 & projectionMatrix, const Matrix4 & viewMatrix);
+
+		//Seconds since the application started
+		void setTime(float time);
+
+		//Uploads the block if anything has changed since it was last uploaded
+		void upload();
+
+		const Block & getBlock() const { return m_block; }
+
+		//Uploads made since the frame constants were created
+		unsigned int getUploadCount() const { return m_uploadCount; }
+
+	protected:
+
+		FrameConstants();
+
+		virtual void uploadBlock(const Block & block) = 0;
+
+	private:
+
+		Block m_block;
+
+		bool m_changed;
+
+		unsigned int m_uploadCount;
+	};
+}
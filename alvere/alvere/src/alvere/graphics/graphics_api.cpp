@@ -0,0 +1,167 @@
+#include "alvere/graphics/graphics_api.hpp"
+
+#include "alvere/graphics/buffers.hpp"
+#include "alvere/graphics/frame_buffer.hpp"
+#include "alvere/graphics/frame_constants.hpp"
+#include "alvere/graphics/renderer.hpp"
+#include "alvere/graphics/renderer_api.hpp"
+#include "alvere/graphics/shader.hpp"
+#include "alvere/graphics/shader_program.hpp"
+#include "alvere/graphics/sprite_batcher.hpp"
+#include "alvere/graphics/static_sprite_batch.hpp"
+#include "alvere/graphics/texture.hpp"
+#include "alvere/graphics/texture_loader.hpp"
+
+#ifdef ALV_GRAPHICS_API_OPENGL
+#include "graphics_api/opengl/opengl_buffers.hpp"
+#include "graphics_api/opengl/opengl_frame_buffer.hpp"
+#include "graphics_api/opengl/opengl_frame_constants.hpp"
+#include "graphics_api/opengl/opengl_renderer.hpp"
+#include "graphics_api/opengl/opengl_renderer_api.hpp"
+#include "graphics_api/opengl/opengl_shader.hpp"
+#include "graphics_api/opengl/opengl_shader_program.hpp"
+#include "graphics_api/opengl/opengl_sprite_batcher.hpp"
+#include "graphics_api/opengl/opengl_static_sprite_batch.hpp"
+#include "graphics_api/opengl/opengl_texture.hpp"
+#endif
+
+#include "graphics_api/null/null_buffers.hpp"
+#include "graphics_api/null/null_frame_buffer.hpp"
+#include "graphics_api/null/null_frame_constants.hpp"
+#include "graphics_api/null/null_renderer.hpp"
+#include "graphics_api/null/null_renderer_api.hpp"
+#include "graphics_api/null/null_shader.hpp"
+#include "graphics_api/null/null_shader_program.hpp"
+#include "graphics_api/null/null_sprite_batcher.hpp"
+#include "graphics_api/null/null_static_sprite_batch.hpp"
+#include "graphics_api/null/null_texture.hpp"
+
+//Makes the current backend's version of a graphics object. Without a real backend compiled in, everything is null.
+#ifdef ALV_GRAPHICS_API_OPENGL
+#define ALV_NEW_GRAPHICS_OBJECT(Type, ...) (::alvere::getGraphicsAPI() == ::alvere::GraphicsAPI::OpenGL \
+	? (::alvere::Type *)new ::alvere::graphics_api::opengl::Type(__VA_ARGS__) \
+	: (::alvere::Type *)new ::alvere::graphics_api::null::Type(__VA_ARGS__))
+#else
+#define ALV_NEW_GRAPHICS_OBJECT(Type, ...) ((::alvere::Type *)new ::alvere::graphics_api::null::Type(__VA_ARGS__))
+#endif
+
+namespace alvere
+{
+#ifdef ALV_GRAPHICS_API_OPENGL
+	static GraphicsAPI s_graphicsAPI = GraphicsAPI::OpenGL;
+#else
+	static GraphicsAPI s_graphicsAPI = GraphicsAPI::Null;
+#endif
+
+	//Made on first use rather than here, since a real backend's needs a context
+	static std::unique_ptr<FrameConstants> s_frameConstants;
+
+	GraphicsAPI getGraphicsAPI()
+	{
+		return s_graphicsAPI;
+	}
+
+	void setGraphicsAPI(GraphicsAPI graphicsAPI)
+	{
+		s_graphicsAPI = graphicsAPI;
+
+		s_frameConstants.reset();
+
+		switch (graphicsAPI)
+		{
+#ifdef ALV_GRAPHICS_API_OPENGL
+		case GraphicsAPI::OpenGL: RendererAPI::s_Instance = std::make_unique<graphics_api::opengl::RendererAPI>(); break;
+#endif
+		default: RendererAPI::s_Instance = std::make_unique<graphics_api::null::RendererAPI>(); break;
+		}
+	}
+}
+
+alvere::VertexBuffer * alvere::VertexBuffer::New()
+{
+	return ALV_NEW_GRAPHICS_OBJECT(VertexBuffer);
+}
+
+alvere::VertexBuffer * alvere::VertexBuffer::New(const float * vertexData, unsigned int size)
+{
+	return ALV_NEW_GRAPHICS_OBJECT(VertexBuffer, vertexData, size);
+}
+
+alvere::IndexBuffer * alvere::IndexBuffer::New(const unsigned int * indices, unsigned int size)
+{
+	return ALV_NEW_GRAPHICS_OBJECT(IndexBuffer, indices, size);
+}
+
+alvere::IndexBuffer * alvere::IndexBuffer::New(const unsigned short * indices, unsigned int size)
+{
+	return ALV_NEW_GRAPHICS_OBJECT(IndexBuffer, indices, size);
+}
+
+std::unique_ptr<alvere::FrameBuffer> alvere::FrameBuffer::create(unsigned int width, unsigned int height)
+{
+	return std::unique_ptr<FrameBuffer>(ALV_NEW_GRAPHICS_OBJECT(FrameBuffer, width, height));
+}
+
+alvere::FrameConstants & alvere::FrameConstants::get()
+{
+	if (s_frameConstants == nullptr)
+	{
+		s_frameConstants.reset(ALV_NEW_GRAPHICS_OBJECT(FrameConstants));
+	}
+	return *s_frameConstants;
+}
+
+alvere::Renderer* alvere::Renderer::New()
+{
+	return ALV_NEW_GRAPHICS_OBJECT(Renderer);
+}
+
+std::unique_ptr<alvere::Shader> alvere::Shader::New(Shader::Type type, const std::string& source)
+{
+	return std::unique_ptr<Shader>(ALV_NEW_GRAPHICS_OBJECT(Shader, type, source));
+}
+
+std::unique_ptr<alvere::ShaderProgram> alvere::ShaderProgram::New()
+{
+	return std::unique_ptr<ShaderProgram>(ALV_NEW_GRAPHICS_OBJECT(ShaderProgram));
+}
+
+std::unique_ptr<alvere::SpriteBatcher> alvere::SpriteBatcher::New(unsigned int capacity, VertexFormat vertexFormat)
+{
+	return std::unique_ptr<SpriteBatcher>(ALV_NEW_GRAPHICS_OBJECT(SpriteBatcher, capacity, vertexFormat));
+}
+
+std::unique_ptr<alvere::StaticSpriteBatch> alvere::StaticSpriteBatch::New()
+{
+	return std::unique_ptr<StaticSpriteBatch>(ALV_NEW_GRAPHICS_OBJECT(StaticSpriteBatch));
+}
+
+std::unique_ptr<alvere::Texture> alvere::Texture::New(const char * filename, Channels channels, bool keepPixelData)
+{
+	return std::unique_ptr<Texture>(ALV_NEW_GRAPHICS_OBJECT(Texture, filename, channels, keepPixelData));
+}
+
+std::unique_ptr<alvere::Texture> alvere::Texture::New(const unsigned char * data, int width, int height, Channels channels)
+{
+	return std::unique_ptr<Texture>(ALV_NEW_GRAPHICS_OBJECT(Texture, data, width, height, channels));
+}
+
+std::unique_ptr<alvere::Texture> alvere::Texture::New(int width, int height, Channels channels)
+{
+	return std::unique_ptr<Texture>(ALV_NEW_GRAPHICS_OBJECT(Texture, width, height, channels));
+}
+
+alvere::Texture * alvere::Texture::loadFromFile(const std::string & filepath)
+{
+	return TextureLoader::get().load(filepath);
+}
+
+std::unique_ptr<alvere::Texture> alvere::Texture::New(const alvere::Texture & sourceTexture, alvere::RectI sourceRect)
+{
+	return std::unique_ptr<Texture>(ALV_NEW_GRAPHICS_OBJECT(Texture, sourceTexture, sourceRect));
+}
+
+std::unique_ptr<alvere::Texture> alvere::Texture::New(Placeholder placeholder, int width, int height, Channels channels, bool keepPixelData)
+{
+	return std::unique_ptr<Texture>(ALV_NEW_GRAPHICS_OBJECT(Texture, placeholder, width, height, channels, keepPixelData));
+}
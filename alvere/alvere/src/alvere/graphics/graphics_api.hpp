@@ -0,0 +1,19 @@
+#pragma once
+
+namespace alvere
+{
+	//The backends the graphics factories can create objects for
+	enum class GraphicsAPI
+	{
+		OpenGL,
+		//Does no GPU work and needs no context. Everything it is asked to do is counted, and optionally recorded,
+		//in graphics_api::null::CommandLog, which makes it useful for measuring the render path headlessly.
+		Null
+	};
+
+	GraphicsAPI getGraphicsAPI();
+
+	//Only objects created afterwards use the new backend, and objects from different backends can't be mixed.
+	//Also replaces RendererAPI::s_Instance.
+	void setGraphicsAPI(GraphicsAPI graphicsAPI);
+}
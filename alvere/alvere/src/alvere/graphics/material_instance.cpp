@@ -1,61 +1,81 @@
 #include <glad/glad.h>
 
 #include "alvere/graphics/material_instance.hpp"
+#include "alvere/graphics/graphics_api.hpp"
+
+#ifdef ALV_GRAPHICS_API_OPENGL
+#include "graphics_api/opengl/opengl_state_cache.hpp"
+#endif
 
 namespace alvere
 {
 	void MaterialPropertyData<Shader::DataType::Float>::sendToShaderProgram(const ShaderProgram * shaderProgram) const
 	{
-		shaderProgram->sendUniformFloat1(m_propertyInfo->m_id, m_value);
+		shaderProgram->sendUniform(m_uniform, m_value);
 	}
 
 	void MaterialPropertyData<Shader::DataType::Float2>::sendToShaderProgram(const ShaderProgram * shaderProgram) const
 	{
-		shaderProgram->sendUniformFloat2(m_propertyInfo->m_id, m_value.x, m_value.y);
+		shaderProgram->sendUniform(m_uniform, m_value.x, m_value.y);
 	}
 
 	void MaterialPropertyData<Shader::DataType::Float3>::sendToShaderProgram(const ShaderProgram * shaderProgram) const
 	{
-		shaderProgram->sendUniformFloat3(m_propertyInfo->m_id, m_value.x, m_value.y, m_value.z);
+		shaderProgram->sendUniform(m_uniform, m_value.x, m_value.y, m_value.z);
 	}
 
 	void MaterialPropertyData<Shader::DataType::Float4>::sendToShaderProgram(const ShaderProgram * shaderProgram) const
 	{
-		shaderProgram->sendUniformFloat4(m_propertyInfo->m_id, m_value.x, m_value.y, m_value.z, m_value.w);
+		shaderProgram->sendUniform(m_uniform, m_value.x, m_value.y, m_value.z, m_value.w);
 	}
 
 	void MaterialPropertyData<Shader::DataType::Int>::sendToShaderProgram(const ShaderProgram * shaderProgram) const
 	{
-		shaderProgram->sendUniformInt1(m_propertyInfo->m_id, m_value);
+		shaderProgram->sendUniform(m_uniform, m_value);
 	}
 
 	void MaterialPropertyData<Shader::DataType::Int2>::sendToShaderProgram(const ShaderProgram * shaderProgram) const
 	{
-		shaderProgram->sendUniformInt2(m_propertyInfo->m_id, m_value[0], m_value[1]);
+		shaderProgram->sendUniform(m_uniform, m_value[0], m_value[1]);
 	}
 
 	void MaterialPropertyData<Shader::DataType::Int3>::sendToShaderProgram(const ShaderProgram * shaderProgram) const
 	{
-		shaderProgram->sendUniformInt3(m_propertyInfo->m_id, m_value[0], m_value[1], m_value[2]);
+		shaderProgram->sendUniform(m_uniform, m_value[0], m_value[1], m_value[2]);
 	}
 
 	void MaterialPropertyData<Shader::DataType::Int4>::sendToShaderProgram(const ShaderProgram * shaderProgram) const
 	{
-		shaderProgram->sendUniformInt4(m_propertyInfo->m_id, m_value[0], m_value[1], m_value[2], m_value[3]);
+		shaderProgram->sendUniform(m_uniform, m_value[0], m_value[1], m_value[2], m_value[3]);
 	}
 
 	void MaterialPropertyData<Shader::DataType::Mat4x4>::sendToShaderProgram(const ShaderProgram * shaderProgram) const
 	{
-		shaderProgram->sendUniformMat4x4(m_propertyInfo->m_id, m_value);
+		shaderProgram->sendUniform(m_uniform, m_value);
 	}
 
 	void MaterialPropertyData<Shader::DataType::Sampler2D>::sendToShaderProgram(const ShaderProgram * shaderProgram) const
 	{
-		shaderProgram->sendUniformInt1(m_propertyInfo->m_id, m_openGLTextureUnitIndex);
-		glActiveTexture(GL_TEXTURE0 + m_openGLTextureUnitIndex);
+		shaderProgram->sendUniform(m_uniform, m_openGLTextureUnitIndex);
+#ifdef ALV_GRAPHICS_API_OPENGL
+		if (getGraphicsAPI() == GraphicsAPI::OpenGL)
+			graphics_api::opengl::StateCache::get().activeTexture(m_openGLTextureUnitIndex);
+#endif
 		if (m_value) m_value->bind();
 	}
 
+	template <Shader::DataType ShaderDataType>
+	MaterialPropertyData<ShaderDataType> * MaterialInstance::newPropertyDataOf(const MaterialPropertyInfo & propertyInfo) const
+	{
+		MaterialPropertyData<ShaderDataType> * propertyData = new MaterialPropertyData<ShaderDataType>;
+		propertyData->m_propertyInfo = &propertyInfo;
+
+		//The program has been built by the time a material is made from it, so its uniforms are known
+		propertyData->m_uniform = m_baseMaterial->getShaderProgram()->getUniform<ShaderDataType>(propertyInfo.m_id);
+
+		return propertyData;
+	}
+
 	MaterialInstance::MaterialInstance(const Material * baseMaterial)
 		: m_baseMaterial(baseMaterial)
 	{
@@ -69,23 +89,24 @@ namespace alvere
 
 			switch (propertyInfo.m_shaderDataType)
 			{
-				default: newPropertyData = new MaterialPropertyData<Shader::DataType::Float>; break;
-				case Shader::DataType::Float2: newPropertyData = new MaterialPropertyData<Shader::DataType::Float2>; break;
-				case Shader::DataType::Float3: newPropertyData = new MaterialPropertyData<Shader::DataType::Float3>; break;
-				case Shader::DataType::Float4: newPropertyData = new MaterialPropertyData<Shader::DataType::Float4>; break;
-				case Shader::DataType::Int: newPropertyData = new MaterialPropertyData<Shader::DataType::Int>; break;
-				case Shader::DataType::Int2: newPropertyData = new MaterialPropertyData<Shader::DataType::Int2>; break;
-				case Shader::DataType::Int3: newPropertyData = new MaterialPropertyData<Shader::DataType::Int3>; break;
-				case Shader::DataType::Int4: newPropertyData = new MaterialPropertyData<Shader::DataType::Int4>; break;
-				case Shader::DataType::Mat4x4: newPropertyData = new MaterialPropertyData<Shader::DataType::Mat4x4>; break;
+				default: newPropertyData = newPropertyDataOf<Shader::DataType::Float>(propertyInfo); break;
+				case Shader::DataType::Float2: newPropertyData = newPropertyDataOf<Shader::DataType::Float2>(propertyInfo); break;
+				case Shader::DataType::Float3: newPropertyData = newPropertyDataOf<Shader::DataType::Float3>(propertyInfo); break;
+				case Shader::DataType::Float4: newPropertyData = newPropertyDataOf<Shader::DataType::Float4>(propertyInfo); break;
+				case Shader::DataType::Int: newPropertyData = newPropertyDataOf<Shader::DataType::Int>(propertyInfo); break;
+				case Shader::DataType::Int2: newPropertyData = newPropertyDataOf<Shader::DataType::Int2>(propertyInfo); break;
+				case Shader::DataType::Int3: newPropertyData = newPropertyDataOf<Shader::DataType::Int3>(propertyInfo); break;
+				case Shader::DataType::Int4: newPropertyData = newPropertyDataOf<Shader::DataType::Int4>(propertyInfo); break;
+				case Shader::DataType::Mat4x4: newPropertyData = newPropertyDataOf<Shader::DataType::Mat4x4>(propertyInfo); break;
 				case Shader::DataType::Sampler2D:
-					newPropertyData = new MaterialPropertyData<Shader::DataType::Sampler2D>;
-					((MaterialPropertyData<Shader::DataType::Sampler2D> *)newPropertyData)->m_openGLTextureUnitIndex = openGLTextureUnitIndex++;
+				{
+					MaterialPropertyData<Shader::DataType::Sampler2D> * samplerData = newPropertyDataOf<Shader::DataType::Sampler2D>(propertyInfo);
+					samplerData->m_openGLTextureUnitIndex = openGLTextureUnitIndex++;
+					newPropertyData = samplerData;
 					break;
+				}
 			}
 
-			newPropertyData->m_propertyInfo = &propertyInfo;
-
 			m_propertiesData.push_back(newPropertyData);
 		}
 	}
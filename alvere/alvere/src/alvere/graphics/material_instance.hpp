@@ -20,11 +20,22 @@ namespace alvere
 		virtual void sendToShaderProgram(const ShaderProgram * shaderProgram) const = 0;
 	};
 
+	//Holds the uniform the property is sent to, found once when the material instance is made
 	template <Shader::DataType ShaderDataType>
-	struct MaterialPropertyData : IMaterialPropertyData { };
+	struct TypedMaterialPropertyData : IMaterialPropertyData
+	{
+	protected:
+
+		friend alvere::MaterialInstance;
+
+		UniformHandle<ShaderDataType> m_uniform;
+	};
+
+	template <Shader::DataType ShaderDataType>
+	struct MaterialPropertyData : TypedMaterialPropertyData<ShaderDataType> { };
 
 	template<>
-	struct MaterialPropertyData<Shader::DataType::Float> : IMaterialPropertyData
+	struct MaterialPropertyData<Shader::DataType::Float> : TypedMaterialPropertyData<Shader::DataType::Float>
 	{
 		float m_value = 0.0f;
 
@@ -34,7 +45,7 @@ namespace alvere
 	};
 
 	template<>
-	struct MaterialPropertyData<Shader::DataType::Float2> : IMaterialPropertyData
+	struct MaterialPropertyData<Shader::DataType::Float2> : TypedMaterialPropertyData<Shader::DataType::Float2>
 	{
 		Vector2 m_value;
 
@@ -44,7 +55,7 @@ namespace alvere
 	};
 
 	template<>
-	struct MaterialPropertyData<Shader::DataType::Float3> : IMaterialPropertyData
+	struct MaterialPropertyData<Shader::DataType::Float3> : TypedMaterialPropertyData<Shader::DataType::Float3>
 	{
 		Vector3 m_value;
 
@@ -54,7 +65,7 @@ namespace alvere
 	};
 
 	template<>
-	struct MaterialPropertyData<Shader::DataType::Float4> : IMaterialPropertyData
+	struct MaterialPropertyData<Shader::DataType::Float4> : TypedMaterialPropertyData<Shader::DataType::Float4>
 	{
 		Vector4 m_value;
 
@@ -64,7 +75,7 @@ namespace alvere
 	};
 
 	template<>
-	struct MaterialPropertyData<Shader::DataType::Int> : IMaterialPropertyData
+	struct MaterialPropertyData<Shader::DataType::Int> : TypedMaterialPropertyData<Shader::DataType::Int>
 	{
 		int m_value = 0;
 
@@ -74,7 +85,7 @@ namespace alvere
 	};
 
 	template<>
-	struct MaterialPropertyData<Shader::DataType::Int2> : IMaterialPropertyData
+	struct MaterialPropertyData<Shader::DataType::Int2> : TypedMaterialPropertyData<Shader::DataType::Int2>
 	{
 		Vector<int, 2> m_value;
 
@@ -84,7 +95,7 @@ namespace alvere
 	};
 
 	template<>
-	struct MaterialPropertyData<Shader::DataType::Int3> : IMaterialPropertyData
+	struct MaterialPropertyData<Shader::DataType::Int3> : TypedMaterialPropertyData<Shader::DataType::Int3>
 	{
 		Vector<int, 3> m_value;
 
@@ -94,7 +105,7 @@ namespace alvere
 	};
 
 	template<>
-	struct MaterialPropertyData<Shader::DataType::Int4> : IMaterialPropertyData
+	struct MaterialPropertyData<Shader::DataType::Int4> : TypedMaterialPropertyData<Shader::DataType::Int4>
 	{
 		Vector<int, 4> m_value;
 
@@ -104,7 +115,7 @@ namespace alvere
 	};
 
 	template<>
-	struct MaterialPropertyData<Shader::DataType::Mat4x4> : IMaterialPropertyData
+	struct MaterialPropertyData<Shader::DataType::Mat4x4> : TypedMaterialPropertyData<Shader::DataType::Mat4x4>
 	{
 		Matrix4 m_value;
 
@@ -114,7 +125,7 @@ namespace alvere
 	};
 
 	template<>
-	struct MaterialPropertyData<Shader::DataType::Sampler2D> : IMaterialPropertyData
+	struct MaterialPropertyData<Shader::DataType::Sampler2D> : TypedMaterialPropertyData<Shader::DataType::Sampler2D>
 	{
 		friend class MaterialInstance;
 
@@ -165,5 +176,8 @@ namespace alvere
 		const Material * m_baseMaterial;
 
 		std::vector<IMaterialPropertyData *> m_propertiesData;
+
+		template<Shader::DataType ShaderDataType>
+		MaterialPropertyData<ShaderDataType> * newPropertyDataOf(const MaterialPropertyInfo & propertyInfo) const;
 	};
 }
\ No newline at end of file
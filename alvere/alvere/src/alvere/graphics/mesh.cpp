@@ -8,6 +8,8 @@
 
 #include "alvere/debug/logging.hpp"
 #include "alvere/graphics/buffers.hpp"
+#include "alvere/graphics/mesh_cache.hpp"
+#include "alvere/graphics/mesh_optimiser.hpp"
 #include "alvere/math/vector/vector_3.hpp"
 #include "alvere/math/vector/vector_4.hpp"
 
@@ -105,7 +107,8 @@ namespace alvere
 	}
 
 	Mesh::Mesh(const Vector3 * positions, const Vector3 * normals, const Vector3 * tangents, const Vector3 * bitangents, const TextureCoordinateData * texCoords, const ColourData * colours, unsigned int vertexCount, const unsigned int * indices, unsigned int indexCount)
-		: m_VertexCount(vertexCount)
+		: m_Positions(nullptr), m_Normals(nullptr), m_Tangents(nullptr), m_Bitangents(nullptr), m_TextureCoordinates(nullptr), m_Colours(nullptr)
+		, m_VertexCount(vertexCount), m_VertexBuffer(nullptr), m_ElementBuffer(nullptr)
 	{
 		if (positions) { m_Positions = new Vector3[vertexCount]; std::memmove(m_Positions, positions, sizeof(Vector3) * vertexCount); }
 		if (normals) std::memmove(m_Normals, normals, sizeof(Vector3) * vertexCount);
@@ -121,7 +124,7 @@ namespace alvere
 			});
 	}
 
-	Mesh::Mesh(const char * filepath)
+	static bool ImportMesh(const char * filepath, mesh_cache::MeshData & meshData)
 	{
 		Assimp::Importer importer;
 
@@ -143,90 +146,96 @@ namespace alvere
 		if (!scene)
 		{
 			LogError("Failed to read mesh file \"%s\". More info: %s\n", filepath, importer.GetErrorString());
-			return;
+			return false;
 		}
 
-		for (int idx = 0; idx < scene->mNumMeshes; idx++)
+		//Interleaved straight out of the scene, so nothing is copied on the way to the upload
+		for (unsigned int meshIdx = 0; meshIdx < scene->mNumMeshes; meshIdx++)
 		{
-			const aiMesh * mesh = scene->mMeshes[idx];
+			const aiMesh * mesh = scene->mMeshes[meshIdx];
 
-			m_VertexCount = mesh->mNumVertices;
+			uint32_t firstVertex = (uint32_t)(meshData.m_vertices.size() / 6);
+			const aiVector3D * texCoords = mesh->HasTextureCoords(0) ? mesh->mTextureCoords[0] : nullptr;
 
-			if (mesh->HasPositions())
-			{
-				m_Positions = new Vector3[mesh->mNumVertices];
-				std::memmove(m_Positions, mesh->mVertices, mesh->mNumVertices * (sizeof(float) * 3));
-			}
-			if (mesh->HasNormals())
-			{
-				m_Normals = new Vector3[mesh->mNumVertices];
-				std::memmove(m_Normals, mesh->mNormals, mesh->mNumVertices * (sizeof(float) * 3));
-			}
-			if (mesh->HasTangentsAndBitangents())
-			{
-				m_Tangents = new Vector3[mesh->mNumVertices];
-				m_Bitangents = new Vector3[mesh->mNumVertices];
-				std::memmove(m_Tangents, mesh->mTangents, mesh->mNumVertices * (sizeof(float) * 3));
-				std::memmove(m_Bitangents, mesh->mBitangents, mesh->mNumVertices * (sizeof(float) * 3));
-			}
-			if (mesh->HasTextureCoords(0))
+			for (unsigned int idx = 0; idx < mesh->mNumVertices; idx++)
 			{
-				m_TextureCoordinates = new TextureCoordinateData;
-				m_TextureCoordinates->count = mesh->GetNumUVChannels();
-				m_TextureCoordinates->data = new Vector3*[m_TextureCoordinates->count];
-				m_TextureCoordinates->componentCount = new unsigned int[m_TextureCoordinates->count];
-
-				for (int idxx = 0; idxx < m_TextureCoordinates->count; idxx++)
-				{
-					m_TextureCoordinates->componentCount[idxx] = mesh->mNumUVComponents[idxx];
-					m_TextureCoordinates->data[idxx] = new Vector3[mesh->mNumVertices];
-					std::memmove(m_TextureCoordinates->data[idxx], mesh->mTextureCoords[idxx], mesh->mNumVertices * (sizeof(float) * 3));
-				}
+				const aiVector3D & position = mesh->mVertices[idx];
+				aiVector3D texCoord = texCoords != nullptr ? texCoords[idx] : aiVector3D();
+
+				meshData.m_vertices.insert(meshData.m_vertices.end(), { position.x, position.y, position.z, texCoord.x, texCoord.y, texCoord.z });
 			}
-			if (mesh->HasVertexColors(0))
+
+			for (unsigned int faceIdx = 0; faceIdx < mesh->mNumFaces; faceIdx++)
 			{
-				m_Colours = new ColourData;
-				m_Colours->count = mesh->GetNumColorChannels();
-				m_Colours->data = new Vector4*[m_Colours->count];
-
-				for (int idxx = 0; idxx < m_Colours->count; idxx++)
-				{
-					m_Colours->data[idxx] = new Vector4[mesh->mNumVertices];
-					std::memmove(m_Colours->data[idxx], mesh->mColors[idxx], mesh->mNumVertices * (sizeof(float) * 4));
-				}
+				const aiFace & face = mesh->mFaces[faceIdx];
+
+				//Points and lines are left over after triangulating, and can't be drawn as triangles
+				if (face.mNumIndices != 3)
+					continue;
+
+				for (unsigned int idx = 0; idx < 3; idx++)
+					meshData.m_indices.push_back(firstVertex + face.mIndices[idx]);
 			}
-			if (mesh->HasFaces())
-			{
-				unsigned int * indices = new unsigned int[3 * mesh->mNumFaces];
+		}
 
-				for (int idxx = 0, indicesIdx = 0; idxx < mesh->mNumFaces; idxx++)
-				{
+		return true;
+	}
 
-					for (int idxxx = 0; idxxx < mesh->mFaces[idxx].mNumIndices; idxxx++, indicesIdx++) indices[indicesIdx] = mesh->mFaces[idxx].mIndices[idxxx];
-				}
+	Mesh::Mesh(const char * filepath, bool useCache)
+		: m_Positions(nullptr), m_Normals(nullptr), m_Tangents(nullptr), m_Bitangents(nullptr), m_TextureCoordinates(nullptr), m_Colours(nullptr)
+		, m_VertexCount(0), m_VertexBuffer(nullptr), m_ElementBuffer(nullptr)
+	{
+		std::string cachePath = mesh_cache::getCachePath(filepath);
 
-				m_ElementBuffer = IndexBuffer::New(indices, mesh->mNumFaces * 3);
+		if (useCache && mesh_cache::isUpToDate(filepath, cachePath))
+		{
+			//Unmapped again once uploaded, the buffers have their own copies
+			MappedFile file(cachePath);
+			mesh_cache::MappedMesh mappedMesh;
 
-				delete[] indices;
+			if (mesh_cache::read(file, mappedMesh))
+			{
+				SetBuffers(mappedMesh.m_vertices, mappedMesh.m_vertexCount, mappedMesh.m_indices, mappedMesh.m_indexCount, mappedMesh.m_indexSize);
+				return;
 			}
+
+			LogWarning("Mesh cache \"%s\" can't be read, importing \"%s\" again.\n", cachePath.c_str(), filepath);
 		}
 
-		importer.FreeScene();
+		mesh_cache::MeshData meshData;
+		if (ImportMesh(filepath, meshData) == false)
+			return;
 
-		float * data = new float[m_VertexCount * sizeof(float) * 6];
+		mesh_optimiser::Report report = mesh_optimiser::optimise(meshData.m_vertices, meshData.m_indices, 6);
+		LogInfo("Optimised mesh \"%s\": %u -> %u vertices, ACMR %.3f -> %.3f.\n", filepath,
+			report.m_verticesBefore, report.m_verticesAfter, report.m_acmrBefore, report.m_acmrAfter);
 
-		for (int idx = 0; idx < m_VertexCount; idx++)
-		{
-			data[idx * 6 + 0] = m_Positions[idx].x;
-			data[idx * 6 + 1] = m_Positions[idx].y;
-			data[idx * 6 + 2] = m_Positions[idx].z;
+		if (useCache && mesh_cache::write(cachePath, meshData) == false)
+			LogWarning("Failed to write mesh cache \"%s\".\n", cachePath.c_str());
+
+		unsigned int vertexCount = (unsigned int)(meshData.m_vertices.size() / 6);
 
-			data[idx * 6 + 3] = m_TextureCoordinates->data[0][idx].x;
-			data[idx * 6 + 4] = m_TextureCoordinates->data[0][idx].y;
-			data[idx * 6 + 5] = m_TextureCoordinates->data[0][idx].z;
+		if (mesh_cache::getIndexSize(vertexCount) == sizeof(unsigned short))
+		{
+			std::vector<unsigned short> shortIndices(meshData.m_indices.begin(), meshData.m_indices.end());
+			SetBuffers(meshData.m_vertices.data(), vertexCount, shortIndices.data(), (unsigned int)shortIndices.size(), sizeof(unsigned short));
+		}
+		else
+		{
+			SetBuffers(meshData.m_vertices.data(), vertexCount, meshData.m_indices.data(), (unsigned int)meshData.m_indices.size(), sizeof(unsigned int));
 		}
+	}
+
+	void Mesh::SetBuffers(const float * vertices, unsigned int vertexCount, const void * indices, unsigned int indexCount, unsigned int indexSize)
+	{
+		m_VertexCount = vertexCount;
+
+		if (indexSize == sizeof(unsigned short))
+			m_ElementBuffer = IndexBuffer::New((const unsigned short *)indices, indexCount);
+		else
+			m_ElementBuffer = IndexBuffer::New((const unsigned int *)indices, indexCount);
 
-		m_VertexBuffer = VertexBuffer::New(data, m_VertexCount * sizeof(float) * 6);
+		m_VertexBuffer = VertexBuffer::New(vertices, m_VertexCount * sizeof(float) * 6);
 
 		m_VertexBuffer->SetLayout({
 			BufferElementProperties{Shader::DataType::Float3, "a_position" },
@@ -242,6 +251,8 @@ namespace alvere
 		delete[] m_Bitangents;
 		delete m_TextureCoordinates;
 		delete m_Colours;
+		delete m_VertexBuffer;
+		delete m_ElementBuffer;
 	}
 
 	VertexBuffer * Mesh::GetVertexBuffer() const
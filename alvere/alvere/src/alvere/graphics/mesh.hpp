@@ -43,7 +43,10 @@ namespace alvere
 
 		Mesh(const Vector3 * positions, const Vector3 * normals, const Vector3 * tangents, const Vector3 * bitangents, const TextureCoordinateData * texCoords, const ColourData * colours, unsigned int vertexCount, const unsigned int * indices, unsigned int indexCount);
 
-        Mesh(const char * filepath);
+        //Imports the file with Assimp, unless its mesh cache is up to date, in which case that is mapped and
+        //uploaded from directly. Importing welds and reorders the vertices and triangles for the vertex caches, then
+        //writes the cache for next time. Every sub mesh is merged into one.
+        Mesh(const char * filepath, bool useCache = true);
 
         ~Mesh();
 
@@ -69,5 +72,9 @@ namespace alvere
 		VertexBuffer * m_VertexBuffer;
 
 		IndexBuffer * m_ElementBuffer;
+
+		//Vertices are interleaved positions and texture coordinates, as the mesh cache stores them.
+		//Indices are indexSize bytes each, either unsigned shorts or unsigned ints.
+		void SetBuffers(const float * vertices, unsigned int vertexCount, const void * indices, unsigned int indexCount, unsigned int indexSize);
 	};
 }
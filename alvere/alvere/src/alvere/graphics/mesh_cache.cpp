@@ -0,0 +1,132 @@
+#include "alvere/graphics/mesh_cache.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#define ALV_MESH_CACHE_VERTEX_STRIDE (sizeof(float) * 6)
+
+namespace alvere::mesh_cache
+{
+	static const char s_magic[4] = { 'A', 'M', 'S', 'H' };
+
+	//Different threads can cook the same source at once, so each write gets its own temporary file to rename from
+	static std::string getTemporaryPath(const std::string & cachePath)
+	{
+		static std::atomic<uint32_t> s_writeCount = 0;
+
+		std::size_t threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+		return cachePath + "." + std::to_string(threadId) + "." + std::to_string(s_writeCount++) + ".tmp";
+	}
+
+	static uint64_t alignOffset(uint64_t offset)
+	{
+		return (offset + ALV_MESH_CACHE_ALIGNMENT - 1) & ~(uint64_t)(ALV_MESH_CACHE_ALIGNMENT - 1);
+	}
+
+	uint32_t getIndexSize(uint32_t vertexCount)
+	{
+		return vertexCount <= 0x10000 ? sizeof(uint16_t) : sizeof(uint32_t);
+	}
+
+	std::string getCachePath(const std::string & sourcePath)
+	{
+		return sourcePath + ALV_MESH_CACHE_EXTENSION;
+	}
+
+	bool isUpToDate(const std::string & sourcePath, const std::string & cachePath)
+	{
+		std::error_code error;
+
+		std::filesystem::file_time_type cacheTime = std::filesystem::last_write_time(cachePath, error);
+		if (error)
+			return false;
+
+		//A cache with no source left to make it from is still the best there is
+		std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(sourcePath, error);
+		return error || cacheTime >= sourceTime;
+	}
+
+	bool write(const std::string & cachePath, const MeshData & mesh)
+	{
+		Header header = {};
+		std::memcpy(header.m_magic, s_magic, sizeof(s_magic));
+		header.m_version = ALV_MESH_CACHE_VERSION;
+		header.m_vertexCount = (uint32_t)(mesh.m_vertices.size() * sizeof(float) / ALV_MESH_CACHE_VERTEX_STRIDE);
+		header.m_vertexStride = ALV_MESH_CACHE_VERTEX_STRIDE;
+		header.m_indexCount = (uint32_t)mesh.m_indices.size();
+		header.m_indexSize = getIndexSize(header.m_vertexCount);
+		header.m_vertexOffset = alignOffset(sizeof(Header));
+		header.m_indexOffset = alignOffset(header.m_vertexOffset + (uint64_t)header.m_vertexCount * header.m_vertexStride);
+
+		const void * indices = mesh.m_indices.data();
+		std::vector<uint16_t> shortIndices;
+		if (header.m_indexSize == sizeof(uint16_t))
+		{
+			shortIndices.assign(mesh.m_indices.begin(), mesh.m_indices.end());
+			indices = shortIndices.data();
+		}
+
+		//Written to a temporary file first, so a half written cache is never mistaken for a whole one
+		std::string temporaryPath = getTemporaryPath(cachePath);
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			if (file.fail())
+				return false;
+
+			const char padding[ALV_MESH_CACHE_ALIGNMENT] = {};
+
+			file.write((const char *)&header, sizeof(Header));
+			file.write(padding, header.m_vertexOffset - sizeof(Header));
+			file.write((const char *)mesh.m_vertices.data(), (std::streamsize)header.m_vertexCount * header.m_vertexStride);
+			file.write(padding, header.m_indexOffset - (header.m_vertexOffset + (uint64_t)header.m_vertexCount * header.m_vertexStride));
+			file.write((const char *)indices, (std::streamsize)header.m_indexCount * header.m_indexSize);
+
+			if (file.fail())
+				return false;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporaryPath, cachePath, error);
+		if (error)
+		{
+			std::error_code removeError;
+			std::filesystem::remove(temporaryPath, removeError);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool read(const MappedFile & file, MappedMesh & mesh)
+	{
+		if (file.isOpen() == false || file.getSize() < sizeof(Header))
+			return false;
+
+		Header header;
+		std::memcpy(&header, file.getData(), sizeof(Header));
+
+		if (std::memcmp(header.m_magic, s_magic, sizeof(s_magic)) != 0
+			|| header.m_version != ALV_MESH_CACHE_VERSION
+			|| header.m_vertexStride != ALV_MESH_CACHE_VERTEX_STRIDE
+			|| (header.m_indexSize != sizeof(uint16_t) && header.m_indexSize != sizeof(uint32_t))
+			|| header.m_vertexOffset % ALV_MESH_CACHE_ALIGNMENT != 0
+			|| header.m_indexOffset % ALV_MESH_CACHE_ALIGNMENT != 0)
+			return false;
+
+		uint64_t vertexEnd = header.m_vertexOffset + (uint64_t)header.m_vertexCount * header.m_vertexStride;
+		uint64_t indexEnd = header.m_indexOffset + (uint64_t)header.m_indexCount * header.m_indexSize;
+		if (vertexEnd > file.getSize() || indexEnd > file.getSize())
+			return false;
+
+		mesh.m_vertices = (const float *)(file.getData() + header.m_vertexOffset);
+		mesh.m_vertexCount = header.m_vertexCount;
+		mesh.m_indices = file.getData() + header.m_indexOffset;
+		mesh.m_indexCount = header.m_indexCount;
+		mesh.m_indexSize = header.m_indexSize;
+		return true;
+	}
+}
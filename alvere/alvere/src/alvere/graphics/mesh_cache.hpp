@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "alvere/utils/mapped_file.hpp"
+
+#define ALV_MESH_CACHE_EXTENSION ".amesh"
+#define ALV_MESH_CACHE_VERSION 2
+//Each stream starts on this boundary from the start of the file, and so of the mapping
+#define ALV_MESH_CACHE_ALIGNMENT 64
+
+namespace alvere::mesh_cache
+{
+	//Cooked meshes are stored next to their source as header, vertex stream and index stream, each laid out
+	//exactly as it's uploaded, so loading one is mapping the file and handing the streams to the buffers.
+	//Nothing is byte swapped, so a cache is only read on the kind of machine that wrote it.
+	struct Header
+	{
+		char m_magic[4];
+		uint32_t m_version;
+		uint32_t m_vertexCount;
+		//Bytes per vertex. Vertices are a position and texture coordinates, three floats each.
+		uint32_t m_vertexStride;
+		uint32_t m_indexCount;
+		//Bytes per index, 2 when every vertex can be indexed in 16 bits and 4 otherwise
+		uint32_t m_indexSize;
+		uint64_t m_vertexOffset;
+		uint64_t m_indexOffset;
+	};
+
+	//A mesh as it's uploaded, with every sub mesh of the source merged into one
+	struct MeshData
+	{
+		std::vector<float> m_vertices;
+		std::vector<uint32_t> m_indices;
+	};
+
+	//The streams of a mapped cache. They point into the mapping, so are only valid while it's open.
+	struct MappedMesh
+	{
+		const float * m_vertices;
+		uint32_t m_vertexCount;
+		//uint16_t or uint32_t, as m_indexSize says
+		const void * m_indices;
+		uint32_t m_indexCount;
+		uint32_t m_indexSize;
+	};
+
+	//The smallest index that can address every vertex
+	uint32_t getIndexSize(uint32_t vertexCount);
+
+	std::string getCachePath(const std::string & sourcePath);
+
+	//Whether the cache exists and was written no earlier than the source was last changed
+	bool isUpToDate(const std::string & sourcePath, const std::string & cachePath);
+
+	bool write(const std::string & cachePath, const MeshData & mesh);
+
+	//Checks the file is a cache this version can read and finds its streams
+	bool read(const MappedFile & file, MappedMesh & mesh);
+}
@@ -0,0 +1,324 @@
+#include "alvere/graphics/mesh_optimiser.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace alvere::mesh_optimiser
+{
+	//Forsyth's tuned constants
+	static const float s_cacheDecayPower = 1.5f;
+	static const float s_lastTriangleScore = 0.75f;
+	static const float s_valenceBoostScale = 2.0f;
+	static const float s_valenceBoostPower = 0.5f;
+
+	static uint32_t getVertexCount(const std::vector<float> & vertices, unsigned int vertexStride)
+	{
+		return (uint32_t)(vertices.size() / vertexStride);
+	}
+
+	Report optimise(std::vector<float> & vertices, std::vector<uint32_t> & indices, unsigned int vertexStride)
+	{
+		Report report;
+		report.m_verticesBefore = getVertexCount(vertices, vertexStride);
+		report.m_acmrBefore = computeACMR(indices, report.m_verticesBefore);
+
+		weldVertices(vertices, indices, vertexStride);
+		optimiseVertexCache(indices, getVertexCount(vertices, vertexStride));
+		optimiseVertexFetch(vertices, indices, vertexStride);
+
+		report.m_verticesAfter = getVertexCount(vertices, vertexStride);
+		report.m_acmrAfter = computeACMR(indices, report.m_verticesAfter);
+		return report;
+	}
+
+	void weldVertices(std::vector<float> & vertices, std::vector<uint32_t> & indices, unsigned int vertexStride)
+	{
+		const uint32_t vertexCount = getVertexCount(vertices, vertexStride);
+		const std::size_t vertexBytes = vertexStride * sizeof(float);
+
+		//Keyed by the vertex's index, hashed and compared by its bytes, so no vertex is copied to be looked up
+		auto hash = [&](uint32_t vertex)
+		{
+			const unsigned char * bytes = (const unsigned char *)&vertices[(std::size_t)vertex * vertexStride];
+
+			//FNV-1a
+			std::size_t value = 2166136261u;
+			for (std::size_t idx = 0; idx < vertexBytes; ++idx)
+				value = (value ^ bytes[idx]) * 16777619u;
+			return value;
+		};
+
+		auto equal = [&](uint32_t lhs, uint32_t rhs)
+		{
+			return std::memcmp(&vertices[(std::size_t)lhs * vertexStride], &vertices[(std::size_t)rhs * vertexStride], vertexBytes) == 0;
+		};
+
+		std::unordered_map<uint32_t, uint32_t, decltype(hash), decltype(equal)> unique(vertexCount, hash, equal);
+		std::vector<uint32_t> remap(vertexCount);
+
+		//Unique vertices are packed down in place. A vertex is only ever moved to or before its own slot, so it's
+		//never overwritten before it's been read.
+		uint32_t uniqueCount = 0;
+		for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+		{
+			auto inserted = unique.emplace(vertex, uniqueCount);
+			if (inserted.second == false)
+			{
+				remap[vertex] = inserted.first->second;
+				continue;
+			}
+
+			remap[vertex] = uniqueCount;
+			if (uniqueCount != vertex)
+			{
+				std::memcpy(&vertices[(std::size_t)uniqueCount * vertexStride], &vertices[(std::size_t)vertex * vertexStride], vertexBytes);
+
+				//The map has to find the vertex where it now lives
+				unique.erase(inserted.first);
+				unique.emplace(uniqueCount, uniqueCount);
+			}
+			++uniqueCount;
+		}
+
+		vertices.resize((std::size_t)uniqueCount * vertexStride);
+
+		for (uint32_t & index : indices)
+			index = remap[index];
+	}
+
+	static float scoreVertex(int cachePosition, uint32_t remainingTriangles)
+	{
+		//Nothing left to draw with it, so it shouldn't draw any triangle towards it
+		if (remainingTriangles == 0)
+			return -1.0f;
+
+		float score = 0.0f;
+
+		if (cachePosition >= 0)
+		{
+			//The last triangle's vertices get a fixed score, so the next triangle doesn't just reuse its edge in a strip
+			if (cachePosition < 3)
+			{
+				score = s_lastTriangleScore;
+			}
+			else
+			{
+				float scaler = 1.0f / (ALV_MESH_OPTIMISER_SCORING_CACHE_SIZE - 3);
+				score = std::pow(1.0f - (cachePosition - 3) * scaler, s_cacheDecayPower);
+			}
+		}
+
+		//Vertices with few triangles left are finished off first, so they don't get left behind as lone triangles
+		score += s_valenceBoostScale * std::pow((float)remainingTriangles, -s_valenceBoostPower);
+
+		return score;
+	}
+
+	void optimiseVertexCache(std::vector<uint32_t> & indices, uint32_t vertexCount)
+	{
+		const uint32_t triangleCount = (uint32_t)(indices.size() / 3);
+		if (triangleCount == 0)
+			return;
+
+		//Each vertex's triangles, packed one vertex after another. Drawn triangles are swapped past the remaining count.
+		std::vector<uint32_t> remainingTriangles(vertexCount, 0);
+		for (uint32_t index : indices)
+			++remainingTriangles[index];
+
+		std::vector<uint32_t> firstTriangle(vertexCount + 1, 0);
+		for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+			firstTriangle[vertex + 1] = firstTriangle[vertex] + remainingTriangles[vertex];
+
+		std::vector<uint32_t> vertexTriangles(indices.size());
+		{
+			std::vector<uint32_t> filled(vertexCount, 0);
+			for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+			{
+				for (unsigned int corner = 0; corner < 3; ++corner)
+				{
+					uint32_t vertex = indices[triangle * 3 + corner];
+					vertexTriangles[firstTriangle[vertex] + filled[vertex]++] = triangle;
+				}
+			}
+		}
+
+		std::vector<int> cachePosition(vertexCount, -1);
+		std::vector<float> vertexScore(vertexCount);
+		for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+			vertexScore[vertex] = scoreVertex(-1, remainingTriangles[vertex]);
+
+		std::vector<float> triangleScore(triangleCount);
+		std::vector<bool> triangleDrawn(triangleCount, false);
+		for (uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+		{
+			const uint32_t * corners = &indices[triangle * 3];
+			triangleScore[triangle] = vertexScore[corners[0]] + vertexScore[corners[1]] + vertexScore[corners[2]];
+		}
+
+		//Room for the cache plus the three vertices pushed in front of it by each triangle
+		std::vector<uint32_t> cache;
+		std::vector<uint32_t> nextCache;
+		cache.reserve(ALV_MESH_OPTIMISER_SCORING_CACHE_SIZE + 3);
+		nextCache.reserve(ALV_MESH_OPTIMISER_SCORING_CACHE_SIZE + 3);
+
+		std::vector<uint32_t> optimised;
+		optimised.reserve(indices.size());
+
+		//Vertices of drawn triangles, most recent last. When nothing in the cache has a triangle left, the next triangle
+		//comes from the newest of these that still has one, so it's still close to what was just drawn.
+		std::vector<uint32_t> deadEndStack;
+		deadEndStack.reserve(indices.size());
+
+		//Only walks forward past drawn triangles, so the fallback is linear over the whole mesh
+		uint32_t searchCursor = 0;
+
+		auto findDeadEndTriangle = [&]() -> uint32_t
+		{
+			while (deadEndStack.empty() == false)
+			{
+				uint32_t vertex = deadEndStack.back();
+				deadEndStack.pop_back();
+
+				if (remainingTriangles[vertex] > 0)
+					return vertexTriangles[firstTriangle[vertex]];
+			}
+
+			while (searchCursor < triangleCount && triangleDrawn[searchCursor])
+				++searchCursor;
+
+			return searchCursor;
+		};
+
+		//The first triangle is the only one that needs a search over all of them
+		uint32_t bestTriangle = 0;
+		for (uint32_t triangle = 1; triangle < triangleCount; ++triangle)
+		{
+			if (triangleScore[triangle] > triangleScore[bestTriangle])
+				bestTriangle = triangle;
+		}
+
+		while (bestTriangle < triangleCount)
+		{
+			const uint32_t * corners = &indices[bestTriangle * 3];
+			triangleDrawn[bestTriangle] = true;
+			optimised.insert(optimised.end(), corners, corners + 3);
+			deadEndStack.insert(deadEndStack.end(), corners, corners + 3);
+
+			//The drawn triangle's vertices go to the front of the cache, and everything else is pushed back behind them
+			nextCache.assign(corners, corners + 3);
+
+			for (unsigned int corner = 0; corner < 3; ++corner)
+			{
+				uint32_t vertex = corners[corner];
+
+				uint32_t * triangles = &vertexTriangles[firstTriangle[vertex]];
+				uint32_t & remaining = remainingTriangles[vertex];
+				for (uint32_t idx = 0; idx < remaining; ++idx)
+				{
+					if (triangles[idx] == bestTriangle)
+					{
+						std::swap(triangles[idx], triangles[remaining - 1]);
+						--remaining;
+						break;
+					}
+				}
+			}
+
+			for (uint32_t vertex : cache)
+			{
+				if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2])
+					nextCache.push_back(vertex);
+			}
+
+			//Vertices pushed out of the cache are rescored once more, since they no longer have its bonus
+			for (std::size_t position = 0; position < nextCache.size(); ++position)
+			{
+				uint32_t vertex = nextCache[position];
+				int newPosition = position < ALV_MESH_OPTIMISER_SCORING_CACHE_SIZE ? (int)position : -1;
+
+				cachePosition[vertex] = newPosition;
+				float newScore = scoreVertex(newPosition, remainingTriangles[vertex]);
+				float change = newScore - vertexScore[vertex];
+				vertexScore[vertex] = newScore;
+
+				const uint32_t * triangles = &vertexTriangles[firstTriangle[vertex]];
+				for (uint32_t idx = 0; idx < remainingTriangles[vertex]; ++idx)
+					triangleScore[triangles[idx]] += change;
+			}
+
+			if (nextCache.size() > ALV_MESH_OPTIMISER_SCORING_CACHE_SIZE)
+				nextCache.resize(ALV_MESH_OPTIMISER_SCORING_CACHE_SIZE);
+			std::swap(cache, nextCache);
+
+			//The next triangle is almost always one that shares a vertex in the cache
+			bestTriangle = triangleCount;
+			float bestScore = -1.0f;
+			for (uint32_t vertex : cache)
+			{
+				const uint32_t * triangles = &vertexTriangles[firstTriangle[vertex]];
+				for (uint32_t idx = 0; idx < remainingTriangles[vertex]; ++idx)
+				{
+					uint32_t triangle = triangles[idx];
+					if (triangleScore[triangle] > bestScore)
+					{
+						bestScore = triangleScore[triangle];
+						bestTriangle = triangle;
+					}
+				}
+			}
+
+			if (bestTriangle == triangleCount)
+				bestTriangle = findDeadEndTriangle();
+		}
+
+		indices.swap(optimised);
+	}
+
+	void optimiseVertexFetch(std::vector<float> & vertices, std::vector<uint32_t> & indices, unsigned int vertexStride)
+	{
+		const uint32_t vertexCount = getVertexCount(vertices, vertexStride);
+		const uint32_t unused = ~0u;
+
+		std::vector<uint32_t> remap(vertexCount, unused);
+		std::vector<float> reordered;
+		reordered.reserve(vertices.size());
+
+		uint32_t nextVertex = 0;
+		for (uint32_t & index : indices)
+		{
+			if (remap[index] == unused)
+			{
+				remap[index] = nextVertex++;
+				const float * vertex = &vertices[(std::size_t)index * vertexStride];
+				reordered.insert(reordered.end(), vertex, vertex + vertexStride);
+			}
+
+			index = remap[index];
+		}
+
+		vertices.swap(reordered);
+	}
+
+	float computeACMR(const std::vector<uint32_t> & indices, uint32_t vertexCount, unsigned int cacheSize)
+	{
+		const std::size_t triangleCount = indices.size() / 3;
+		if (triangleCount == 0 || cacheSize == 0)
+			return 0.0f;
+
+		//A vertex is in the FIFO while fewer than cacheSize misses have happened since it was loaded
+		std::vector<std::size_t> loadedAt(vertexCount, 0);
+		std::size_t misses = 0;
+
+		for (uint32_t index : indices)
+		{
+			if (loadedAt[index] == 0 || misses - loadedAt[index] >= cacheSize)
+			{
+				++misses;
+				loadedAt[index] = misses;
+			}
+		}
+
+		return (float)misses / triangleCount;
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//The FIFO cache ACMR is measured with, about the size of the post-transform cache on most GPUs
+#define ALV_MESH_OPTIMISER_ACMR_CACHE_SIZE 16
+//The LRU cache the triangle order is scored against. It's larger than the real cache, which spreads the benefit
+//over cache sizes instead of fitting just one.
+#define ALV_MESH_OPTIMISER_SCORING_CACHE_SIZE 32
+
+namespace alvere::mesh_optimiser
+{
+	struct Report
+	{
+		uint32_t m_verticesBefore;
+		uint32_t m_verticesAfter;
+		//Average cache misses per triangle, from 3 at worst down towards 0.5 for a regular grid
+		float m_acmrBefore;
+		float m_acmrAfter;
+	};
+
+	//Welds, orders the triangles for the vertex cache and then the vertices for fetching, in that order.
+	//Vertices are vertexStride floats each.
+	Report optimise(std::vector<float> & vertices, std::vector<uint32_t> & indices, unsigned int vertexStride);
+
+	//Merges vertices whose every component is bitwise equal
+	void weldVertices(std::vector<float> & vertices, std::vector<uint32_t> & indices, unsigned int vertexStride);
+
+	//Reorders the triangles with Tom Forsyth's linear-speed vertex cache optimisation, which greedily draws the
+	//triangle whose vertices score highest for being recently used and having few triangles left to draw
+	void optimiseVertexCache(std::vector<uint32_t> & indices, uint32_t vertexCount);
+
+	//Reorders the vertices into the order the indices first use them, so fetching them walks forwards through memory.
+	//Vertices no triangle uses are dropped.
+	void optimiseVertexFetch(std::vector<float> & vertices, std::vector<uint32_t> & indices, unsigned int vertexStride);
+
+	float computeACMR(const std::vector<uint32_t> & indices, uint32_t vertexCount, unsigned int cacheSize = ALV_MESH_OPTIMISER_ACMR_CACHE_SIZE);
+}
@@ -0,0 +1,181 @@
+#include "alvere/graphics/render_thread.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace alvere
+{
+	static double secondsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+	{
+		return std::chrono::duration<double>(end - start).count();
+	}
+
+	RenderThread::RenderThread(std::function<void()> onStart, std::function<void()> onFrameEnd, std::function<void()> onStop)
+		: m_onStart(std::move(onStart))
+		, m_onFrameEnd(std::move(onFrameEnd))
+		, m_onStop(std::move(onStop))
+		, m_recording(0)
+		, m_pending(false)
+		, m_stopping(false)
+	{
+		resetStats();
+
+		m_thread = std::thread(&RenderThread::run, this);
+	}
+
+	RenderThread::~RenderThread()
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			waitForPending(lock);
+			m_stopping = true;
+		}
+		m_frameSubmitted.notify_one();
+
+		m_thread.join();
+	}
+
+	void RenderThread::submit()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		Clock::time_point waitStart = Clock::now();
+		waitForPending(lock);
+		m_totalWaitTime += secondsBetween(waitStart, Clock::now());
+		++m_submits;
+
+		m_recording ^= 1;
+		m_pending = true;
+		m_submitTime = Clock::now();
+
+		std::exception_ptr exception = std::exchange(m_exception, nullptr);
+
+		lock.unlock();
+		m_frameSubmitted.notify_one();
+
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+
+	void RenderThread::wait()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		waitForPending(lock);
+
+		if (std::exception_ptr exception = std::exchange(m_exception, nullptr))
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+
+	RenderThread::Stats RenderThread::getStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		Stats stats;
+		stats.m_frames = m_frames;
+		stats.m_maximumLatency = m_maximumLatency;
+
+		if (m_frames > 0)
+		{
+			stats.m_averageLatency = m_totalLatency / m_frames;
+			stats.m_averageExecuteTime = m_totalExecuteTime / m_frames;
+
+			double elapsed = secondsBetween(m_statsStart, Clock::now());
+			stats.m_framesPerSecond = elapsed > 0.0 ? m_frames / elapsed : 0.0;
+		}
+
+		if (m_submits > 0)
+		{
+			stats.m_averageWaitTime = m_totalWaitTime / m_submits;
+		}
+
+		return stats;
+	}
+
+	void RenderThread::resetStats()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_statsStart = Clock::now();
+		m_frames = 0;
+		m_totalLatency = 0.0;
+		m_maximumLatency = 0.0;
+		m_totalExecuteTime = 0.0;
+		m_totalWaitTime = 0.0;
+		m_submits = 0;
+	}
+
+	void RenderThread::run()
+	{
+		if (m_onStart)
+		{
+			m_onStart();
+		}
+
+		while (true)
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_frameSubmitted.wait(lock, [this]() { return m_pending || m_stopping; });
+
+			if (m_pending == false)
+			{
+				break;
+			}
+
+			//The recording thread only ever touches the other list while this one is pending
+			CommandList & list = m_lists[m_recording ^ 1];
+			Clock::time_point submitTime = m_submitTime;
+			lock.unlock();
+
+			Clock::time_point executeStart = Clock::now();
+			std::exception_ptr exception;
+
+			try
+			{
+				list.execute();
+
+				if (m_onFrameEnd)
+				{
+					m_onFrameEnd();
+				}
+			}
+			catch (...)
+			{
+				exception = std::current_exception();
+			}
+
+			Clock::time_point executeEnd = Clock::now();
+
+			lock.lock();
+			double latency = secondsBetween(submitTime, executeEnd);
+			m_totalLatency += latency;
+			m_maximumLatency = std::max(m_maximumLatency, latency);
+			m_totalExecuteTime += secondsBetween(executeStart, executeEnd);
+			++m_frames;
+
+			//Only the first exception is kept, and it is handed over under the lock so the other thread never shares it
+			if (m_exception == nullptr)
+			{
+				m_exception = std::move(exception);
+			}
+			exception = nullptr;
+
+			m_pending = false;
+			lock.unlock();
+			m_frameExecuted.notify_all();
+		}
+
+		if (m_onStop)
+		{
+			m_onStop();
+		}
+	}
+
+	void RenderThread::waitForPending(std::unique_lock<std::mutex> & lock)
+	{
+		m_frameExecuted.wait(lock, [this]() { return m_pending == false; });
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "alvere/graphics/command_list.hpp"
+
+namespace alvere
+{
+	//Executes the command lists recorded by one thread on a thread of its own, a frame behind.
+	//There are two lists: the one being recorded and the one being executed. Submitting swaps them, and blocks
+	//until the previous frame has been executed, so the recording thread is never more than one frame ahead.
+	//Whatever owns the graphics context should make it current in onStart and present in onFrameEnd.
+	//Application::run doesn't drive one yet: render() still creates GL objects directly (textures, atlas pages,
+	//chunk batches, ImGui) and reads the world update() writes, so only code that snapshots its inputs can use it.
+	class RenderThread
+	{
+	public:
+
+		struct Stats
+		{
+			unsigned int m_frames = 0;
+
+			//From a frame being submitted to it finishing on the render thread
+			double m_averageLatency = 0.0;
+			double m_maximumLatency = 0.0;
+
+			//Time spent running commands on the render thread per frame
+			double m_averageExecuteTime = 0.0;
+
+			//Time the recording thread spent blocked in submit() per frame, waiting for the render thread
+			double m_averageWaitTime = 0.0;
+
+			//Frames executed per second since the stats were reset
+			double m_framesPerSecond = 0.0;
+		};
+
+		RenderThread(std::function<void()> onStart = nullptr, std::function<void()> onFrameEnd = nullptr, std::function<void()> onStop = nullptr);
+
+		//Finishes the last submitted frame and joins the thread. Anything left in the recording list is dropped.
+		~RenderThread();
+
+		RenderThread(const RenderThread &) = delete;
+		RenderThread & operator=(const RenderThread &) = delete;
+
+		//The list for the next frame. Only the recording thread may touch it, and only until it calls submit().
+		CommandList & getCommandList() { return m_lists[m_recording]; }
+
+		//Hands the recorded list to the render thread and starts a new one.
+		//If a command threw on the render thread, the exception is rethrown here.
+		void submit();
+
+		//Blocks until every submitted frame has been executed
+		void wait();
+
+		Stats getStats() const;
+
+		void resetStats();
+
+	private:
+
+		using Clock = std::chrono::steady_clock;
+
+		std::function<void()> m_onStart;
+		std::function<void()> m_onFrameEnd;
+		std::function<void()> m_onStop;
+
+		CommandList m_lists[2];
+		unsigned int m_recording;
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_frameSubmitted;
+		std::condition_variable m_frameExecuted;
+
+		bool m_pending;
+		bool m_stopping;
+		Clock::time_point m_submitTime;
+		std::exception_ptr m_exception;
+
+		Clock::time_point m_statsStart;
+		unsigned int m_frames;
+		double m_totalLatency;
+		double m_maximumLatency;
+		double m_totalExecuteTime;
+		double m_totalWaitTime;
+		unsigned int m_submits;
+
+		std::thread m_thread;
+
+		void run();
+
+		//Waits for the render thread to finish the frame it has, with the mutex held
+		void waitForPending(std::unique_lock<std::mutex> & lock);
+	};
+}
@@ -1,13 +1,34 @@
 #include "alvere/graphics/renderer.hpp"
 
-#include <algorithm>
+#include "alvere/graphics/frame_constants.hpp"
+#include "alvere/utils/radix_sort.hpp"
+
+//Widths of the sort key's fields, which fill all 64 bits
+#define ALV_RENDERER_SORT_PASS_BITS 2
+#define ALV_RENDERER_SORT_PROGRAM_BITS 10
+#define ALV_RENDERER_SORT_MATERIAL_BITS 12
+#define ALV_RENDERER_SORT_MESH_BITS 12
+#define ALV_RENDERER_SORT_DEPTH_BITS 28
 
 namespace alvere
 {
+	static uint64_t maskSortField(uint64_t value, unsigned int bits)
+	{
+		return value & ((uint64_t(1) << bits) - 1);
+	}
+
+	Renderer::Renderer()
+		: m_projectionMatrix(nullptr), m_viewMatrix(nullptr)
+	{ }
+
 	void Renderer::begin(const Camera & camera)
 	{
 		m_projectionMatrix = &camera.getProjectionMatrix();
 		m_viewMatrix = &camera.getViewMatrix();
+
+		FrameConstants & frameConstants = FrameConstants::get();
+		frameConstants.setCamera(camera);
+		frameConstants.upload();
 	}
 
 	void Renderer::end()
@@ -18,9 +39,43 @@ namespace alvere
 		flush();
 	}
 
-	void Renderer::submit(const Mesh * mesh, const MaterialInstance * material, const Matrix4 & m_localTransform)
+	void Renderer::submit(const Mesh * mesh, const MaterialInstance * material, const Matrix4 & m_localTransform, Pass pass)
+	{
+		//Distance in front of the camera, which looks down negative z
+		float depth = 0.0f;
+		if (m_viewMatrix != nullptr)
+			depth = -((*m_viewMatrix) * m_localTransform[3]).z;
+
+		uint64_t sortKey = makeSortKey(pass,
+			getSortId(m_programIds, material->getBaseMaterial()->getShaderProgram()),
+			getSortId(m_materialIds, material),
+			getSortId(m_meshIds, mesh),
+			depth);
+
+		m_drawCommands.push_back(DrawCommand{ mesh, material, m_localTransform, sortKey });
+	}
+
+	uint64_t Renderer::makeSortKey(Pass pass, uint32_t programId, uint32_t materialId, uint32_t meshId, float depth)
+	{
+		//The top bits of a float's sortable form still sort in the same order, only more coarsely
+		uint64_t depthBits = utils::sortableFloatBits(depth) >> (32 - ALV_RENDERER_SORT_DEPTH_BITS);
+
+		uint64_t state = maskSortField(programId, ALV_RENDERER_SORT_PROGRAM_BITS);
+		state = (state << ALV_RENDERER_SORT_MATERIAL_BITS) | maskSortField(materialId, ALV_RENDERER_SORT_MATERIAL_BITS);
+		state = (state << ALV_RENDERER_SORT_MESH_BITS) | maskSortField(meshId, ALV_RENDERER_SORT_MESH_BITS);
+
+		const unsigned int stateBits = ALV_RENDERER_SORT_PROGRAM_BITS + ALV_RENDERER_SORT_MATERIAL_BITS + ALV_RENDERER_SORT_MESH_BITS;
+		uint64_t key = (uint64_t)pass << (64 - ALV_RENDERER_SORT_PASS_BITS);
+
+		if (pass == Pass::Transparent)
+			return key | (maskSortField(~depthBits, ALV_RENDERER_SORT_DEPTH_BITS) << stateBits) | state;
+
+		return key | (state << ALV_RENDERER_SORT_DEPTH_BITS) | depthBits;
+	}
+
+	Renderer::Pass Renderer::getSortKeyPass(uint64_t sortKey)
 	{
-		m_drawCommands.push_back(DrawCommand{ mesh, material, m_localTransform });
+		return (Pass)(sortKey >> (64 - ALV_RENDERER_SORT_PASS_BITS));
 	}
 
 	Renderer::DrawCommand & Renderer::DrawCommand::operator=(const DrawCommand & rhs)
@@ -28,14 +83,51 @@ namespace alvere
 		mesh = rhs.mesh;
 		material = rhs.material;
 		m_localTransform = rhs.m_localTransform;
+		m_sortKey = rhs.m_sortKey;
 		return *this;
 	}
 
 	void Renderer::sortDrawCommands()
 	{
-		std::sort(m_drawCommands.begin(), m_drawCommands.end(), [](const DrawCommand & lhs, const DrawCommand & rhs)
+		m_programIds.clear();
+		m_materialIds.clear();
+		m_meshIds.clear();
+
+		m_sortKeys.resize(m_drawCommands.size());
+		m_sortOrder.resize(m_drawCommands.size());
+		for (uint32_t idx = 0; idx < (uint32_t)m_drawCommands.size(); ++idx)
 		{
-			return (intptr_t)lhs.mesh < (intptr_t)rhs.mesh;
-		});
+			m_sortKeys[idx] = m_drawCommands[idx].m_sortKey;
+			m_sortOrder[idx] = idx;
+		}
+
+		//Sorting the keys alone keeps the passes over memory small, and the commands are moved into place once at the end
+		utils::radixSort(m_sortKeys, m_sortOrder, m_sortKeyScratch, m_sortOrderScratch);
+
+		m_sortedDrawCommands.resize(m_drawCommands.size());
+		for (std::size_t idx = 0; idx < m_sortOrder.size(); ++idx)
+			m_sortedDrawCommands[idx] = m_drawCommands[m_sortOrder[idx]];
+
+		std::swap(m_drawCommands, m_sortedDrawCommands);
+	}
+
+	std::size_t Renderer::findGroupEnd(std::size_t first) const
+	{
+		const DrawCommand & group = m_drawCommands[first];
+		Pass pass = getSortKeyPass(group.m_sortKey);
+
+		std::size_t end = first + 1;
+		while (end < m_drawCommands.size()
+			&& m_drawCommands[end].mesh == group.mesh
+			&& m_drawCommands[end].material == group.material
+			&& getSortKeyPass(m_drawCommands[end].m_sortKey) == pass)
+			++end;
+
+		return end;
+	}
+
+	uint32_t Renderer::getSortId(std::unordered_map<const void *, uint32_t> & ids, const void * object)
+	{
+		return ids.emplace(object, (uint32_t)ids.size()).first->second;
 	}
-}
\ No newline at end of file
+}
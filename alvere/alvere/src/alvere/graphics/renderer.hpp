@@ -1,23 +1,49 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 #include "alvere/graphics/camera.hpp"
 #include "alvere/graphics/material_instance.hpp"
 #include "alvere/graphics/mesh.hpp"
 #include "alvere/math/matrix/matrix_4.hpp"
 
+//Draws whose shader has no u_modelMatrix uniform are instanced, and read their model matrix from a mat4 vertex
+//attribute at this location instead. It takes four locations, one per column.
+#define ALV_RENDERER_MODEL_MATRIX_LOCATION 8
+
 namespace alvere
 {
 	class Renderer
 	{
 	public:
 
+		//Opaque draws are drawn first, front to back and without blending. Transparent draws are blended over them, back to front.
+		enum class Pass
+		{
+			Opaque,
+			Transparent
+		};
+
 		static Renderer * New();
 
+		virtual ~Renderer() = default;
+
 		void begin(const Camera & camera);
 
 		void end();
 
-		virtual void submit(const Mesh * mesh, const MaterialInstance * material, const Matrix4 & m_localTransform);
+		//Draws are sorted when they're flushed, so they should be submitted between begin() and end() for their depth to be known
+		virtual void submit(const Mesh * mesh, const MaterialInstance * material, const Matrix4 & m_localTransform, Pass pass = Pass::Opaque);
+
+		//Packs the pass into the top 2 bits. Opaque draws follow it with their program, material and mesh ids, then their
+		//depth, so every state change is as rare as possible. Transparent draws have to be drawn back to front,
+		//so their depth comes straight after the pass. Ids are masked to fit, so too many only costs extra state changes.
+		static uint64_t makeSortKey(Pass pass, uint32_t programId, uint32_t materialId, uint32_t meshId, float depth);
+
+		static Pass getSortKeyPass(uint64_t sortKey);
 
 	protected:
 
@@ -29,6 +55,8 @@ namespace alvere
 
 			Matrix4 m_localTransform;
 
+			uint64_t m_sortKey;
+
 			DrawCommand & operator=(const DrawCommand & rhs);
 		};
 
@@ -38,10 +66,32 @@ namespace alvere
 
 		const Matrix4 * m_viewMatrix;
 
+		Renderer();
+
+		//Sorts by the commands' keys, so draws that can be instanced together end up next to each other
 		void sortDrawCommands();
 
+		//The end of the run of sorted draw commands from first on that share its pass, mesh and material
+		std::size_t findGroupEnd(std::size_t first) const;
+
 		virtual void flush() = 0;
 
-		virtual void processDrawCommand(const DrawCommand & command) = 0;
+		//Draws a run of commands that share a mesh and material
+		virtual void processDrawGroup(const DrawCommand * commands, std::size_t count) = 0;
+
+	private:
+
+		//Small ids for the sort keys, handed out in the order things are first submitted since the last sort
+		std::unordered_map<const void *, uint32_t> m_programIds;
+		std::unordered_map<const void *, uint32_t> m_materialIds;
+		std::unordered_map<const void *, uint32_t> m_meshIds;
+
+		std::vector<uint64_t> m_sortKeys;
+		std::vector<uint32_t> m_sortOrder;
+		std::vector<uint64_t> m_sortKeyScratch;
+		std::vector<uint32_t> m_sortOrderScratch;
+		std::vector<DrawCommand> m_sortedDrawCommands;
+
+		static uint32_t getSortId(std::unordered_map<const void *, uint32_t> & ids, const void * object);
 	};
 }
\ No newline at end of file
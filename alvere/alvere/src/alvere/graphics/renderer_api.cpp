@@ -2,11 +2,15 @@
 
 #ifdef ALV_GRAPHICS_API_OPENGL
 #include "graphics_api/opengl/opengl_renderer_api.hpp"
+#else
+#include "graphics_api/null/null_renderer_api.hpp"
 #endif
 
 namespace alvere
 {
 #ifdef ALV_GRAPHICS_API_OPENGL
 	std::unique_ptr<RendererAPI> RendererAPI::s_Instance = std::make_unique<graphics_api::opengl::RendererAPI>();
+#else
+	std::unique_ptr<RendererAPI> RendererAPI::s_Instance = std::make_unique<graphics_api::null::RendererAPI>();
 #endif
 }
\ No newline at end of file
@@ -11,6 +11,8 @@ namespace alvere
 	public:
 		static std::unique_ptr<RendererAPI> s_Instance;
 
+		virtual ~RendererAPI() = default;
+
 		virtual void setClearColour(const alvere::Vector4& colour) = 0;
 
 		virtual void clear() = 0;
@@ -21,6 +21,10 @@ namespace alvere
 			case DataType::Int4:		return sizeof(int) * 4;
 			case DataType::Mat4x4:		return sizeof(float) * 16;
 			case DataType::Sampler2D:	return sizeof(int) * 1;
+			case DataType::UInt:		return sizeof(unsigned int) * 1;
+			case DataType::UShort2:		return sizeof(unsigned short) * 2;
+			case DataType::UShort4:		return sizeof(unsigned short) * 4;
+			case DataType::UByte4:		return sizeof(unsigned char) * 4;
 		}
 		return 0;
 	}
@@ -39,6 +43,10 @@ namespace alvere
 			case DataType::Int4:		return 4;
 			case DataType::Mat4x4:		return 16;
 			case DataType::Sampler2D:	return 1;
+			case DataType::UInt:		return 1;
+			case DataType::UShort2:		return 2;
+			case DataType::UShort4:		return 4;
+			case DataType::UByte4:		return 4;
 		}
 		return 0;
 	}
@@ -26,7 +26,13 @@ namespace alvere
 			Int3,
 			Int4,
 			Mat4x4,
-			Sampler2D
+			Sampler2D,
+			//Packed vertex attribute types. The UShort and UByte types are read as floats, normalised if the buffer
+			//element asks for it, and UInt is read as an integer.
+			UInt,
+			UShort2,
+			UShort4,
+			UByte4
 		};
 
 		static std::unique_ptr<Shader> New(Shader::Type type, const std::string & source);
@@ -3,6 +3,8 @@
 #include <glad/glad.h>
 #include <vector>
 
+#include "alvere/debug/logging.hpp"
+
 namespace alvere
 {
 	const Shader * ShaderProgram::getShader(Shader::Type type) const
@@ -17,7 +19,66 @@ namespace alvere
 		m_shaders[shader->getType()] = shader;
 	}
 
+	void ShaderProgram::sendUniformInt1(const std::string & id, int value) const
+	{
+		sendUniform(getUniform<Shader::DataType::Int>(id), value);
+	}
+
+	void ShaderProgram::sendUniformInt2(const std::string & id, int value1, int value2) const
+	{
+		sendUniform(getUniform<Shader::DataType::Int2>(id), value1, value2);
+	}
+
+	void ShaderProgram::sendUniformInt3(const std::string & id, int value1, int value2, int value3) const
+	{
+		sendUniform(getUniform<Shader::DataType::Int3>(id), value1, value2, value3);
+	}
+
+	void ShaderProgram::sendUniformInt4(const std::string & id, int value1, int value2, int value3, int value4) const
+	{
+		sendUniform(getUniform<Shader::DataType::Int4>(id), value1, value2, value3, value4);
+	}
+
+	void ShaderProgram::sendUniformFloat1(const std::string & id, float value) const
+	{
+		sendUniform(getUniform<Shader::DataType::Float>(id), value);
+	}
+
+	void ShaderProgram::sendUniformFloat2(const std::string & id, float value1, float value2) const
+	{
+		sendUniform(getUniform<Shader::DataType::Float2>(id), value1, value2);
+	}
+
+	void ShaderProgram::sendUniformFloat3(const std::string & id, float value1, float value2, float value3) const
+	{
+		sendUniform(getUniform<Shader::DataType::Float3>(id), value1, value2, value3);
+	}
+
+	void ShaderProgram::sendUniformFloat4(const std::string & id, float value1, float value2, float value3, float value4) const
+	{
+		sendUniform(getUniform<Shader::DataType::Float4>(id), value1, value2, value3, value4);
+	}
+
+	void ShaderProgram::sendUniformMat4x4(const std::string & id, const Matrix4 & matrix) const
+	{
+		sendUniform(getUniform<Shader::DataType::Mat4x4>(id), matrix);
+	}
+
 	ShaderProgram::ShaderProgram()
 		: m_handle(0)
 	{ }
-}
\ No newline at end of file
+
+	int ShaderProgram::findUniform(const std::string & id, Shader::DataType type) const
+	{
+		auto iter = m_uniforms.find(id);
+		if (iter == m_uniforms.end())
+			return -1;
+
+		const Uniform & uniform = iter->second;
+		if (uniform.m_type == type || (uniform.m_type == Shader::DataType::Sampler2D && type == Shader::DataType::Int))
+			return uniform.m_location;
+
+		LogWarning("Shader uniform '%s' was used as the wrong type.\n", id.c_str());
+		return -1;
+	}
+}
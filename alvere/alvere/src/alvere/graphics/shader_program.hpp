@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 
 #include "alvere/graphics/shader.hpp"
@@ -8,14 +9,47 @@
 
 namespace alvere
 {
+	class ShaderProgram;
+
+	//A uniform of a shader program, looked up once so sending it needs no search by name.
+	//Only valid for the program it was got from. Sending an invalid handle does nothing.
+	template <Shader::DataType ShaderDataType>
+	class UniformHandle
+	{
+	public:
+
+		UniformHandle() : m_location(-1) { }
+
+		bool isValid() const { return m_location >= 0; }
+
+		int getLocation() const { return m_location; }
+
+	private:
+
+		friend ShaderProgram;
+
+		explicit UniformHandle(int location) : m_location(location) { }
+
+		int m_location;
+	};
+
 	class ShaderProgram
 	{
 	public:
 
+		//An active uniform, as found when the program was built. Arrays have an entry per element.
+		struct Uniform
+		{
+			Shader::DataType m_type;
+			int m_location;
+		};
+
 		static std::unique_ptr<ShaderProgram> New();
 
 		ShaderProgram(const ShaderProgram & shaderProgram) = delete;
 
+		virtual ~ShaderProgram() = default;
+
 		const Shader * getShader(Shader::Type type) const;
 
 		void SetShader(const Shader * shader);
@@ -26,23 +60,55 @@ namespace alvere
 
 		virtual void unbind() const = 0;
 
-		virtual void sendUniformInt1(const std::string & id, int value) const = 0;
+		//Returns an invalid handle if the program has no active uniform called id, or one of a different type.
+		//Samplers can be got as ints, which is how their texture unit is set.
+		template <Shader::DataType ShaderDataType>
+		UniformHandle<ShaderDataType> getUniform(const std::string & id) const
+		{
+			return UniformHandle<ShaderDataType>(findUniform(id, ShaderDataType));
+		}
+
+		const std::unordered_map<std::string, Uniform> & getUniforms() const { return m_uniforms; }
 
-		virtual void sendUniformInt2(const std::string & id, int value1, int value2) const = 0;
+		virtual void sendUniform(UniformHandle<Shader::DataType::Int> uniform, int value) const = 0;
 
-		virtual void sendUniformInt3(const std::string & id, int value1, int value2, int value3) const = 0;
+		virtual void sendUniform(UniformHandle<Shader::DataType::Int2> uniform, int value1, int value2) const = 0;
 
-		virtual void sendUniformInt4(const std::string & id, int value1, int value2, int value3, int value4) const = 0;
+		virtual void sendUniform(UniformHandle<Shader::DataType::Int3> uniform, int value1, int value2, int value3) const = 0;
 
-		virtual void sendUniformFloat1(const std::string & id, float value) const = 0;
+		virtual void sendUniform(UniformHandle<Shader::DataType::Int4> uniform, int value1, int value2, int value3, int value4) const = 0;
 
-		virtual void sendUniformFloat2(const std::string & id, float value1, float value2) const = 0;
+		virtual void sendUniform(UniformHandle<Shader::DataType::Float> uniform, float value) const = 0;
 
-		virtual void sendUniformFloat3(const std::string & id, float value1, float value2, float value3) const = 0;
+		virtual void sendUniform(UniformHandle<Shader::DataType::Float2> uniform, float value1, float value2) const = 0;
 
-		virtual void sendUniformFloat4(const std::string & id, float value1, float value2, float value3, float value4) const = 0;
+		virtual void sendUniform(UniformHandle<Shader::DataType::Float3> uniform, float value1, float value2, float value3) const = 0;
 
-		virtual void sendUniformMat4x4(const std::string & id, const Matrix4 & matrix) const = 0;
+		virtual void sendUniform(UniformHandle<Shader::DataType::Float4> uniform, float value1, float value2, float value3, float value4) const = 0;
+
+		virtual void sendUniform(UniformHandle<Shader::DataType::Mat4x4> uniform, const Matrix4 & matrix) const = 0;
+
+		//Sets the texture unit the sampler reads from
+		virtual void sendUniform(UniformHandle<Shader::DataType::Sampler2D> uniform, int textureUnit) const = 0;
+
+		//These look the uniform up by name every time. Prefer a handle for anything sent every frame.
+		void sendUniformInt1(const std::string & id, int value) const;
+
+		void sendUniformInt2(const std::string & id, int value1, int value2) const;
+
+		void sendUniformInt3(const std::string & id, int value1, int value2, int value3) const;
+
+		void sendUniformInt4(const std::string & id, int value1, int value2, int value3, int value4) const;
+
+		void sendUniformFloat1(const std::string & id, float value) const;
+
+		void sendUniformFloat2(const std::string & id, float value1, float value2) const;
+
+		void sendUniformFloat3(const std::string & id, float value1, float value2, float value3) const;
+
+		void sendUniformFloat4(const std::string & id, float value1, float value2, float value3, float value4) const;
+
+		void sendUniformMat4x4(const std::string & id, const Matrix4 & matrix) const;
 
 	protected:
 
@@ -50,6 +116,14 @@ namespace alvere
 
 		std::unordered_map<Shader::Type, const Shader *> m_shaders;
 
+		//Filled in by build()
+		std::unordered_map<std::string, Uniform> m_uniforms;
+
 		ShaderProgram();
+
+	private:
+
+		//Returns the uniform's location, or -1
+		int findUniform(const std::string & id, Shader::DataType type) const;
 	};
-}
\ No newline at end of file
+}
@@ -1,12 +1,16 @@
 #include "alvere/graphics/sprite_batcher.hpp"
 
-#include <algorithm>
-#include <stdint.h>
-
 #include "alvere/debug/exceptions.hpp"
+#include "alvere/utils/radix_sort.hpp"
 
 namespace alvere
 {
+	SpriteBatcher::SpriteBatcher(unsigned int capacity, VertexFormat vertexFormat)
+		: m_HasBegun(false), m_Capacity(capacity), m_VertexFormat(vertexFormat), m_SpriteCount(0), m_FlushCount(0), m_SortMode(SortMode::Default), m_TransformationMatrix(nullptr)
+	{
+		AlvAssert(capacity > 0, "SpriteBatcher capacity must be at least one sprite.");
+	}
+
 	void SpriteBatcher::begin(const alvere::Matrix4& transformationMatrix, SortMode sortMode)
 	{
 		AlvAssert(!m_HasBegun, "SpriteBatcher.Begin() cannot be called before the current SpriteBatcher batch has ended.");
@@ -14,15 +18,27 @@ namespace alvere
 		m_HasBegun = true;
 		m_TransformationMatrix = &transformationMatrix;
 		m_SortMode = sortMode;
+		m_FlushCount = 0;
 	}
 
 	void SpriteBatcher::end()
 	{
 		SortDrawCommands();
 
-		for (const DrawSpriteCommand& command : m_DrawCommands)
+		if (m_SortMode == SortMode::Default)
 		{
-			processDrawCommandData(command);
+			for (const DrawSpriteCommand& command : m_DrawCommands)
+			{
+				processDrawCommandData(command);
+			}
+		}
+		else
+		{
+			//The bottom half of each key is the index of its command
+			for (uint64_t key : m_SortKeys)
+			{
+				processDrawCommandData(m_DrawCommands[(uint32_t)key]);
+			}
 		}
 
 		if (m_SpriteCount > 0)
@@ -51,6 +67,11 @@ namespace alvere
 		m_DrawCommands.push_back({ texture, destination, source, false, 0.0f, tint });
 	}
 
+	void SpriteBatcher::submit(const Texture * texture, Rect destination, RectI source, alvere::Vector4 tint, float sortLayer)
+	{
+		m_DrawCommands.push_back({ texture, destination, source, true, sortLayer, tint });
+	}
+
 	void SpriteBatcher::submit(const Font::Face::Bitmap & fontFaceBitmap, const std::string & text, Vector2 position, Vector4 colour)
 	{
 		const Texture * texture = fontFaceBitmap.getTexture();
@@ -103,33 +124,58 @@ namespace alvere
 		texture = rhs.texture;
 		destination = rhs.destination;
 		source = rhs.source;
+		isSortLayerSpecified = rhs.isSortLayerSpecified;
 		sortLayer = rhs.sortLayer;
 		tint = rhs.tint;
 		return *this;
 	}
 
-	void SpriteBatcher::SortDrawCommands()
+	uint64_t SpriteBatcher::makeSortKey(SortMode sortMode, float sortLayer, uint32_t textureId, uint32_t submissionOrder)
 	{
-		switch (m_SortMode)
-		{
-		case SortMode::Texture:
+		uint64_t primary = 0;
+
+		switch (sortMode)
 		{
-			std::sort(m_DrawCommands.begin(), m_DrawCommands.end(), [](const DrawSpriteCommand& lhs, const DrawSpriteCommand& rhs)
-			{
-				return (intptr_t)lhs.texture < (intptr_t)rhs.texture;
-			});
-			break;
+		case SortMode::FrontToBack: primary = ~utils::sortableFloatBits(sortLayer); break;
+		case SortMode::BackToFront: primary = utils::sortableFloatBits(sortLayer); break;
+		case SortMode::Texture: primary = textureId; break;
+		default: break;
 		}
 
-		case SortMode::BackToFront:
+		return (primary << 32) | submissionOrder;
+	}
+
+	void SpriteBatcher::SortDrawCommands()
+	{
+		m_SortKeys.clear();
+
+		//Already in submission order
+		if (m_SortMode == SortMode::Default)
 		{
-			break;
+			return;
 		}
 
-		case SortMode::FrontToBack:
+		m_SortKeys.reserve(m_DrawCommands.size());
+		m_TextureIds.clear();
+
+		const Texture * lastTexture = nullptr;
+		uint32_t lastTextureId = 0;
+
+		for (uint32_t idx = 0; idx < (uint32_t)m_DrawCommands.size(); ++idx)
 		{
-			break;
-		}
+			const DrawSpriteCommand & command = m_DrawCommands[idx];
+
+			//Runs of the same texture are common, so only look it up when it changes
+			if (m_SortMode == SortMode::Texture && command.texture != lastTexture)
+			{
+				lastTexture = command.texture;
+				lastTextureId = m_TextureIds.emplace(command.texture, (uint32_t)m_TextureIds.size()).first->second;
+			}
+
+			m_SortKeys.push_back(makeSortKey(m_SortMode, command.isSortLayerSpecified ? command.sortLayer : 0.0f, lastTextureId, idx));
 		}
+
+		//The submission order is already sorted, so only the top four bytes need to be
+		utils::radixSort(m_SortKeys, m_SortScratch, 4);
 	}
-}
\ No newline at end of file
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "alvere/graphics/sprite.hpp"
@@ -10,7 +12,7 @@
 #include "alvere/math/matrix/matrix_4.hpp"
 #include "alvere/utils/shapes.hpp"
 
-#define ALV_MAX_SPRITEBATCH_SPRITES 100
+#define ALV_SPRITEBATCH_DEFAULT_CAPACITY 65536
 
 namespace alvere
 {
@@ -18,16 +20,35 @@ namespace alvere
 	{
 	public:
 
+		//Sprites with the same key are always drawn in the order they were submitted
 		enum class SortMode
 		{
+			//Submission order
 			Default,
+			//Highest sort layer first
 			FrontToBack,
+			//Lowest sort layer first
 			BackToFront,
+			//Grouped by texture, in the order each texture was first submitted
 			Texture
 		};
 
-		static std::unique_ptr<SpriteBatcher> New();
-		
+		enum class VertexFormat
+		{
+			//Full precision floats for every attribute, 40 bytes per vertex
+			Standard,
+			//2D positions, 16 bit normalised texture coordinates, 8 bit colour and the texture index and layer
+			//packed into one integer, 20 bytes per vertex. Texture coordinates must be within [0, 1], colours are
+			//clamped to [0, 1] and the layer is quantised to 16 bits over [0, 1].
+			Compact,
+			//One 32 byte instance per sprite that the vertex shader expands into a quad, with the same limits as Compact
+			Instanced
+		};
+
+		//The capacity is the most sprites drawn by a single draw call. A batch only has to be split into more
+		//draw calls when it goes over the capacity or uses more textures than can be bound at once.
+		static std::unique_ptr<SpriteBatcher> New(unsigned int capacity = ALV_SPRITEBATCH_DEFAULT_CAPACITY, VertexFormat vertexFormat = VertexFormat::Standard);
+
 		virtual ~SpriteBatcher() = default;
 
 		virtual void begin(const Matrix4& transformationMatrix, SortMode sortMode = SortMode::Default);
@@ -40,12 +61,37 @@ namespace alvere
 
 		void submit(const Texture * texture, Rect destination, RectI source, Vector4 tint = Vector4::unit);
 
+		//Sprites submitted without a sort layer are on layer 0
+		void submit(const Texture * texture, Rect destination, RectI source, Vector4 tint, float sortLayer);
+
 		void submit(const Font::Face::Bitmap & fontFaceBitmap, const std::string & text, Vector2 position, Vector4 colour = Vector4::unit);
 
 		void submit(const Sprite & sprite);
 
+		inline unsigned int getCapacity() const
+		{
+			return m_Capacity;
+		}
+
+		inline VertexFormat getVertexFormat() const
+		{
+			return m_VertexFormat;
+		}
+
+		//The number of draw calls the last batch was split into
+		inline unsigned int getFlushCount() const
+		{
+			return m_FlushCount;
+		}
+
+		//Packs what a sort mode orders by into the top 32 bits and the submission order into the bottom 32 bits.
+		//Keys are made in submission order, so only the top half ever needs sorting.
+		static uint64_t makeSortKey(SortMode sortMode, float sortLayer, uint32_t textureId, uint32_t submissionOrder);
+
 	protected:
 
+		SpriteBatcher(unsigned int capacity, VertexFormat vertexFormat);
+
 		struct DrawSpriteCommand
 		{
 			const Texture * texture;
@@ -60,12 +106,24 @@ namespace alvere
 
 		bool m_HasBegun;
 
+		unsigned int m_Capacity;
+
+		VertexFormat m_VertexFormat;
+
 		unsigned int m_SpriteCount;
 
+		unsigned int m_FlushCount;
+
 		SortMode m_SortMode;
 
 		std::vector<DrawSpriteCommand> m_DrawCommands;
 
+		std::vector<uint64_t> m_SortKeys;
+		std::vector<uint64_t> m_SortScratch;
+
+		//Textures are numbered in the order they are first submitted in each batch
+		std::unordered_map<const Texture *, uint32_t> m_TextureIds;
+
 		const alvere::Matrix4 * m_TransformationMatrix;
 		
 		void SortDrawCommands();
@@ -0,0 +1,147 @@
+#include "alvere/graphics/sprite_vertices.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace alvere
+{
+	static_assert(sizeof(SpriteVertex) == 40, "Must match the standard sprite vertex layout");
+	static_assert(sizeof(CompactSpriteVertex) == 20, "Must match the compact sprite vertex layout");
+	static_assert(sizeof(SpriteInstance) == 32, "Must match the sprite instance layout");
+
+	static uint32_t floatBits(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	//The first field goes at the lower address, as the engine only targets little endian machines
+	static void storePair(char * destination, uint32_t first, uint32_t second)
+	{
+		uint64_t pair = (uint64_t)first | (uint64_t)second << 32;
+		std::memcpy(destination, &pair, sizeof(pair));
+	}
+
+	void SpriteVertex::writeQuad(SpriteVertex * vertices, const Texture & texture, const Rect & destination, const RectI & source, const Vector4 & tint, float layer, int textureIndex)
+	{
+		//Texture coordinates are linear in each axis, so two opposite corners give all four
+		Vector2 bottomLeft = texture.texCoords(source.getBottomLeft());
+		Vector2 topRight = texture.texCoords(source.getTopRight());
+
+		const float x[4] = { destination.getLeft(), destination.getLeft(), destination.getRight(), destination.getRight() };
+		const float y[4] = { destination.getTop(), destination.getBottom(), destination.getTop(), destination.getBottom() };
+		const float u[4] = { bottomLeft.x, bottomLeft.x, topRight.x, topRight.x };
+		const float v[4] = { topRight.y, bottomLeft.y, topRight.y, bottomLeft.y };
+
+		for (int idx = 0; idx < 4; idx++)
+		{
+			SpriteVertex & vertex = vertices[idx];
+			vertex.x = x[idx];
+			vertex.y = y[idx];
+			vertex.z = layer;
+			vertex.u = u[idx];
+			vertex.v = v[idx];
+			vertex.r = tint.x;
+			vertex.g = tint.y;
+			vertex.b = tint.z;
+			vertex.a = tint.w;
+			vertex.textureIndex = textureIndex;
+		}
+	}
+
+	void CompactSpriteVertex::writeQuad(CompactSpriteVertex * vertices, const Texture & texture, const Rect & destination, const RectI & source, const Vector4 & tint, float layer, int textureIndex)
+	{
+		writeQuad(vertices, getTexelScale(texture), destination, source, tint, layer, textureIndex);
+	}
+
+	void CompactSpriteVertex::writeQuad(CompactSpriteVertex * vertices, Vector2 texelScale, const Rect & destination, const RectI & source, const Vector4 & tint, float layer, int textureIndex)
+	{
+		uint32_t left = packTexel16(source.m_x, texelScale.x);
+		uint32_t right = packTexel16(source.m_x + source.m_width, texelScale.x);
+		uint32_t bottom = packTexel16(source.m_y, texelScale.y);
+		uint32_t top = packTexel16(source.m_y + source.m_height, texelScale.y);
+
+		uint32_t x0 = floatBits(destination.m_x);
+		uint32_t x1 = floatBits(destination.m_x + destination.m_width);
+		uint32_t y0 = floatBits(destination.m_y);
+		uint32_t y1 = floatBits(destination.m_y + destination.m_height);
+
+		uint32_t colour = packColour(tint);
+		uint32_t textureIndexAndLayer = packTextureIndexAndLayer(textureIndex, layer);
+
+		//Four 20 byte vertices are ten 8 byte words, so they are written a pair of fields at a time.
+		//Fields are x, y, uv, colour, texture index and layer, with the corners in the usual order.
+		char * out = (char *)vertices;
+		storePair(out + 0, x0, y1);
+		storePair(out + 8, left | top << 16, colour);
+		storePair(out + 16, textureIndexAndLayer, x0);
+		storePair(out + 24, y0, left | bottom << 16);
+		storePair(out + 32, colour, textureIndexAndLayer);
+		storePair(out + 40, x1, y1);
+		storePair(out + 48, right | top << 16, colour);
+		storePair(out + 56, textureIndexAndLayer, x1);
+		storePair(out + 64, y0, right | bottom << 16);
+		storePair(out + 72, colour, textureIndexAndLayer);
+	}
+
+	void SpriteInstance::write(SpriteInstance & instance, const Texture & texture, const Rect & destination, const RectI & source, const Vector4 & tint, float layer, int textureIndex)
+	{
+		write(instance, getTexelScale(texture), destination, source, tint, layer, textureIndex);
+	}
+
+	void SpriteInstance::write(SpriteInstance & instance, Vector2 texelScale, const Rect & destination, const RectI & source, const Vector4 & tint, float layer, int textureIndex)
+	{
+		//The shader interpolates between the bottom left and top right, which covers mirrored sources too
+		instance.x = destination.m_x;
+		instance.y = destination.m_y;
+		instance.width = destination.m_width;
+		instance.height = destination.m_height;
+		instance.u0 = packTexel16(source.m_x, texelScale.x);
+		instance.v0 = packTexel16(source.m_y, texelScale.y);
+		instance.u1 = packTexel16(source.m_x + source.m_width, texelScale.x);
+		instance.v1 = packTexel16(source.m_y + source.m_height, texelScale.y);
+		instance.colour = packColour(tint);
+		instance.textureIndexAndLayer = packTextureIndexAndLayer(textureIndex, layer);
+	}
+
+	Vector2 getTexelScale(const Texture & texture)
+	{
+		Vec2i dimensions = texture.getDimensions();
+		return Vector2(65535.0f / dimensions.x, 65535.0f / dimensions.y);
+	}
+
+	uint32_t packUnorm16(float value)
+	{
+		return (uint32_t)(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+	}
+
+	uint16_t packTexel16(int texel, float scale)
+	{
+		return (uint16_t)std::clamp(texel * scale + 0.5f, 0.0f, 65535.0f);
+	}
+
+	uint32_t packColour(const Vector4 & colour)
+	{
+		//Most sprites aren't tinted
+		if (colour.x == 1.0f && colour.y == 1.0f && colour.z == 1.0f && colour.w == 1.0f)
+		{
+			return 0xFFFFFFFF;
+		}
+
+		return (uint32_t)(std::clamp(colour.x, 0.0f, 1.0f) * 255.0f + 0.5f)
+			| (uint32_t)(std::clamp(colour.y, 0.0f, 1.0f) * 255.0f + 0.5f) << 8
+			| (uint32_t)(std::clamp(colour.z, 0.0f, 1.0f) * 255.0f + 0.5f) << 16
+			| (uint32_t)(std::clamp(colour.w, 0.0f, 1.0f) * 255.0f + 0.5f) << 24;
+	}
+
+	Vector4 premultiplyTint(const Vector4 & tint)
+	{
+		return Vector4(tint.x * tint.w, tint.y * tint.w, tint.z * tint.w, tint.w);
+	}
+
+	uint32_t packTextureIndexAndLayer(int textureIndex, float layer)
+	{
+		return ((uint32_t)textureIndex & 0xFF) | (packUnorm16(layer) << 16);
+	}
+}
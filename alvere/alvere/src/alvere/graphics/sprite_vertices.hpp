@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+#include "alvere/graphics/texture.hpp"
+#include "alvere/math/vector/vector_4.hpp"
+#include "alvere/utils/shapes.hpp"
+
+namespace alvere
+{
+	//The data written for each sprite in each of the SpriteBatcher's vertex formats.
+	//Corners are written top left, bottom left, top right, bottom right.
+
+	//Full precision, four per sprite
+	struct SpriteVertex
+	{
+		float x, y, z;
+		float u, v;
+		float r, g, b, a;
+		int textureIndex;
+
+		static void writeQuad(SpriteVertex * vertices, const Texture & texture, const Rect & destination, const RectI & source, const Vector4 & tint, float layer, int textureIndex);
+	};
+
+	//Packed texture coordinates, colour, texture index and layer, four per sprite
+	struct CompactSpriteVertex
+	{
+		float x, y;
+		uint16_t u, v;
+		uint32_t colour;
+		uint32_t textureIndexAndLayer;
+
+		static void writeQuad(CompactSpriteVertex * vertices, const Texture & texture, const Rect & destination, const RectI & source, const Vector4 & tint, float layer, int textureIndex);
+
+		//Takes the texture's getTexelScale, so a batcher can work it out once per texture rather than once per sprite
+		static void writeQuad(CompactSpriteVertex * vertices, Vector2 texelScale, const Rect & destination, const RectI & source, const Vector4 & tint, float layer, int textureIndex);
+	};
+
+	//One per sprite, expanded into a quad by the vertex shader
+	struct SpriteInstance
+	{
+		float x, y, width, height;
+		uint16_t u0, v0, u1, v1;
+		uint32_t colour;
+		uint32_t textureIndexAndLayer;
+
+		static void write(SpriteInstance & instance, const Texture & texture, const Rect & destination, const RectI & source, const Vector4 & tint, float layer, int textureIndex);
+
+		static void write(SpriteInstance & instance, Vector2 texelScale, const Rect & destination, const RectI & source, const Vector4 & tint, float layer, int textureIndex);
+	};
+
+	//Clamps to [0, 1] and scales to the full range of 16 bits
+	uint32_t packUnorm16(float value);
+
+	//65535 over the texture's width and height, which turns texel coordinates into 16 bit texture coordinates
+	Vector2 getTexelScale(const Texture & texture);
+
+	//Scales a texel coordinate by one axis of getTexelScale, clamped to the range of 16 bits
+	uint16_t packTexel16(int texel, float scale);
+
+	//Packs into RGBA8, so the bytes in memory are read as r, g, b, a
+	uint32_t packColour(const Vector4 & colour);
+
+	//The tint to draw a premultiplied texture with, so it comes out the same as the straight tint does on a straight texture
+	Vector4 premultiplyTint(const Vector4 & tint);
+
+	//The texture index in the low byte and the layer in the top 16 bits
+	uint32_t packTextureIndexAndLayer(int textureIndex, float layer);
+}
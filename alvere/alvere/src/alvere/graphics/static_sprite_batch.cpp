@@ -0,0 +1,38 @@
+#include "alvere/graphics/static_sprite_batch.hpp"
+
+#include "alvere/debug/exceptions.hpp"
+
+namespace alvere
+{
+	StaticSpriteBatch::StaticSpriteBatch()
+		: m_HasBegun(false), m_SpriteCount(0)
+	{
+	}
+
+	void StaticSpriteBatch::begin()
+	{
+		AlvAssert(!m_HasBegun, "StaticSpriteBatch.begin() cannot be called before the current batch has ended.");
+
+		m_HasBegun = true;
+		m_Sprites.clear();
+	}
+
+	void StaticSpriteBatch::end()
+	{
+		AlvAssert(m_HasBegun, "StaticSpriteBatch.end() cannot be called before begin().");
+
+		upload(m_Sprites);
+		m_SpriteCount = (unsigned int)m_Sprites.size();
+
+		//Everything lives on the GPU now, there's no need to hold onto a copy
+		m_Sprites.clear();
+		m_Sprites.shrink_to_fit();
+
+		m_HasBegun = false;
+	}
+
+	void StaticSpriteBatch::submit(const Texture * texture, Rect destination, RectI source, Vector4 tint)
+	{
+		m_Sprites.push_back({ texture, destination, source, tint });
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "alvere/graphics/texture.hpp"
+#include "alvere/math/vector/vector_4.hpp"
+#include "alvere/math/matrix/matrix_4.hpp"
+#include "alvere/utils/shapes.hpp"
+
+namespace alvere
+{
+	//Sprites that are built once and kept on the GPU, so drawing them again costs no per-sprite work.
+	//Meant for things that rarely change, like chunks of a tilemap. Sprites are drawn in the order they were submitted.
+	class StaticSpriteBatch
+	{
+	public:
+
+		static std::unique_ptr<StaticSpriteBatch> New();
+
+		virtual ~StaticSpriteBatch() = default;
+
+		//Starts building a new set of sprites to replace the current one
+		void begin();
+
+		//Uploads the sprites submitted since begin()
+		void end();
+
+		void submit(const Texture * texture, Rect destination, RectI source, Vector4 tint = Vector4::unit);
+
+		virtual void draw(const Matrix4 & transformationMatrix) = 0;
+
+		unsigned int getSpriteCount() const { return m_SpriteCount; }
+
+		virtual unsigned int getDrawCallCount() const = 0;
+
+	protected:
+
+		struct StaticSprite
+		{
+			const Texture * texture;
+			Rect destination;
+			RectI source;
+			Vector4 tint;
+		};
+
+		StaticSpriteBatch();
+
+		bool m_HasBegun;
+
+		unsigned int m_SpriteCount;
+
+		std::vector<StaticSprite> m_Sprites;
+
+		virtual void upload(const std::vector<StaticSprite> & sprites) = 0;
+	};
+}
@@ -1,15 +1,22 @@
 #include "alvere/graphics/texture.hpp"
 
+#include <cstring>
+#include <utility>
+
 #define STB_IMAGE_IMPLEMENTATION
 #define STBI_FAILURE_USERIMG
 #include <stb/image.hpp>
 
 #include "alvere/debug/logging.hpp"
+#include "alvere/graphics/texture_loader.hpp"
 
 namespace alvere
 {
 	Texture::~Texture()
 	{
+		if (m_loading)
+			TextureLoader::get().cancel(*this);
+
 		stbi_image_free(m_pixelData);
 	}
 
@@ -33,6 +40,37 @@ namespace alvere
 		return RectI{ 0, 0, m_dimensions.x, m_dimensions.y };
 	}
 
+	bool Texture::restorePixelData() const
+	{
+		//A placeholder's pixels are still on their way, rather than released
+		if (m_loading)
+			TextureLoader::get().finish(*this);
+
+		if (m_pixelData == nullptr)
+			m_pixelData = readPixelData();
+
+		return m_pixelData != nullptr;
+	}
+
+	void Texture::releasePixelData() const
+	{
+		if (m_keepPixelData == false)
+		{
+			stbi_image_free(m_pixelData);
+			m_pixelData = nullptr;
+		}
+	}
+
+	bool Texture::isLoading() const
+	{
+		return m_loading;
+	}
+
+	bool Texture::isPremultiplied() const
+	{
+		return m_premultiplied;
+	}
+
 	alvere::Vector2 Texture::texCoords(const alvere::Vector2i& texPosition) const
 	{
 		return alvere::Vector2 {
@@ -41,22 +79,23 @@ namespace alvere
 		};
 	}
 
-	Texture::Texture(const char * filename, Channels channels)
+	Texture::Texture(const char * filename, Channels channels, bool keepPixelData)
+		: m_dimensions(0, 0), m_channelCount((int)channels), m_pixelData(nullptr), m_loading(false), m_keepPixelData(keepPixelData), m_premultiplied(false), m_mipChain{}
 	{
 #ifdef ALV_GRAPHICS_API_OPENGL
 		stbi_set_flip_vertically_on_load(true);
 #endif
 
-		m_pixelData = stbi_load(filename, &m_dimensions.x, &m_dimensions.y, &m_channelCount, (int)channels);
-
-		if (m_pixelData == nullptr)
+		//The backend uploads from the mapped cache once it's constructed
+		if (texture_cache::open(filename, m_channelCount, m_cacheFile, m_mipChain, m_pixelData, m_dimensions))
 		{
-			LogError("Failed to load image '%s': %s\n", filename, stbi_failure_reason());
+			m_dimensions = m_mipChain.m_dimensions;
+			m_premultiplied = m_mipChain.m_premultiplied;
 		}
 	}
 
 	Texture::Texture(const unsigned char * data, int width, int height, Channels channels)
-		: m_dimensions(width, height), m_channelCount((int)channels)
+		: m_dimensions(width, height), m_channelCount((int)channels), m_loading(false), m_keepPixelData(true), m_premultiplied(false), m_mipChain{}
 	{
 		m_pixelData = (unsigned char *)std::malloc((size_t)m_dimensions.x * m_dimensions.y * m_channelCount);
 
@@ -72,8 +111,12 @@ namespace alvere
 	}
 
 	Texture::Texture(const Texture & sourceTexture, alvere::RectI sourceRect)
-		: m_dimensions(sourceRect.m_width, sourceRect.m_height), m_channelCount(sourceTexture.m_channelCount)
+		: m_dimensions(sourceRect.m_width, sourceRect.m_height), m_channelCount(sourceTexture.m_channelCount), m_loading(false)
+		, m_keepPixelData(true), m_premultiplied(sourceTexture.m_premultiplied), m_mipChain{}
 	{
+		//The pixels are copied from the source, so it can't still be a placeholder or have released them
+		sourceTexture.restorePixelData();
+
 		m_pixelData = (unsigned char *) std::malloc((size_t)m_dimensions.x * m_dimensions.y * m_channelCount);
 
 		if (m_pixelData == nullptr)
@@ -100,7 +143,7 @@ namespace alvere
 	}
 
 	Texture::Texture(int width, int height, Channels channels)
-		: m_dimensions(width, height), m_channelCount((int)channels)
+		: m_dimensions(width, height), m_channelCount((int)channels), m_loading(false), m_keepPixelData(true), m_premultiplied(false), m_mipChain{}
 	{
 		m_pixelData = (unsigned char *)std::calloc(m_dimensions.x * m_dimensions.y, m_channelCount);
 
@@ -109,4 +152,57 @@ namespace alvere
 			m_dimensions.x = m_dimensions.y = m_channelCount = 0;
 		}
 	}
+
+	Texture::Texture(Placeholder placeholder, int width, int height, Channels channels, bool keepPixelData)
+		: m_dimensions(width, height), m_channelCount((int)channels), m_pixelData(nullptr), m_loading(true), m_keepPixelData(keepPixelData), m_premultiplied(false), m_mipChain{}
+	{ }
+
+	void Texture::upload()
+	{
+		//Only the largest level is kept, since that's all the CPU side of a texture has ever held
+		if (m_keepPixelData && m_pixelData == nullptr && m_mipChain.m_levelCount > 0)
+		{
+			std::size_t size = (std::size_t)m_dimensions.x * m_dimensions.y * m_channelCount;
+			m_pixelData = (unsigned char *)std::malloc(size);
+
+			if (m_pixelData != nullptr)
+				std::memcpy(m_pixelData, m_mipChain.m_levels[0], size);
+		}
+
+		uploadPixelData();
+
+		m_mipChain.m_levelCount = 0;
+		m_cacheFile.close();
+
+		if (m_keepPixelData == false)
+		{
+			stbi_image_free(m_pixelData);
+			m_pixelData = nullptr;
+		}
+	}
+
+	void Texture::setPixelData(unsigned char * pixelData, Vec2i dimensions)
+	{
+		stbi_image_free(m_pixelData);
+
+		m_pixelData = pixelData;
+		m_loading = false;
+
+		//A failed decode leaves the placeholder with nothing to show
+		if (m_pixelData != nullptr)
+			m_dimensions = dimensions;
+
+		upload();
+	}
+
+	void Texture::setMipChain(MappedFile && cacheFile, const texture_cache::MipChain & mipChain)
+	{
+		m_cacheFile = std::move(cacheFile);
+		m_mipChain = mipChain;
+		m_dimensions = mipChain.m_dimensions;
+		m_premultiplied = mipChain.m_premultiplied;
+		m_loading = false;
+
+		upload();
+	}
 }
\ No newline at end of file
@@ -3,11 +3,18 @@
 #include <memory>
 #include <string>
 
+#include "alvere/graphics/texture_cache.hpp"
 #include "alvere/math/vector/vec_2_i.hpp"
+#include "alvere/utils/mapped_file.hpp"
 #include "alvere/utils/shapes.hpp"
 
+//What a placeholder draws as until its pixels are uploaded, one byte per channel
+#define ALV_TEXTURE_PLACEHOLDER_COLOUR { 0, 0, 0, 0 }
+
 namespace alvere
 {
+	class TextureLoader;
+
 	class Texture
 	{
 	public:
@@ -19,7 +26,13 @@ namespace alvere
 			RGBAlpha = 4
 		};
 
-		static std::unique_ptr<Texture> New(const char * filename, Channels channels = Channels::RGBAlpha);
+		//Makes a texture that reports its full size but has no pixels, and is only a single texel of
+		//ALV_TEXTURE_PLACEHOLDER_COLOUR on the GPU until the texture loader gives it its pixels
+		struct Placeholder { };
+
+		//Loads from the file's texture cache, cooking it first if it's missing or stale. The pixels are only kept on the
+		//CPU once uploaded if keepPixelData is set.
+		static std::unique_ptr<Texture> New(const char * filename, Channels channels = Channels::RGBAlpha, bool keepPixelData = false);
 
 		static std::unique_ptr<Texture> New(const unsigned char * data, int width, int height, Channels channels = Channels::RGBAlpha);
 
@@ -27,6 +40,10 @@ namespace alvere
 
 		static std::unique_ptr<Texture> New(const Texture & sourceTexture, alvere::RectI sourceRect);
 
+		static std::unique_ptr<Texture> New(Placeholder placeholder, int width, int height, Channels channels = Channels::RGBAlpha, bool keepPixelData = false);
+
+		//Returns a placeholder straight away and decodes the file on the texture loader's threads. Returns nullptr if
+		//the file isn't an image that can be read.
 		static Texture * loadFromFile(const std::string & filepath);
 
 		virtual ~Texture();
@@ -35,10 +52,24 @@ namespace alvere
 
 		int channelCount() const;
 
+		//The CPU copy of the pixels, or nullptr if it was released once uploaded
 		unsigned char * pixelData() const;
 
+		//Reads released pixels back from the GPU, after which they're kept. It waits on the GPU, so it's for one off
+		//copies and tools rather than anything done every frame. Returns false if there are no pixels to get back.
+		bool restorePixelData() const;
+
+		//Frees pixels brought back by restorePixelData once they're no longer needed, unless the texture keeps its pixels
+		void releasePixelData() const;
+
 		RectI getBounds() const;
 
+		//Whether the texture is still a placeholder waiting on the texture loader
+		bool isLoading() const;
+
+		//Whether the colour channels were multiplied by alpha when the texture was cooked
+		bool isPremultiplied() const;
+
 		alvere::Vector2 texCoords(const alvere::Vector2i& texPosition) const;
 
 		virtual void bind() const = 0;
@@ -55,14 +86,48 @@ namespace alvere
 
 		int m_channelCount;
 
-		unsigned char * m_pixelData;
+		//Restoring released pixels doesn't change what the texture is, so it can be done through a const texture
+		mutable unsigned char * m_pixelData;
+
+		bool m_loading;
+
+		bool m_keepPixelData;
+
+		bool m_premultiplied;
 
-		Texture(const char * filename, Channels channels = Channels::RGBAlpha);
+		//Only open between a texture's cache being found and uploaded. While it is, the backend uploads every level
+		//from m_mipChain instead of generating them from m_pixelData.
+		MappedFile m_cacheFile;
+
+		texture_cache::MipChain m_mipChain;
+
+		Texture(const char * filename, Channels channels = Channels::RGBAlpha, bool keepPixelData = false);
 
 		Texture(const unsigned char * data, int width, int height, Channels channels = Channels::RGBAlpha);
 
 		Texture(int width, int height, Channels = Channels::RGBAlpha);
 
 		Texture(const Texture & sourceTexture, alvere::RectI sourceRect);
+
+		Texture(Placeholder placeholder, int width, int height, Channels channels = Channels::RGBAlpha, bool keepPixelData = false);
+
+		//Uploads the pixels, then releases them and the cache unless they're to be kept
+		void upload();
+
+		//Uploads m_mipChain or m_pixelData, or the placeholder texel if there are neither
+		virtual void uploadPixelData() = 0;
+
+		//Returns the largest level in memory from std::malloc, or nullptr
+		virtual unsigned char * readPixelData() const = 0;
+
+	private:
+
+		friend TextureLoader;
+
+		//Takes ownership of pixels from stb_image, which replace the placeholder, and uploads them
+		void setPixelData(unsigned char * pixelData, Vec2i dimensions);
+
+		//Takes the texture's mapped cache, which replaces the placeholder, and uploads it
+		void setMipChain(MappedFile && cacheFile, const texture_cache::MipChain & mipChain);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,302 @@
+#include "alvere/graphics/texture_atlas.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include "alvere/debug/exceptions.hpp"
+#include "alvere/debug/logging.hpp"
+
+namespace alvere
+{
+	//Pages only need to be as large as what was packed into them
+	static int roundUpToPowerOfTwo(int value)
+	{
+		int result = 1;
+		while (result < value)
+		{
+			result <<= 1;
+		}
+		return result;
+	}
+
+	TextureAtlas::TextureAtlas(int pageWidth, int pageHeight, int padding)
+		: m_pageWidth(pageWidth), m_pageHeight(pageHeight), m_padding(padding)
+	{
+		AlvAssert(pageWidth > 0 && pageHeight > 0, "Texture atlas pages must have a size");
+		AlvAssert(padding >= 0, "Texture atlas padding cannot be negative");
+	}
+
+	void TextureAtlas::add(const Texture & texture)
+	{
+		if (std::find(m_textures.begin(), m_textures.end(), &texture) == m_textures.end())
+		{
+			m_textures.push_back(&texture);
+		}
+	}
+
+	bool TextureAtlas::build()
+	{
+		m_regions.clear();
+		m_pages.clear();
+
+		//Placeholders and textures loaded from files don't have their pixels on the CPU to pack
+		for (const Texture * texture : m_textures)
+		{
+			texture->restorePixelData();
+		}
+
+		//Packing the tallest first keeps the skyline flat, which wastes the least space
+		std::vector<const Texture *> order = m_textures;
+		std::stable_sort(order.begin(), order.end(), [](const Texture * lhs, const Texture * rhs)
+		{
+			Vec2i lhsDimensions = lhs->getDimensions();
+			Vec2i rhsDimensions = rhs->getDimensions();
+			return lhsDimensions.y != rhsDimensions.y
+				? lhsDimensions.y > rhsDimensions.y
+				: lhsDimensions.x > rhsDimensions.x;
+		});
+
+		struct Placement
+		{
+			const Texture * m_texture;
+			std::size_t m_page;
+			Vec2i m_position;
+		};
+
+		std::vector<Page> pages;
+		std::vector<Placement> placements;
+		bool packedAll = true;
+
+		for (const Texture * texture : order)
+		{
+			Vec2i dimensions = texture->getDimensions();
+			if (dimensions.x <= 0 || dimensions.y <= 0 || texture->pixelData() == nullptr)
+			{
+				continue;
+			}
+
+			int width = dimensions.x + m_padding * 2;
+			int height = dimensions.y + m_padding * 2;
+
+			if (width > m_pageWidth || height > m_pageHeight)
+			{
+				LogWarning("[TextureAtlas] A %dx%d texture does not fit in a %dx%d page\n", dimensions.x, dimensions.y, m_pageWidth, m_pageHeight);
+				packedAll = false;
+				continue;
+			}
+
+			Vec2i position;
+			std::size_t pageIndex = 0;
+			while (pageIndex < pages.size() && insert(pages[pageIndex], width, height, position) == false)
+			{
+				++pageIndex;
+			}
+
+			if (pageIndex == pages.size())
+			{
+				Page & page = pages.emplace_back();
+				page.m_skyline.push_back(SkylineNode{ 0, 0, m_pageWidth });
+				page.m_pixels.resize((std::size_t)m_pageWidth * m_pageHeight * 4);
+				page.m_used = Vec2i(0, 0);
+
+				insert(page, width, height, position);
+			}
+
+			position = Vec2i(position.x + m_padding, position.y + m_padding);
+			blit(pages[pageIndex], *texture, position);
+
+			placements.push_back(Placement{ texture, pageIndex, position });
+		}
+
+		for (Page & page : pages)
+		{
+			int width = std::min(m_pageWidth, roundUpToPowerOfTwo(page.m_used.x));
+			int height = std::min(m_pageHeight, roundUpToPowerOfTwo(page.m_used.y));
+
+			//Rows are stored a whole page wide, so trimming them means packing the rows together
+			std::vector<unsigned char> pixels((std::size_t)width * height * 4);
+			for (int y = 0; y < height; ++y)
+			{
+				std::memcpy(&pixels[(std::size_t)y * width * 4], &page.m_pixels[(std::size_t)y * m_pageWidth * 4], (std::size_t)width * 4);
+			}
+
+			m_pages.push_back(Texture::New(pixels.data(), width, height, Texture::Channels::RGBAlpha));
+		}
+
+		for (const Placement & placement : placements)
+		{
+			Vec2i dimensions = placement.m_texture->getDimensions();
+			m_regions[placement.m_texture] = Region{ m_pages[placement.m_page].get(), RectI(placement.m_position.x, placement.m_position.y, dimensions.x, dimensions.y) };
+		}
+
+		//Everything has been copied into the pages, so the sources can go back to only being on the GPU
+		for (const Texture * texture : m_textures)
+		{
+			texture->releasePixelData();
+		}
+
+		return packedAll;
+	}
+
+	void TextureAtlas::clear()
+	{
+		m_textures.clear();
+		m_regions.clear();
+		m_pages.clear();
+	}
+
+	bool TextureAtlas::contains(const Texture & texture) const
+	{
+		return m_regions.find(&texture) != m_regions.end();
+	}
+
+	TextureAtlas::Region TextureAtlas::remap(const Texture & texture, const RectI & source) const
+	{
+		auto iter = m_regions.find(&texture);
+		if (iter == m_regions.end())
+		{
+			return Region{ &texture, source };
+		}
+
+		const RectI & packed = iter->second.m_source;
+		return Region{ iter->second.m_texture, RectI(packed.m_x + source.m_x, packed.m_y + source.m_y, source.m_width, source.m_height) };
+	}
+
+	void TextureAtlas::remap(Sprite & sprite) const
+	{
+		Region region = remap(sprite.getTexture(), sprite.textureSource());
+		sprite.setTexture(*region.m_texture);
+		sprite.textureSource() = region.m_source;
+	}
+
+	bool TextureAtlas::insert(Page & page, int width, int height, Vec2i & position) const
+	{
+		//Bottom left: the lowest spot the rect fits, then the furthest left
+		int bestY = INT_MAX;
+		std::size_t bestIndex = page.m_skyline.size();
+
+		for (std::size_t i = 0; i < page.m_skyline.size(); ++i)
+		{
+			int y = fit(page, i, width, height);
+			if (y >= 0 && y < bestY)
+			{
+				bestY = y;
+				bestIndex = i;
+			}
+		}
+
+		if (bestIndex == page.m_skyline.size())
+		{
+			return false;
+		}
+
+		std::vector<SkylineNode> & skyline = page.m_skyline;
+		position = Vec2i(skyline[bestIndex].m_x, bestY);
+
+		skyline.insert(skyline.begin() + bestIndex, SkylineNode{ position.x, bestY + height, width });
+
+		//Cut the nodes that are now underneath the new one
+		for (std::size_t i = bestIndex + 1; i < skyline.size();)
+		{
+			int previousRight = skyline[i - 1].m_x + skyline[i - 1].m_width;
+			if (skyline[i].m_x >= previousRight)
+			{
+				break;
+			}
+
+			int overlap = previousRight - skyline[i].m_x;
+			skyline[i].m_x += overlap;
+			skyline[i].m_width -= overlap;
+
+			if (skyline[i].m_width > 0)
+			{
+				break;
+			}
+
+			skyline.erase(skyline.begin() + i);
+		}
+
+		for (std::size_t i = 0; i + 1 < skyline.size();)
+		{
+			if (skyline[i].m_y == skyline[i + 1].m_y)
+			{
+				skyline[i].m_width += skyline[i + 1].m_width;
+				skyline.erase(skyline.begin() + i + 1);
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		page.m_used = Vec2i(std::max(page.m_used.x, position.x + width), std::max(page.m_used.y, position.y + height));
+
+		return true;
+	}
+
+	int TextureAtlas::fit(const Page & page, std::size_t nodeIndex, int width, int height) const
+	{
+		const std::vector<SkylineNode> & skyline = page.m_skyline;
+
+		if (skyline[nodeIndex].m_x + width > m_pageWidth)
+		{
+			return -1;
+		}
+
+		//The rect rests on the highest node it spans. The nodes always cover the whole width of the page.
+		int y = 0;
+		int remaining = width;
+		for (std::size_t i = nodeIndex; remaining > 0; ++i)
+		{
+			y = std::max(y, skyline[i].m_y);
+			if (y + height > m_pageHeight)
+			{
+				return -1;
+			}
+
+			remaining -= skyline[i].m_width;
+		}
+
+		return y;
+	}
+
+	void TextureAtlas::blit(Page & page, const Texture & texture, Vec2i position) const
+	{
+		Vec2i dimensions = texture.getDimensions();
+		int channels = texture.channelCount();
+		const unsigned char * source = texture.pixelData();
+
+		//Every page is RGBA, so fewer channels are widened. Grey is treated as an opaque colour rather than coverage.
+		for (int y = -m_padding; y < dimensions.y + m_padding; ++y)
+		{
+			int sourceY = std::clamp(y, 0, dimensions.y - 1);
+			unsigned char * destination = &page.m_pixels[((std::size_t)(position.y + y) * m_pageWidth + position.x - m_padding) * 4];
+
+			for (int x = -m_padding; x < dimensions.x + m_padding; ++x, destination += 4)
+			{
+				int sourceX = std::clamp(x, 0, dimensions.x - 1);
+				const unsigned char * pixel = source + ((std::size_t)sourceY * dimensions.x + sourceX) * channels;
+
+				switch (channels)
+				{
+				case 1:
+					destination[0] = destination[1] = destination[2] = pixel[0];
+					destination[3] = 255;
+					break;
+				case 2:
+					destination[0] = destination[1] = destination[2] = pixel[0];
+					destination[3] = pixel[1];
+					break;
+				case 3:
+					std::memcpy(destination, pixel, 3);
+					destination[3] = 255;
+					break;
+				default:
+					std::memcpy(destination, pixel, 4);
+					break;
+				}
+			}
+		}
+	}
+}
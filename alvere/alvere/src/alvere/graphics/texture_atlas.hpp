@@ -0,0 +1,82 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "alvere/graphics/sprite.hpp"
+#include "alvere/graphics/texture.hpp"
+#include "alvere/utils/shapes.hpp"
+
+namespace alvere
+{
+	//Packs the pixels of many textures into a few large pages, so sprites drawn from any of them share a texture.
+	//Textures are added, then packed together by build() with a skyline packer, tallest first.
+	//Sources that released their pixels have them read back from the GPU for the build and freed again after.
+	//Each packed image is surrounded by padding filled with its edge pixels, so filtering never picks up a neighbour.
+	class TextureAtlas
+	{
+	public:
+
+		//Where a texture, or part of one, ended up
+		struct Region
+		{
+			const Texture * m_texture;
+			RectI m_source;
+		};
+
+		TextureAtlas(int pageWidth = 2048, int pageHeight = 2048, int padding = 1);
+
+		//Adding the same texture more than once has no effect
+		void add(const Texture & texture);
+
+		//Packs every texture added so far into new pages. Pages from a previous build are destroyed.
+		//Returns false if a texture was larger than a page, in which case it is left out.
+		bool build();
+
+		void clear();
+
+		bool contains(const Texture & texture) const;
+
+		//Where a rect of a packed texture is in the atlas. Textures that were not packed are returned unchanged.
+		Region remap(const Texture & texture, const RectI & source) const;
+
+		//Points the sprite at the page its texture was packed into
+		void remap(Sprite & sprite) const;
+
+		std::size_t getPageCount() const { return m_pages.size(); }
+
+		const Texture & getPage(std::size_t index) const { return *m_pages[index]; }
+
+	private:
+
+		struct SkylineNode
+		{
+			int m_x;
+			int m_y;
+			int m_width;
+		};
+
+		struct Page
+		{
+			std::vector<SkylineNode> m_skyline;
+			std::vector<unsigned char> m_pixels;
+			Vec2i m_used;
+		};
+
+		int m_pageWidth;
+		int m_pageHeight;
+		int m_padding;
+
+		std::vector<const Texture *> m_textures;
+		std::unordered_map<const Texture *, Region> m_regions;
+		std::vector<std::unique_ptr<Texture>> m_pages;
+
+		bool insert(Page & page, int width, int height, Vec2i & position) const;
+
+		//Returns the height the skyline would be at, or -1 if the rect doesn't fit there
+		int fit(const Page & page, std::size_t nodeIndex, int width, int height) const;
+
+		void blit(Page & page, const Texture & texture, Vec2i position) const;
+	};
+}
@@ -0,0 +1,278 @@
+#include "alvere/graphics/texture_cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <stb/image.hpp>
+
+#include "alvere/debug/logging.hpp"
+
+namespace alvere::texture_cache
+{
+	static const char s_magic[4] = { 'A', 'T', 'E', 'X' };
+
+	//Different threads can cook the same source at once, so each write gets its own temporary file to rename from
+	static std::string getTemporaryPath(const std::string & cachePath)
+	{
+		static std::atomic<uint32_t> s_writeCount = 0;
+
+		std::size_t threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+		return cachePath + "." + std::to_string(threadId) + "." + std::to_string(s_writeCount++) + ".tmp";
+	}
+
+	static uint64_t alignOffset(uint64_t offset)
+	{
+		return (offset + ALV_TEXTURE_CACHE_ALIGNMENT - 1) & ~(uint64_t)(ALV_TEXTURE_CACHE_ALIGNMENT - 1);
+	}
+
+	static std::size_t getLevelSize(Vec2i dimensions, uint32_t level, int channelCount)
+	{
+		Vec2i levelDimensions = getLevelDimensions(dimensions, level);
+		return (std::size_t)levelDimensions.x * levelDimensions.y * channelCount;
+	}
+
+	uint32_t getLevelCount(Vec2i dimensions)
+	{
+		uint32_t levelCount = 1;
+		for (int size = std::max(dimensions.x, dimensions.y); size > 1; size >>= 1)
+			++levelCount;
+
+		return std::min<uint32_t>(levelCount, ALV_TEXTURE_CACHE_MAX_LEVELS);
+	}
+
+	Vec2i getLevelDimensions(Vec2i dimensions, uint32_t level)
+	{
+		return Vec2i(std::max(dimensions.x >> level, 1), std::max(dimensions.y >> level, 1));
+	}
+
+	void premultiplyAlpha(unsigned char * pixels, std::size_t texelCount, int channelCount)
+	{
+		if (channelCount != 2 && channelCount != 4)
+			return;
+
+		for (std::size_t texel = 0; texel < texelCount; ++texel)
+		{
+			unsigned char * channels = pixels + texel * channelCount;
+			unsigned int alpha = channels[channelCount - 1];
+
+			//Rounded division by 255
+			for (int channel = 0; channel < channelCount - 1; ++channel)
+			{
+				unsigned int value = channels[channel] * alpha + 128;
+				channels[channel] = (unsigned char)((value + (value >> 8)) >> 8);
+			}
+		}
+	}
+
+	void downsample(const unsigned char * source, Vec2i sourceDimensions, int channelCount, unsigned char * destination)
+	{
+		Vec2i dimensions = getLevelDimensions(sourceDimensions, 1);
+		const std::size_t sourceStride = (std::size_t)sourceDimensions.x * channelCount;
+
+		for (int y = 0; y < dimensions.y; ++y)
+		{
+			//A source one texel tall or wide averages the texel with itself
+			const unsigned char * row0 = source + std::min(y * 2, sourceDimensions.y - 1) * sourceStride;
+			const unsigned char * row1 = source + std::min(y * 2 + 1, sourceDimensions.y - 1) * sourceStride;
+			unsigned char * output = destination + (std::size_t)y * dimensions.x * channelCount;
+
+			//Kept to plain loops over bytes with no branches inside, so the compiler can vectorise them
+			for (int x = 0; x < dimensions.x; ++x)
+			{
+				std::size_t left = (std::size_t)std::min(x * 2, sourceDimensions.x - 1) * channelCount;
+				std::size_t right = (std::size_t)std::min(x * 2 + 1, sourceDimensions.x - 1) * channelCount;
+
+				for (int channel = 0; channel < channelCount; ++channel)
+				{
+					unsigned int sum = row0[left + channel] + row0[right + channel] + row1[left + channel] + row1[right + channel];
+					output[x * channelCount + channel] = (unsigned char)((sum + 2) >> 2);
+				}
+			}
+		}
+	}
+
+	std::string getCachePath(const std::string & sourcePath)
+	{
+		return sourcePath + ALV_TEXTURE_CACHE_EXTENSION;
+	}
+
+	bool isUpToDate(const std::string & sourcePath, const std::string & cachePath)
+	{
+		std::error_code error;
+
+		std::filesystem::file_time_type cacheTime = std::filesystem::last_write_time(cachePath, error);
+		if (error)
+			return false;
+
+		//A cache with no source left to make it from is still the best there is
+		std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(sourcePath, error);
+		return error || cacheTime >= sourceTime;
+	}
+
+	bool write(const std::string & cachePath, const unsigned char * pixels, Vec2i dimensions, int channelCount, bool premultiply)
+	{
+		if (pixels == nullptr || dimensions.x <= 0 || dimensions.y <= 0 || channelCount < 1 || channelCount > 4)
+			return false;
+
+		Header header = {};
+		std::memcpy(header.m_magic, s_magic, sizeof(s_magic));
+		header.m_version = ALV_TEXTURE_CACHE_VERSION;
+		header.m_width = (uint32_t)dimensions.x;
+		header.m_height = (uint32_t)dimensions.y;
+		header.m_channelCount = (uint32_t)channelCount;
+		header.m_levelCount = getLevelCount(dimensions);
+		header.m_flags = premultiply ? Header::Premultiplied : 0;
+
+		uint64_t offset = alignOffset(sizeof(Header));
+		for (uint32_t level = 0; level < header.m_levelCount; ++level)
+		{
+			header.m_levelOffsets[level] = offset;
+			offset = alignOffset(offset + getLevelSize(dimensions, level, channelCount));
+		}
+
+		//Every level is made in one buffer laid out as the file is, so it's written in one go
+		std::vector<unsigned char> levels(offset - header.m_levelOffsets[0]);
+		auto getLevel = [&](uint32_t level) { return levels.data() + (header.m_levelOffsets[level] - header.m_levelOffsets[0]); };
+
+		std::memcpy(getLevel(0), pixels, getLevelSize(dimensions, 0, channelCount));
+
+		//Filtering premultiplied colours keeps transparent texels from bleeding their colour into the levels below
+		if (premultiply)
+			premultiplyAlpha(getLevel(0), (std::size_t)dimensions.x * dimensions.y, channelCount);
+
+		for (uint32_t level = 1; level < header.m_levelCount; ++level)
+			downsample(getLevel(level - 1), getLevelDimensions(dimensions, level - 1), channelCount, getLevel(level));
+
+		//Written to a temporary file first, so a half written cache is never mistaken for a whole one
+		std::string temporaryPath = getTemporaryPath(cachePath);
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			if (file.fail())
+				return false;
+
+			const char padding[ALV_TEXTURE_CACHE_ALIGNMENT] = {};
+
+			file.write((const char *)&header, sizeof(Header));
+			file.write(padding, header.m_levelOffsets[0] - sizeof(Header));
+			file.write((const char *)levels.data(), (std::streamsize)levels.size());
+
+			if (file.fail())
+				return false;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporaryPath, cachePath, error);
+		if (error)
+		{
+			std::error_code removeError;
+			std::filesystem::remove(temporaryPath, removeError);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool read(const MappedFile & file, MipChain & chain)
+	{
+		if (file.isOpen() == false || file.getSize() < sizeof(Header))
+			return false;
+
+		Header header;
+		std::memcpy(&header, file.getData(), sizeof(Header));
+
+		Vec2i dimensions((int)header.m_width, (int)header.m_height);
+
+		if (std::memcmp(header.m_magic, s_magic, sizeof(s_magic)) != 0
+			|| header.m_version != ALV_TEXTURE_CACHE_VERSION
+			|| dimensions.x <= 0 || dimensions.y <= 0
+			|| header.m_channelCount < 1 || header.m_channelCount > 4
+			|| header.m_levelCount != getLevelCount(dimensions))
+			return false;
+
+		for (uint32_t level = 0; level < header.m_levelCount; ++level)
+		{
+			uint64_t levelEnd = header.m_levelOffsets[level] + getLevelSize(dimensions, level, header.m_channelCount);
+			if (header.m_levelOffsets[level] % ALV_TEXTURE_CACHE_ALIGNMENT != 0 || levelEnd > file.getSize())
+				return false;
+
+			chain.m_levels[level] = file.getData() + header.m_levelOffsets[level];
+		}
+
+		chain.m_dimensions = dimensions;
+		chain.m_channelCount = (int)header.m_channelCount;
+		chain.m_premultiplied = (header.m_flags & Header::Premultiplied) != 0;
+		chain.m_levelCount = header.m_levelCount;
+		return true;
+	}
+
+	static unsigned char * decode(const std::string & sourcePath, int channelCount, Vec2i & dimensions)
+	{
+		int fileChannelCount;
+		unsigned char * pixelData = stbi_load(sourcePath.c_str(), &dimensions.x, &dimensions.y, &fileChannelCount, channelCount);
+
+		//This version of stb_image keeps the reason in one global, which every thread writes to while probing formats,
+		//so when decoding on several threads it may be another file's
+		if (pixelData == nullptr)
+			LogError("Failed to load image '%s': %s\n", sourcePath.c_str(), stbi_failure_reason());
+
+		return pixelData;
+	}
+
+	bool cook(const std::string & sourcePath, int channelCount, bool premultiply)
+	{
+#ifdef ALV_GRAPHICS_API_OPENGL
+		stbi_set_flip_vertically_on_load(true);
+#endif
+
+		Vec2i dimensions;
+		unsigned char * pixelData = decode(sourcePath, channelCount, dimensions);
+		if (pixelData == nullptr)
+			return false;
+
+		bool written = write(getCachePath(sourcePath), pixelData, dimensions, channelCount, premultiply);
+		stbi_image_free(pixelData);
+		return written;
+	}
+
+	bool open(const std::string & sourcePath, int channelCount, MappedFile & file, MipChain & chain, unsigned char *& pixelData, Vec2i & dimensions)
+	{
+		std::string cachePath = getCachePath(sourcePath);
+		pixelData = nullptr;
+
+		if (isUpToDate(sourcePath, cachePath))
+		{
+			file = MappedFile(cachePath);
+			if (read(file, chain) && chain.m_channelCount == channelCount)
+				return true;
+
+			file.close();
+		}
+
+		pixelData = decode(sourcePath, channelCount, dimensions);
+		if (pixelData == nullptr)
+			return false;
+
+		//Mapping what was just written means both ways of getting here upload the same way
+		if (write(cachePath, pixelData, dimensions, channelCount, false))
+		{
+			file = MappedFile(cachePath);
+			if (read(file, chain))
+			{
+				stbi_image_free(pixelData);
+				pixelData = nullptr;
+				return true;
+			}
+
+			file.close();
+		}
+
+		LogWarning("Failed to write texture cache \"%s\".\n", cachePath.c_str());
+		return false;
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "alvere/math/vector/vec_2_i.hpp"
+#include "alvere/utils/mapped_file.hpp"
+
+#define ALV_TEXTURE_CACHE_EXTENSION ".atex"
+#define ALV_TEXTURE_CACHE_VERSION 1
+//Each level starts on this boundary from the start of the file, and so of the mapping
+#define ALV_TEXTURE_CACHE_ALIGNMENT 64
+//Enough for a full chain down from 32768x32768. Larger textures stop short of 1x1.
+#define ALV_TEXTURE_CACHE_MAX_LEVELS 16
+
+namespace alvere::texture_cache
+{
+	//Cooked textures are stored next to their source as a header followed by every mip level, largest first, each
+	//laid out exactly as it's uploaded: rows in the order stb_image was set to decode them, one byte per channel and
+	//no row padding.
+	//Loading one is mapping the file and handing the levels to the GPU, with nothing to decode or filter.
+	struct Header
+	{
+		enum Flags : uint32_t
+		{
+			//Colour channels have been multiplied by alpha, so the texture needs blending with ONE, ONE_MINUS_SRC_ALPHA
+			Premultiplied = 1 << 0
+		};
+
+		char m_magic[4];
+		uint32_t m_version;
+		uint32_t m_width;
+		uint32_t m_height;
+		uint32_t m_channelCount;
+		uint32_t m_levelCount;
+		uint32_t m_flags;
+		uint32_t m_padding;
+		uint64_t m_levelOffsets[ALV_TEXTURE_CACHE_MAX_LEVELS];
+	};
+
+	//The levels of a mapped cache. They point into the mapping, so are only valid while it's open.
+	struct MipChain
+	{
+		Vec2i m_dimensions;
+		int m_channelCount;
+		bool m_premultiplied;
+		uint32_t m_levelCount;
+		const unsigned char * m_levels[ALV_TEXTURE_CACHE_MAX_LEVELS];
+	};
+
+	uint32_t getLevelCount(Vec2i dimensions);
+
+	//Each level is half the size of the one before, rounded down, and never smaller than 1
+	Vec2i getLevelDimensions(Vec2i dimensions, uint32_t level);
+
+	//Only changes textures with an alpha channel
+	void premultiplyAlpha(unsigned char * pixels, std::size_t texelCount, int channelCount);
+
+	//Box filters the source into the next level down. An odd last row or column is averaged with itself.
+	void downsample(const unsigned char * source, Vec2i sourceDimensions, int channelCount, unsigned char * destination);
+
+	std::string getCachePath(const std::string & sourcePath);
+
+	//Whether the cache exists and was written no earlier than the source was last changed
+	bool isUpToDate(const std::string & sourcePath, const std::string & cachePath);
+
+	//Generates every level below the given pixels, which are left untouched, and writes them all
+	bool write(const std::string & cachePath, const unsigned char * pixels, Vec2i dimensions, int channelCount, bool premultiply);
+
+	//Checks the file is a cache this version can read and finds its levels
+	bool read(const MappedFile & file, MipChain & chain);
+
+	//Decodes the source and writes its cache, for cooking textures ahead of time
+	bool cook(const std::string & sourcePath, int channelCount, bool premultiply = false);
+
+	//Maps the source's cache, cooking it first if it's missing, stale or has a different channel count. Caches are cooked
+	//with straight alpha; premultiplied ones are only made by cook. If the cache can't be written, returns false with
+	//the decoded pixels, which are the caller's to free with stbi_image_free, or nullptr if decoding failed as well.
+	bool open(const std::string & sourcePath, int channelCount, MappedFile & file, MipChain & chain, unsigned char *& pixelData, Vec2i & dimensions);
+}
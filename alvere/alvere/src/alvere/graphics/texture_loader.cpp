@@ -0,0 +1,287 @@
+#include "alvere/graphics/texture_loader.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <stb/image.hpp>
+
+#include "alvere/debug/logging.hpp"
+#include "alvere/utils/thread_pool.hpp"
+
+namespace alvere
+{
+	TextureLoader & TextureLoader::get()
+	{
+		static TextureLoader s_textureLoader;
+		return s_textureLoader;
+	}
+
+	TextureLoader::TextureLoader()
+		: m_stopping(false), m_uploadBudget(ALV_TEXTURE_LOADER_UPLOAD_BUDGET)
+	{ }
+
+	TextureLoader::~TextureLoader()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_jobQueued.notify_all();
+
+		for (std::thread & worker : m_workers)
+			worker.join();
+
+		//Textures still loading may outlive the loader, for example in the asset manager, so they mustn't call back into it
+		for (auto & job : m_jobs)
+		{
+			job.second->m_texture->m_loading = false;
+			release(*job.second);
+		}
+	}
+
+	Texture * TextureLoader::load(const std::string & filepath, Texture::Channels channels, bool keepPixelData)
+	{
+		int width, height, fileChannelCount;
+		if (stbi_info(filepath.c_str(), &width, &height, &fileChannelCount) == 0)
+		{
+			//The source may have been left out with only its cache shipped
+			MappedFile cacheFile(texture_cache::getCachePath(filepath));
+			texture_cache::MipChain mipChain;
+
+			if (texture_cache::read(cacheFile, mipChain) == false)
+			{
+				LogError("Failed to load image '%s': %s\n", filepath.c_str(), stbi_failure_reason());
+				return nullptr;
+			}
+
+			width = mipChain.m_dimensions.x;
+			height = mipChain.m_dimensions.y;
+		}
+
+		Texture * texture = Texture::New(Texture::Placeholder(), width, height, channels, keepPixelData).release();
+
+		std::shared_ptr<Job> job = std::make_shared<Job>();
+		job->m_texture = texture;
+		job->m_filepath = filepath;
+		job->m_channelCount = (int)channels;
+		job->m_state = Job::State::Queued;
+		job->m_mipChain = {};
+		job->m_pixelData = nullptr;
+		job->m_dimensions = Vec2i(width, height);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			if (m_workers.empty())
+				startWorkers();
+
+			m_decodeQueue.push_back(job);
+			m_jobs.emplace(texture, job);
+		}
+		m_jobQueued.notify_one();
+
+		return texture;
+	}
+
+	void TextureLoader::uploadPending(std::size_t budgetBytes)
+	{
+		std::size_t uploadedBytes = 0;
+
+		while (true)
+		{
+			std::shared_ptr<Job> job;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				if (m_uploadQueue.empty())
+					return;
+
+				std::size_t bytes = m_uploadQueue.front()->getUploadSize();
+
+				if (uploadedBytes > 0 && uploadedBytes + bytes > budgetBytes)
+					return;
+
+				uploadedBytes += bytes;
+
+				job = m_uploadQueue.front();
+				m_uploadQueue.pop_front();
+				m_jobs.erase(job->m_texture);
+			}
+
+			//Uploading is done outside the lock, so the workers can carry on queueing behind it
+			upload(*job);
+		}
+	}
+
+	void TextureLoader::uploadPending()
+	{
+		uploadPending(m_uploadBudget);
+	}
+
+	void TextureLoader::finish(const Texture & texture)
+	{
+		if (texture.isLoading() == false)
+			return;
+
+		std::shared_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			auto found = m_jobs.find(&texture);
+			if (found == m_jobs.end())
+				return;
+
+			job = found->second;
+			m_jobs.erase(found);
+
+			//Decoded here rather than waiting behind everything queued before it
+			if (job->m_state == Job::State::Queued)
+			{
+				removeFromQueue(m_decodeQueue, *job);
+				job->m_state = Job::State::Decoding;
+
+				lock.unlock();
+				decode(*job);
+				lock.lock();
+
+				job->m_state = Job::State::Decoded;
+			}
+			else
+			{
+				m_jobDecoded.wait(lock, [&]() { return job->m_state == Job::State::Decoded; });
+				removeFromQueue(m_uploadQueue, *job);
+			}
+		}
+
+		upload(*job);
+	}
+
+	void TextureLoader::setUploadBudget(std::size_t budgetBytes)
+	{
+		m_uploadBudget = budgetBytes;
+	}
+
+	std::size_t TextureLoader::getUploadBudget() const
+	{
+		return m_uploadBudget;
+	}
+
+	std::size_t TextureLoader::getLoadingCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_jobs.size();
+	}
+
+	void TextureLoader::startWorkers()
+	{
+		//Set once before any worker reads it, since it's global to stb_image. Caches are cooked the same way up.
+#ifdef ALV_GRAPHICS_API_OPENGL
+		stbi_set_flip_vertically_on_load(true);
+#endif
+
+		unsigned int threadCount = std::clamp(ThreadPool::defaultWorkerCount(), 1u, (unsigned int)ALV_TEXTURE_LOADER_MAX_THREADS);
+
+		m_workers.reserve(threadCount);
+		for (unsigned int i = 0; i < threadCount; ++i)
+			m_workers.emplace_back(&TextureLoader::workerLoop, this);
+	}
+
+	void TextureLoader::workerLoop()
+	{
+		while (true)
+		{
+			std::shared_ptr<Job> job;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_jobQueued.wait(lock, [this]() { return m_stopping || m_decodeQueue.empty() == false; });
+
+				if (m_stopping)
+					return;
+
+				job = m_decodeQueue.front();
+				m_decodeQueue.pop_front();
+				job->m_state = Job::State::Decoding;
+			}
+
+			decode(*job);
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				job->m_state = Job::State::Decoded;
+
+				if (job->m_texture != nullptr)
+				{
+					m_uploadQueue.push_back(job);
+				}
+				else
+				{
+					release(*job);
+				}
+			}
+			m_jobDecoded.notify_all();
+		}
+	}
+
+	void TextureLoader::decode(Job & job)
+	{
+		texture_cache::open(job.m_filepath, job.m_channelCount, job.m_cacheFile, job.m_mipChain, job.m_pixelData, job.m_dimensions);
+	}
+
+	void TextureLoader::upload(Job & job)
+	{
+		if (job.m_cacheFile.isOpen())
+			job.m_texture->setMipChain(std::move(job.m_cacheFile), job.m_mipChain);
+		else
+			job.m_texture->setPixelData(job.m_pixelData, job.m_dimensions);
+
+		job.m_pixelData = nullptr;
+	}
+
+	void TextureLoader::release(Job & job)
+	{
+		job.m_cacheFile.close();
+		stbi_image_free(job.m_pixelData);
+		job.m_pixelData = nullptr;
+	}
+
+	std::size_t TextureLoader::Job::getUploadSize() const
+	{
+		Vec2i dimensions = m_cacheFile.isOpen() ? m_mipChain.m_dimensions : m_dimensions;
+		std::size_t size = (std::size_t)dimensions.x * dimensions.y * m_channelCount;
+
+		//Every level below the first adds up to a third of it
+		return m_cacheFile.isOpen() ? size + size / 3 : size;
+	}
+
+	void TextureLoader::removeFromQueue(std::deque<std::shared_ptr<Job>> & queue, const Job & job)
+	{
+		auto found = std::find_if(queue.begin(), queue.end(), [&](const std::shared_ptr<Job> & queued) { return queued.get() == &job; });
+		if (found != queue.end())
+			queue.erase(found);
+	}
+
+	void TextureLoader::cancel(const Texture & texture)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto found = m_jobs.find(&texture);
+		if (found == m_jobs.end())
+			return;
+
+		Job & job = *found->second;
+		job.m_texture = nullptr;
+
+		//A job being decoded is freed by its worker once it's done
+		if (job.m_state == Job::State::Queued)
+		{
+			removeFromQueue(m_decodeQueue, job);
+		}
+		else if (job.m_state == Job::State::Decoded)
+		{
+			removeFromQueue(m_uploadQueue, job);
+			release(job);
+		}
+
+		m_jobs.erase(found);
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "alvere/graphics/texture.hpp"
+#include "alvere/graphics/texture_cache.hpp"
+#include "alvere/utils/mapped_file.hpp"
+
+//Bytes uploadPending uploads in one call unless told otherwise, about a 1024x1024 RGBA texture
+#define ALV_TEXTURE_LOADER_UPLOAD_BUDGET (4 * 1024 * 1024)
+//Decoding is mostly waiting on the disk and inflating, so only a few threads are worth having
+#define ALV_TEXTURE_LOADER_MAX_THREADS 4
+
+namespace alvere
+{
+	//Maps texture caches, or decodes and cooks image files that have none, on worker threads so asking for a texture
+	//never waits on the disk or the decoder. load returns a placeholder straight away, and uploadPending, called once a
+	//frame on the thread that owns the graphics context, swaps the pixels into their placeholders under a byte budget.
+	class TextureLoader
+	{
+	public:
+
+		static TextureLoader & get();
+
+		~TextureLoader();
+
+		TextureLoader(const TextureLoader &) = delete;
+		TextureLoader & operator=(const TextureLoader &) = delete;
+
+		//Reads only the file's header here, so the placeholder has the image's size from the start.
+		//Returns nullptr if the header can't be read.
+		Texture * load(const std::string & filepath, Texture::Channels channels = Texture::Channels::RGBAlpha, bool keepPixelData = false);
+
+		//Uploads decoded textures, oldest first, until budgetBytes have been uploaded. The first is always uploaded,
+		//so a texture larger than the budget still gets through.
+		void uploadPending(std::size_t budgetBytes);
+
+		void uploadPending();
+
+		//Blocks until the texture is decoded and uploads it, whatever the budget. For code that needs its pixels now.
+		//Does nothing to textures that aren't loading.
+		void finish(const Texture & texture);
+
+		void setUploadBudget(std::size_t budgetBytes);
+
+		std::size_t getUploadBudget() const;
+
+		//Textures that are still placeholders
+		std::size_t getLoadingCount() const;
+
+	private:
+
+		friend Texture;
+
+		struct Job
+		{
+			enum class State
+			{
+				Queued,
+				Decoding,
+				Decoded
+			};
+
+			//Cleared if the texture is destroyed while its file is being decoded
+			Texture * m_texture;
+			std::string m_filepath;
+			int m_channelCount;
+			State m_state;
+
+			//The mapped cache, or the decoded pixels if it couldn't be written
+			MappedFile m_cacheFile;
+			texture_cache::MipChain m_mipChain;
+			unsigned char * m_pixelData;
+			Vec2i m_dimensions;
+
+			std::size_t getUploadSize() const;
+		};
+
+		std::vector<std::thread> m_workers;
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_jobQueued;
+		std::condition_variable m_jobDecoded;
+
+		//Shared with the worker decoding them, which may outlive their texture
+		std::deque<std::shared_ptr<Job>> m_decodeQueue;
+		std::deque<std::shared_ptr<Job>> m_uploadQueue;
+		std::unordered_map<const Texture *, std::shared_ptr<Job>> m_jobs;
+
+		bool m_stopping;
+
+		std::size_t m_uploadBudget;
+
+		TextureLoader();
+
+		//Started by the first load, so applications that never load asynchronously have no idle threads
+		void startWorkers();
+
+		void workerLoop();
+
+		static void decode(Job & job);
+
+		static void upload(Job & job);
+
+		//Frees whatever a job that won't be uploaded is holding
+		static void release(Job & job);
+
+		//Must be called with the lock held
+		void removeFromQueue(std::deque<std::shared_ptr<Job>> & queue, const Job & job);
+
+		//Called by a texture destroyed while loading
+		void cancel(const Texture & texture);
+	};
+}
@@ -0,0 +1,129 @@
+#include "alvere/utils/mapped_file.hpp"
+
+#include <utility>
+
+#ifdef ALV_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace alvere
+{
+	MappedFile::MappedFile()
+		: m_data(nullptr), m_size(0)
+#ifdef ALV_PLATFORM_WINDOWS
+		, m_file(nullptr), m_mapping(nullptr)
+#endif
+	{ }
+
+	MappedFile::MappedFile(const std::string & filepath)
+		: MappedFile()
+	{
+#ifdef ALV_PLATFORM_WINDOWS
+		HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(file, &size) == FALSE || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			CloseHandle(file);
+			return;
+		}
+
+		void * data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == nullptr)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return;
+		}
+
+		m_file = file;
+		m_mapping = mapping;
+		m_data = (const unsigned char *)data;
+		m_size = (std::size_t)size.QuadPart;
+#else
+		int file = open(filepath.c_str(), O_RDONLY);
+		if (file < 0)
+			return;
+
+		struct stat status;
+		if (fstat(file, &status) != 0 || status.st_size == 0)
+		{
+			::close(file);
+			return;
+		}
+
+		void * data = mmap(nullptr, (std::size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+		//The mapping keeps the file alive by itself
+		::close(file);
+
+		if (data == MAP_FAILED)
+			return;
+
+		m_data = (const unsigned char *)data;
+		m_size = (std::size_t)status.st_size;
+#endif
+	}
+
+	MappedFile::MappedFile(MappedFile && other) noexcept
+		: MappedFile()
+	{
+		*this = std::move(other);
+	}
+
+	MappedFile & MappedFile::operator=(MappedFile && other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+
+			m_data = std::exchange(other.m_data, nullptr);
+			m_size = std::exchange(other.m_size, 0);
+#ifdef ALV_PLATFORM_WINDOWS
+			m_file = std::exchange(other.m_file, nullptr);
+			m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+		}
+		return *this;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+	void MappedFile::close()
+	{
+		if (m_data == nullptr)
+			return;
+
+#ifdef ALV_PLATFORM_WINDOWS
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping);
+		CloseHandle(m_file);
+		m_file = nullptr;
+		m_mapping = nullptr;
+#else
+		munmap((void *)m_data, m_size);
+#endif
+
+		m_data = nullptr;
+		m_size = 0;
+	}
+}
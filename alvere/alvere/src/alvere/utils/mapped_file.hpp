@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace alvere
+{
+	//A read only view of a whole file, mapped into memory instead of read into it. Pages are only loaded when they're
+	//first touched, and the OS can drop them again under memory pressure since the file is still there to reload them from.
+	class MappedFile
+	{
+	public:
+
+		MappedFile();
+
+		//Check isOpen() afterwards. Failing to open the file isn't an error, since callers usually have another way to load.
+		explicit MappedFile(const std::string & filepath);
+
+		MappedFile(MappedFile && other) noexcept;
+
+		MappedFile & operator=(MappedFile && other) noexcept;
+
+		MappedFile(const MappedFile & other) = delete;
+
+		MappedFile & operator=(const MappedFile & other) = delete;
+
+		~MappedFile();
+
+		bool isOpen() const { return m_data != nullptr; }
+
+		const unsigned char * getData() const { return m_data; }
+
+		std::size_t getSize() const { return m_size; }
+
+		void close();
+
+	private:
+
+		const unsigned char * m_data;
+
+		std::size_t m_size;
+
+#ifdef ALV_PLATFORM_WINDOWS
+		void * m_file;
+
+		void * m_mapping;
+#endif
+	};
+}
@@ -0,0 +1,79 @@
+#include "alvere/utils/radix_sort.hpp"
+
+#include <utility>
+
+namespace alvere::utils
+{
+	//Values are only moved when there are some, so the keys only sort costs nothing extra
+	template <bool HasValues>
+	static void radixSortImpl(std::vector<uint64_t> & keys, std::vector<uint64_t> & scratch, std::vector<uint32_t> * values, std::vector<uint32_t> * valueScratch, unsigned int firstByte)
+	{
+		const std::size_t count = keys.size();
+		if (count < 2 || firstByte >= 8)
+		{
+			return;
+		}
+
+		//Every histogram is filled in a single pass over the keys
+		std::size_t histograms[8][256] = {};
+		for (uint64_t key : keys)
+		{
+			for (unsigned int byte = firstByte; byte < 8; ++byte)
+			{
+				++histograms[byte][(key >> (byte * 8)) & 0xFF];
+			}
+		}
+
+		scratch.resize(count);
+		if constexpr (HasValues)
+		{
+			valueScratch->resize(count);
+		}
+
+		for (unsigned int byte = firstByte; byte < 8; ++byte)
+		{
+			std::size_t * histogram = histograms[byte];
+
+			//Every key has the same value here, so this pass would not move anything
+			if (histogram[(keys[0] >> (byte * 8)) & 0xFF] == count)
+			{
+				continue;
+			}
+
+			std::size_t offset = 0;
+			for (int digit = 0; digit < 256; ++digit)
+			{
+				std::size_t digitCount = histogram[digit];
+				histogram[digit] = offset;
+				offset += digitCount;
+			}
+
+			for (std::size_t idx = 0; idx < count; ++idx)
+			{
+				std::size_t destination = histogram[(keys[idx] >> (byte * 8)) & 0xFF]++;
+				scratch[destination] = keys[idx];
+
+				if constexpr (HasValues)
+				{
+					(*valueScratch)[destination] = (*values)[idx];
+				}
+			}
+
+			std::swap(keys, scratch);
+			if constexpr (HasValues)
+			{
+				std::swap(*values, *valueScratch);
+			}
+		}
+	}
+
+	void radixSort(std::vector<uint64_t> & keys, std::vector<uint64_t> & scratch, unsigned int firstByte)
+	{
+		radixSortImpl<false>(keys, scratch, nullptr, nullptr, firstByte);
+	}
+
+	void radixSort(std::vector<uint64_t> & keys, std::vector<uint32_t> & values, std::vector<uint64_t> & keyScratch, std::vector<uint32_t> & valueScratch, unsigned int firstByte)
+	{
+		radixSortImpl<true>(keys, keyScratch, &values, &valueScratch, firstByte);
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace alvere::utils
+{
+	//Stable least significant digit radix sort of 64 bit keys, a byte at a time. Only the bytes from firstByte
+	//upwards are sorted on, so keys that are already in order in their low bytes can skip those passes,
+	//and any byte that is the same in every key is skipped too. Scratch is resized to fit and may be swapped with keys.
+	void radixSort(std::vector<uint64_t> & keys, std::vector<uint64_t> & scratch, unsigned int firstByte = 0);
+
+	//The same sort, moving each key's value along with it. For keys that need all 64 bits, with no room left for an index.
+	void radixSort(std::vector<uint64_t> & keys, std::vector<uint32_t> & values, std::vector<uint64_t> & keyScratch, std::vector<uint32_t> & valueScratch, unsigned int firstByte = 0);
+
+	//Maps a float onto an unsigned integer that sorts in the same order, with negatives before positives
+	inline uint32_t sortableFloatBits(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+	}
+}
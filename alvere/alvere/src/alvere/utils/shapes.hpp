@@ -40,6 +40,14 @@ namespace alvere
 
 		float getArea() const;
 
+		inline bool intersects(const Rect other) const
+		{
+			return !(other.getLeft() >= getRight() ||
+				other.getRight() <= getLeft() ||
+				other.getTop() <= getBottom() ||
+				other.getBottom() >= getTop());
+		}
+
 		explicit operator RectI() const;
 	};
 
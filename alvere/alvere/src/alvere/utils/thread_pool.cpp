@@ -0,0 +1,129 @@
+#include "alvere/utils/thread_pool.hpp"
+
+#include <algorithm>
+
+namespace alvere
+{
+	ThreadPool::ThreadPool(unsigned int workerCount)
+		: m_Function(nullptr), m_Count(0), m_RangeSize(0), m_Generation(0), m_PendingWorkers(0), m_Stopping(false)
+	{
+		m_Workers.reserve(workerCount);
+		for (unsigned int i = 0; i < workerCount; ++i)
+		{
+			m_Workers.emplace_back(&ThreadPool::workerLoop, this, i + 1);
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_WorkReady.notify_all();
+
+		for (std::thread & worker : m_Workers)
+		{
+			worker.join();
+		}
+	}
+
+	void ThreadPool::parallelFor(std::size_t count, const RangeFunction & function, std::size_t minimumPerThread)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		std::size_t threadCount = std::min<std::size_t>(getThreadCount(), (count + minimumPerThread - 1) / std::max<std::size_t>(minimumPerThread, 1));
+
+		//Not worth waking anyone up for
+		if (threadCount <= 1)
+		{
+			function(0, count, 0);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Function = &function;
+			m_Count = count;
+			m_RangeSize = (count + threadCount - 1) / threadCount;
+			m_PendingWorkers = (unsigned int)m_Workers.size();
+			m_Exception = nullptr;
+			++m_Generation;
+		}
+		m_WorkReady.notify_all();
+
+		runRange(0);
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_WorkDone.wait(lock, [this]() { return m_PendingWorkers == 0; });
+		m_Function = nullptr;
+
+		if (m_Exception)
+		{
+			std::rethrow_exception(m_Exception);
+		}
+	}
+
+	unsigned int ThreadPool::defaultWorkerCount()
+	{
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	void ThreadPool::workerLoop(unsigned int thread)
+	{
+		unsigned int lastGeneration = 0;
+
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_WorkReady.wait(lock, [&]() { return m_Stopping || m_Generation != lastGeneration; });
+
+				if (m_Stopping)
+				{
+					return;
+				}
+
+				lastGeneration = m_Generation;
+			}
+
+			runRange(thread);
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (--m_PendingWorkers == 0)
+				{
+					m_WorkDone.notify_one();
+				}
+			}
+		}
+	}
+
+	void ThreadPool::runRange(unsigned int thread)
+	{
+		std::size_t begin = std::min(m_Count, thread * m_RangeSize);
+		std::size_t end = std::min(m_Count, begin + m_RangeSize);
+
+		if (begin == end)
+		{
+			return;
+		}
+
+		try
+		{
+			(*m_Function)(begin, end, thread);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (!m_Exception)
+			{
+				m_Exception = std::current_exception();
+			}
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace alvere
+{
+	//A fixed set of worker threads that split loops between themselves and the calling thread.
+	class ThreadPool
+	{
+	public:
+
+		//Called once per thread with a contiguous [begin, end) range and the index of the thread running it.
+		//Thread 0 is always the calling thread, so per-thread scratch can be indexed by it.
+		using RangeFunction = std::function<void(std::size_t begin, std::size_t end, unsigned int thread)>;
+
+		ThreadPool(unsigned int workerCount = defaultWorkerCount());
+
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool & operator=(const ThreadPool &) = delete;
+
+		//Splits [0, count) into one range per thread and blocks until every range is done.
+		//The split only depends on count and the thread count, so work that only touches its own
+		//indices gives the same result as running it serially. The first exception thrown is rethrown here.
+		void parallelFor(std::size_t count, const RangeFunction & function, std::size_t minimumPerThread = 1);
+
+		inline unsigned int getThreadCount() const
+		{
+			return (unsigned int)m_Workers.size() + 1;
+		}
+
+		static unsigned int defaultWorkerCount();
+
+	private:
+
+		void workerLoop(unsigned int thread);
+		void runRange(unsigned int thread);
+
+		std::vector<std::thread> m_Workers;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_WorkReady;
+		std::condition_variable m_WorkDone;
+
+		const RangeFunction * m_Function;
+		std::size_t m_Count;
+		std::size_t m_RangeSize;
+		unsigned int m_Generation;
+		unsigned int m_PendingWorkers;
+		bool m_Stopping;
+
+		std::exception_ptr m_Exception;
+	};
+}
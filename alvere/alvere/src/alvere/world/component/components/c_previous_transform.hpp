@@ -0,0 +1,34 @@
+#pragma once
+
+#include "alvere/math/vectors.hpp"
+#include "alvere/world/application/transform.hpp"
+#include "alvere/world/component/pooled_component.hpp"
+
+namespace alvere
+{
+	//Pose of an entity's C_Transform at the start of the last fixed step, so renderers can draw
+	//somewhere between it and the current pose when frames land between steps.
+	struct C_PreviousTransform : public PooledComponent<C_PreviousTransform>
+	{
+		Vector3 m_position;
+
+		//False until the first snapshot, so newly spawned entities don't slide in from the origin
+		bool m_isSet = false;
+
+		inline void snapshot(const Transform & current)
+		{
+			m_position = current.getPosition();
+			m_isSet = true;
+		}
+
+		inline Vector3 interpolatePosition(const Transform & current, float alpha) const
+		{
+			if (m_isSet == false)
+			{
+				return current.getPosition();
+			}
+
+			return m_position + (current.getPosition() - m_position) * alpha;
+		}
+	};
+}
@@ -1,31 +1,85 @@
 #include "alvere/world/system/systems/s_sprite_renderer.hpp"
 
+#include <cmath>
+
 namespace alvere
 {
 	S_SpriteRenderer::S_SpriteRenderer(Camera & camera)
 		: m_camera(camera)
+		, m_interpolation(1.0f)
+		, m_visibleBounds(0.0f, 0.0f, 0.0f, 0.0f)
+		, m_staticQuery(Archetype::Query().Include<C_Transform, C_Sprite>().Exclude<C_PreviousTransform>())
+		, m_interpolatedQuery(Archetype::Query().Include<C_Transform, C_Sprite, C_PreviousTransform>())
 	{
-		m_spriteBatcher = SpriteBatcher::New();
+		//Sprites are drawn with normal tints and texture coordinates, so they can be sent as instances
+		m_spriteBatcher = SpriteBatcher::New(ALV_SPRITEBATCH_DEFAULT_CAPACITY, SpriteBatcher::VertexFormat::Instanced);
 	}
 
 	void S_SpriteRenderer::Render(World & world)
 	{
 		m_spriteBatcher->begin(m_camera.getProjectionViewMatrix());
+		m_visibleBounds = m_camera.getVisibleBounds();
 
-		QueryRenderedSystem<const C_Transform, const C_Sprite>::Render(world);
+		world.QueryArchetypes(m_staticQuery, m_archetypes);
+		for (Archetype & archetype : m_archetypes)
+		{
+			ArchetypeProviderIterator<C_Transform, C_Sprite> iterator(archetype.GetEntityCount(), archetype.GetProvider<C_Transform>(), archetype.GetProvider<C_Sprite>());
+			for (; iterator; ++iterator)
+			{
+				auto components = iterator.GetComponents();
+				Render(std::get<0>(components), std::get<1>(components));
+			}
+		}
+
+		world.QueryArchetypes(m_interpolatedQuery, m_archetypes);
+		for (Archetype & archetype : m_archetypes)
+		{
+			ArchetypeProviderIterator<C_Transform, C_Sprite, C_PreviousTransform> iterator(archetype.GetEntityCount(), archetype.GetProvider<C_Transform>(), archetype.GetProvider<C_Sprite>(), archetype.GetProvider<C_PreviousTransform>());
+			for (; iterator; ++iterator)
+			{
+				auto components = iterator.GetComponents();
+				const C_Transform & transform = std::get<0>(components);
+				const C_PreviousTransform & previous = std::get<2>(components);
+
+				Submit(previous.interpolatePosition(transform.m_transform, m_interpolation), transform, std::get<1>(components));
+			}
+		}
 
 		m_spriteBatcher->end();
 	}
 
 	void S_SpriteRenderer::Render(const C_Transform & transform, const C_Sprite & sprite)
+	{
+		Submit(transform->getPosition(), transform, sprite);
+	}
+
+	void S_SpriteRenderer::SetInterpolation(float alpha)
+	{
+		m_interpolation = alpha;
+	}
+
+	void S_SpriteRenderer::Submit(const Vector3 & position, const C_Transform & transform, const C_Sprite & sprite)
 	{
 		Rect destination = Rect{
-			transform->getPosition().x + sprite.m_sprite.bounds().m_x,
-			transform->getPosition().y + sprite.m_sprite.bounds().m_y,
+			position.x + sprite.m_sprite.bounds().m_x,
+			position.y + sprite.m_sprite.bounds().m_y,
 			transform->getScale().x * sprite.m_sprite.bounds().m_width,
 			transform->getScale().y * sprite.m_sprite.bounds().m_height
 		};
 
+		//A negative scale flips the rect, so turn it the right way round before testing it against the view
+		Rect bounds = Rect{
+			destination.m_width < 0.0f ? destination.m_x + destination.m_width : destination.m_x,
+			destination.m_height < 0.0f ? destination.m_y + destination.m_height : destination.m_y,
+			std::abs(destination.m_width),
+			std::abs(destination.m_height)
+		};
+
+		if (bounds.intersects(m_visibleBounds) == false)
+		{
+			return;
+		}
+
 		alvere::RectI textureSource = sprite.m_sprite.textureSource();
 
 		if (sprite.m_mirrored[0])
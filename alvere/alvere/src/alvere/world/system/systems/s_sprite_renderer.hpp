@@ -2,12 +2,14 @@
 
 #include "alvere/graphics/camera.hpp"
 #include "alvere/graphics/sprite_batcher.hpp"
+#include "alvere/world/component/components/c_previous_transform.hpp"
 #include "alvere/world/component/components/c_sprite.hpp"
 #include "alvere/world/component/components/c_transform.hpp"
 #include "alvere/world/system/query_rendered_system.hpp"
 
 namespace alvere
 {
+	//Sprites whose bounds fall outside the camera's view are not submitted
 	class S_SpriteRenderer : public virtual QueryRenderedSystem<const C_Transform, const C_Sprite>
 	{
 	public:
@@ -18,10 +20,26 @@ namespace alvere
 
 		virtual void Render(const C_Transform & transform, const C_Sprite & sprite) override;
 
+		//Entities with a C_PreviousTransform are drawn this far between their previous and current pose
+		void SetInterpolation(float alpha);
+
+		//Number of draw calls the sprites were split into last frame
+		unsigned int GetFlushCount() const { return m_spriteBatcher->getFlushCount(); }
+
 	private:
 
+		void Submit(const Vector3 & position, const C_Transform & transform, const C_Sprite & sprite);
+
 		std::unique_ptr<SpriteBatcher> m_spriteBatcher;
 
 		Camera & m_camera;
+
+		float m_interpolation;
+
+		Rect m_visibleBounds;
+
+		Archetype::Query m_staticQuery;
+		Archetype::Query m_interpolatedQuery;
+		std::vector<std::reference_wrapper<Archetype>> m_archetypes;
 	};
 }
\ No newline at end of file
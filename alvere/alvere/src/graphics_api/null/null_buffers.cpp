@@ -0,0 +1,67 @@
+#include "graphics_api/null/null_buffers.hpp"
+
+#include "graphics_api/null/null_command_log.hpp"
+
+namespace alvere::graphics_api::null
+{
+	VertexBuffer::VertexBuffer()
+	{
+		m_Size = 0;
+		CommandLog::get().record(CommandLog::CommandType::CreateBuffer, this);
+	}
+
+	VertexBuffer::VertexBuffer(const float * vertexData, unsigned int size)
+		: VertexBuffer()
+	{
+		SetData(vertexData, size);
+	}
+
+	void VertexBuffer::SetData(const float * vertexData, unsigned int size)
+	{
+		m_Size = size;
+
+		//Without data this only reserves the storage
+		CommandLog::get().record(CommandLog::CommandType::UploadBuffer, this, vertexData != nullptr ? size : 0);
+	}
+
+	void VertexBuffer::SetSubData(unsigned int offset, const float * vertexData, unsigned int size)
+	{
+		CommandLog::get().record(CommandLog::CommandType::UploadBuffer, this, size);
+	}
+
+	void VertexBuffer::Bind()
+	{
+		CommandLog::get().record(CommandLog::CommandType::BindBuffer, this);
+	}
+
+	void VertexBuffer::Unbind()
+	{
+		CommandLog::get().record(CommandLog::CommandType::BindBuffer, nullptr);
+	}
+
+	IndexBuffer::IndexBuffer(const unsigned int * indices, unsigned int count)
+	{
+		m_Count = count;
+		m_IndexSize = sizeof(unsigned int);
+		CommandLog::get().record(CommandLog::CommandType::CreateBuffer, this);
+		CommandLog::get().record(CommandLog::CommandType::UploadBuffer, this, count * sizeof(unsigned int));
+	}
+
+	IndexBuffer::IndexBuffer(const unsigned short * indices, unsigned int count)
+	{
+		m_Count = count;
+		m_IndexSize = sizeof(unsigned short);
+		CommandLog::get().record(CommandLog::CommandType::CreateBuffer, this);
+		CommandLog::get().record(CommandLog::CommandType::UploadBuffer, this, count * sizeof(unsigned short));
+	}
+
+	void IndexBuffer::Bind()
+	{
+		CommandLog::get().record(CommandLog::CommandType::BindBuffer, this);
+	}
+
+	void IndexBuffer::Unbind()
+	{
+		CommandLog::get().record(CommandLog::CommandType::BindBuffer, nullptr);
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "alvere/graphics/buffers.hpp"
+
+namespace alvere::graphics_api::null
+{
+	class VertexBuffer : public alvere::VertexBuffer
+	{
+	public:
+		VertexBuffer();
+		VertexBuffer(const float * vertexData, unsigned int size);
+
+		void SetData(const float * vertexData, unsigned int size) override;
+		void SetSubData(unsigned int offset, const float * vertexData, unsigned int size) override;
+		void Bind() override;
+		void Unbind() override;
+	};
+
+	class IndexBuffer : public alvere::IndexBuffer
+	{
+	public:
+		IndexBuffer(const unsigned int * indices, unsigned int count);
+		IndexBuffer(const unsigned short * indices, unsigned int count);
+
+		void Bind() override;
+		void Unbind() override;
+	};
+}
@@ -0,0 +1,71 @@
+#include "graphics_api/null/null_command_log.hpp"
+
+namespace alvere::graphics_api::null
+{
+	CommandLog & CommandLog::get()
+	{
+		static CommandLog s_commandLog;
+		return s_commandLog;
+	}
+
+	void CommandLog::record(CommandType type, const void * object, std::size_t bytes, unsigned int count)
+	{
+		switch (type)
+		{
+		case CommandType::UploadBuffer:
+		case CommandType::UploadTexture:
+			++m_counters.uploads;
+			m_counters.bytesUploaded += bytes;
+			break;
+		case CommandType::BindBuffer: ++m_counters.bufferBinds; break;
+		case CommandType::BindTexture: ++m_counters.textureBinds; break;
+		case CommandType::BindShaderProgram: ++m_counters.shaderProgramBinds; break;
+		case CommandType::BindFrameBuffer: ++m_counters.frameBufferBinds; break;
+		case CommandType::SetUniform: ++m_counters.uniforms; break;
+		case CommandType::Draw:
+			++m_counters.drawCalls;
+			m_counters.vertices += count;
+			break;
+		case CommandType::DrawInstanced:
+			++m_counters.drawCalls;
+			m_counters.instances += count;
+			break;
+		default:
+			break;
+		}
+
+		if (m_recording)
+		{
+			m_commands.push_back(Command{ type, object, bytes, count });
+		}
+	}
+
+	void CommandLog::reset()
+	{
+		m_commands.clear();
+		m_counters = Counters();
+	}
+
+	const char * CommandLog::getName(CommandType type)
+	{
+		switch (type)
+		{
+		case CommandType::SetClearColour: return "SetClearColour";
+		case CommandType::Clear: return "Clear";
+		case CommandType::SetViewport: return "SetViewport";
+		case CommandType::CreateBuffer: return "CreateBuffer";
+		case CommandType::UploadBuffer: return "UploadBuffer";
+		case CommandType::BindBuffer: return "BindBuffer";
+		case CommandType::CreateTexture: return "CreateTexture";
+		case CommandType::UploadTexture: return "UploadTexture";
+		case CommandType::BindTexture: return "BindTexture";
+		case CommandType::BuildShaderProgram: return "BuildShaderProgram";
+		case CommandType::BindShaderProgram: return "BindShaderProgram";
+		case CommandType::SetUniform: return "SetUniform";
+		case CommandType::BindFrameBuffer: return "BindFrameBuffer";
+		case CommandType::Draw: return "Draw";
+		case CommandType::DrawInstanced: return "DrawInstanced";
+		}
+		return "Unknown";
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace alvere::graphics_api::null
+{
+	//Everything the null backend has been asked to do since the last reset. Nothing reaches a GPU, so this is
+	//for measuring how much work the render path would hand to one: draws, state changes and bytes uploaded.
+	//The counters are always kept. The commands themselves are only kept while recording, which is off until
+	//setRecording(true), as nothing clears them unless reset() is called.
+	class CommandLog
+	{
+	public:
+
+		enum class CommandType
+		{
+			SetClearColour,
+			Clear,
+			SetViewport,
+			CreateBuffer,
+			UploadBuffer,
+			BindBuffer,
+			CreateTexture,
+			UploadTexture,
+			BindTexture,
+			BuildShaderProgram,
+			BindShaderProgram,
+			SetUniform,
+			BindFrameBuffer,
+			Draw,
+			DrawInstanced
+		};
+
+		struct Command
+		{
+			CommandType type;
+			//The buffer, texture, program or frame buffer acted on. Unbinding is a bind of nullptr.
+			const void * object;
+			std::size_t bytes;
+			//Vertices or indices for draws, instances for instanced draws
+			unsigned int count;
+		};
+
+		struct Counters
+		{
+			unsigned int drawCalls = 0;
+			//Vertices or indices drawn without instancing
+			unsigned int vertices = 0;
+			unsigned int instances = 0;
+			unsigned int bufferBinds = 0;
+			unsigned int textureBinds = 0;
+			unsigned int shaderProgramBinds = 0;
+			unsigned int frameBufferBinds = 0;
+			unsigned int uniforms = 0;
+			unsigned int uploads = 0;
+			std::size_t bytesUploaded = 0;
+
+			unsigned int getStateChanges() const
+			{
+				return bufferBinds + textureBinds + shaderProgramBinds + frameBufferBinds;
+			}
+		};
+
+		static CommandLog & get();
+
+		void record(CommandType type, const void * object, std::size_t bytes = 0, unsigned int count = 0);
+
+		//Clears the commands and counters, normally once per frame
+		void reset();
+
+		void setRecording(bool recording) { m_recording = recording; }
+
+		bool isRecording() const { return m_recording; }
+
+		const std::vector<Command> & getCommands() const { return m_commands; }
+
+		const Counters & getCounters() const { return m_counters; }
+
+		static const char * getName(CommandType type);
+
+	private:
+
+		bool m_recording = false;
+
+		std::vector<Command> m_commands;
+
+		Counters m_counters;
+	};
+}
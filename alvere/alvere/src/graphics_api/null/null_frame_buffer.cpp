@@ -0,0 +1,31 @@
+#include "graphics_api/null/null_frame_buffer.hpp"
+
+#include "graphics_api/null/null_command_log.hpp"
+#include "graphics_api/null/null_texture.hpp"
+
+namespace alvere::graphics_api::null
+{
+	FrameBuffer::FrameBuffer(unsigned int width, unsigned int height)
+	{
+		m_texture = std::make_unique<Texture>(width, height, Texture::Channels::RGB);
+	}
+
+	FrameBuffer::~FrameBuffer()
+	{
+	}
+
+	void FrameBuffer::resize(int width, int height)
+	{
+		m_texture->resize(width, height);
+	}
+
+	void FrameBuffer::bind() const
+	{
+		CommandLog::get().record(CommandLog::CommandType::BindFrameBuffer, this);
+	}
+
+	void FrameBuffer::unbind() const
+	{
+		CommandLog::get().record(CommandLog::CommandType::BindFrameBuffer, nullptr);
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "alvere/graphics/frame_buffer.hpp"
+
+namespace alvere::graphics_api::null
+{
+	class FrameBuffer : public ::alvere::FrameBuffer
+	{
+	public:
+
+		FrameBuffer(unsigned int width, unsigned int height);
+
+		~FrameBuffer() override;
+
+		void resize(int width, int height) override;
+
+		void bind() const override;
+
+		void unbind() const override;
+	};
+}
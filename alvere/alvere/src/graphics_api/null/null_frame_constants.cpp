@@ -0,0 +1,16 @@
+#include "graphics_api/null/null_frame_constants.hpp"
+
+#include "graphics_api/null/null_command_log.hpp"
+
+namespace alvere::graphics_api::null
+{
+	FrameConstants::FrameConstants()
+	{
+		CommandLog::get().record(CommandLog::CommandType::CreateBuffer, this);
+	}
+
+	void FrameConstants::uploadBlock(const Block & block)
+	{
+		CommandLog::get().record(CommandLog::CommandType::UploadBuffer, this, sizeof(Block));
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "alvere/graphics/frame_constants.hpp"
+
+namespace alvere::graphics_api::null
+{
+	class FrameConstants : public alvere::FrameConstants
+	{
+	public:
+		FrameConstants();
+
+	protected:
+		void uploadBlock(const Block & block) override;
+	};
+}
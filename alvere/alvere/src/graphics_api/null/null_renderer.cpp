@@ -0,0 +1,43 @@
+#include "graphics_api/null/null_renderer.hpp"
+
+#include "alvere/graphics/buffers.hpp"
+#include "alvere/graphics/mesh.hpp"
+
+#include "graphics_api/null/null_command_log.hpp"
+
+namespace alvere::graphics_api::null
+{
+	Renderer::Renderer()
+	{ }
+
+	void Renderer::flush()
+	{
+		sortDrawCommands();
+
+		//Stands in for the OpenGL renderer's instance buffer, which gets every model matrix once per flush
+		CommandLog::get().record(CommandLog::CommandType::UploadBuffer, this, m_drawCommands.size() * sizeof(Matrix4));
+
+		for (std::size_t first = 0; first < m_drawCommands.size(); )
+		{
+			std::size_t end = findGroupEnd(first);
+			processDrawGroup(&m_drawCommands[first], end - first);
+			first = end;
+		}
+
+		m_drawCommands.clear();
+	}
+
+	void Renderer::processDrawGroup(const DrawCommand * commands, std::size_t count)
+	{
+		commands[0].material->bind();
+
+		commands[0].material->sendPropertiesToShader();
+
+		commands[0].mesh->GetVertexBuffer()->Bind();
+		commands[0].mesh->GetElementBuffer()->Bind();
+
+		CommandLog::get().record(CommandLog::CommandType::DrawInstanced, commands[0].mesh, 0, (unsigned int)count);
+
+		commands[0].material->unbind();
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "alvere/graphics/renderer.hpp"
+
+namespace alvere::graphics_api::null
+{
+	class Renderer : public alvere::Renderer
+	{
+	public:
+
+		Renderer();
+
+	private:
+
+		void flush() override;
+
+		void processDrawGroup(const DrawCommand * commands, std::size_t count) override;
+	};
+}
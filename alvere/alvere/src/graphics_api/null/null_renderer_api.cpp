@@ -0,0 +1,21 @@
+#include "graphics_api/null/null_renderer_api.hpp"
+
+#include "graphics_api/null/null_command_log.hpp"
+
+namespace alvere::graphics_api::null
+{
+	void RendererAPI::setClearColour(const alvere::Vector4& colour)
+	{
+		CommandLog::get().record(CommandLog::CommandType::SetClearColour, nullptr);
+	}
+
+	void RendererAPI::clear()
+	{
+		CommandLog::get().record(CommandLog::CommandType::Clear, nullptr);
+	}
+
+	void RendererAPI::setViewport(unsigned int x, unsigned int y, unsigned int width, unsigned int height)
+	{
+		CommandLog::get().record(CommandLog::CommandType::SetViewport, nullptr);
+	}
+}
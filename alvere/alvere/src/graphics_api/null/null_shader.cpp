@@ -0,0 +1,15 @@
+#include "graphics_api/null/null_shader.hpp"
+
+namespace alvere::graphics_api::null
+{
+	Shader::Shader(Shader::Type type, const std::string& source)
+		: alvere::Shader(type, source)
+	{
+	}
+
+	bool Shader::Compile() const
+	{
+		m_IsCompiled = true;
+		return true;
+	}
+}
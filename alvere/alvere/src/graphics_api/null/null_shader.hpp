@@ -0,0 +1,15 @@
+#pragma once
+
+#include "alvere/graphics/shader.hpp"
+
+namespace alvere::graphics_api::null
+{
+	class Shader : public alvere::Shader
+	{
+	public:
+		Shader(Shader::Type type, const std::string& source);
+
+		//Always succeeds, the source is never looked at
+		bool Compile() const override;
+	};
+}
@@ -0,0 +1,82 @@
+#include "graphics_api/null/null_shader_program.hpp"
+
+#include "graphics_api/null/null_command_log.hpp"
+
+namespace alvere::graphics_api::null
+{
+	ShaderProgram::ShaderProgram()
+		: alvere::ShaderProgram()
+	{
+	}
+
+	bool ShaderProgram::build()
+	{
+		CommandLog::get().record(CommandLog::CommandType::BuildShaderProgram, this);
+		return true;
+	}
+
+	void ShaderProgram::bind() const
+	{
+		CommandLog::get().record(CommandLog::CommandType::BindShaderProgram, this);
+	}
+
+	void ShaderProgram::unbind() const
+	{
+		CommandLog::get().record(CommandLog::CommandType::BindShaderProgram, nullptr);
+	}
+
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Int> uniform, int value) const
+	{
+		RecordUniform(sizeof(int));
+	}
+
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Int2> uniform, int value1, int value2) const
+	{
+		RecordUniform(sizeof(int) * 2);
+	}
+
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Int3> uniform, int value1, int value2, int value3) const
+	{
+		RecordUniform(sizeof(int) * 3);
+	}
+
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Int4> uniform, int value1, int value2, int value3, int value4) const
+	{
+		RecordUniform(sizeof(int) * 4);
+	}
+
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Float> uniform, float value) const
+	{
+		RecordUniform(sizeof(float));
+	}
+
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Float2> uniform, float value1, float value2) const
+	{
+		RecordUniform(sizeof(float) * 2);
+	}
+
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Float3> uniform, float value1, float value2, float value3) const
+	{
+		RecordUniform(sizeof(float) * 3);
+	}
+
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Float4> uniform, float value1, float value2, float value3, float value4) const
+	{
+		RecordUniform(sizeof(float) * 4);
+	}
+
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Mat4x4> uniform, const Matrix4 & matrix) const
+	{
+		RecordUniform(sizeof(float) * 16);
+	}
+
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Sampler2D> uniform, int textureUnit) const
+	{
+		RecordUniform(sizeof(int));
+	}
+
+	void ShaderProgram::RecordUniform(std::size_t bytes) const
+	{
+		CommandLog::get().record(CommandLog::CommandType::SetUniform, this, bytes);
+	}
+}
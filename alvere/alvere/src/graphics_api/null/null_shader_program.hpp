@@ -0,0 +1,41 @@
+#pragma once
+
+#include "alvere/graphics/shader_program.hpp"
+#include "alvere/math/matrices.hpp"
+
+namespace alvere::graphics_api::null
+{
+	//Uniforms are counted by the size of the values sent, not looked up
+	class ShaderProgram : public alvere::ShaderProgram
+	{
+	public:
+		ShaderProgram();
+
+		bool build() override;
+		void bind() const override;
+		void unbind() const override;
+
+		void sendUniform(UniformHandle<Shader::DataType::Int> uniform, int value) const override;
+
+		void sendUniform(UniformHandle<Shader::DataType::Int2> uniform, int value1, int value2) const override;
+
+		void sendUniform(UniformHandle<Shader::DataType::Int3> uniform, int value1, int value2, int value3) const override;
+
+		void sendUniform(UniformHandle<Shader::DataType::Int4> uniform, int value1, int value2, int value3, int value4) const override;
+
+		void sendUniform(UniformHandle<Shader::DataType::Float> uniform, float value) const override;
+
+		void sendUniform(UniformHandle<Shader::DataType::Float2> uniform, float value1, float value2) const override;
+
+		void sendUniform(UniformHandle<Shader::DataType::Float3> uniform, float value1, float value2, float value3) const override;
+
+		void sendUniform(UniformHandle<Shader::DataType::Float4> uniform, float value1, float value2, float value3, float value4) const override;
+
+		void sendUniform(UniformHandle<Shader::DataType::Mat4x4> uniform, const Matrix4 & matrix) const override;
+
+		void sendUniform(UniformHandle<Shader::DataType::Sampler2D> uniform, int textureUnit) const override;
+
+	private:
+		void RecordUniform(std::size_t bytes) const;
+	};
+}
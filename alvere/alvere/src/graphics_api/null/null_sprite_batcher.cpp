@@ -0,0 +1,117 @@
+#include "graphics_api/null/null_sprite_batcher.hpp"
+
+#include "alvere/graphics/sprite_vertices.hpp"
+#include "graphics_api/null/null_command_log.hpp"
+
+namespace alvere::graphics_api::null
+{
+	SpriteBatcher::SpriteBatcher(unsigned int capacity, VertexFormat vertexFormat)
+		: alvere::SpriteBatcher(capacity, vertexFormat)
+		, m_TexturesCount(0), m_Premultiplied(false)
+	{
+		switch (vertexFormat)
+		{
+		case VertexFormat::Compact: m_SpriteSize = sizeof(CompactSpriteVertex) * 4; break;
+		case VertexFormat::Instanced: m_SpriteSize = sizeof(SpriteInstance); break;
+		default: m_SpriteSize = sizeof(SpriteVertex) * 4; break;
+		}
+
+		m_VertexData.resize(m_Capacity * m_SpriteSize);
+		m_VPtr = m_VertexData.data();
+
+		m_VBO = std::make_unique<VertexBuffer>(nullptr, m_Capacity * m_SpriteSize);
+
+		if (vertexFormat != VertexFormat::Instanced)
+		{
+			//Only the size of the indices is recorded, so there is no need to fill them in
+			m_EBO = std::make_unique<IndexBuffer>((const unsigned int *)nullptr, m_Capacity * 6);
+		}
+	}
+
+	void SpriteBatcher::processDrawCommandData(const DrawSpriteCommand& command)
+	{
+		int textureIndex = -1;
+		for (int idx = 0; idx < m_TexturesCount; idx++)
+		{
+			if (m_Textures[idx] == command.texture)
+			{
+				textureIndex = idx;
+			}
+		}
+
+		if (textureIndex == -1)
+		{
+			//Premultiplied textures are blended differently, so they can't share a draw with straight alpha ones
+			if (m_TexturesCount == ALV_NULL_MAX_TEXTUREUNITS_FRAGMENT || (m_TexturesCount > 0 && command.texture->isPremultiplied() != m_Premultiplied))
+			{
+				flush();
+			}
+
+			if (m_TexturesCount == 0)
+			{
+				m_Premultiplied = command.texture->isPremultiplied();
+			}
+
+			textureIndex = m_TexturesCount;
+			m_Textures[textureIndex] = command.texture;
+			m_TexelScales[textureIndex] = getTexelScale(*command.texture);
+			m_TexturesCount++;
+		}
+
+		Vector4 tint = m_Premultiplied ? premultiplyTint(command.tint) : command.tint;
+
+		switch (m_VertexFormat)
+		{
+		case VertexFormat::Compact:
+			CompactSpriteVertex::writeQuad((CompactSpriteVertex *)m_VPtr, m_TexelScales[textureIndex], command.destination, command.source, tint, command.sortLayer, textureIndex);
+			break;
+
+		case VertexFormat::Instanced:
+			SpriteInstance::write(*(SpriteInstance *)m_VPtr, m_TexelScales[textureIndex], command.destination, command.source, tint, command.sortLayer, textureIndex);
+			break;
+
+		default:
+			SpriteVertex::writeQuad((SpriteVertex *)m_VPtr, *command.texture, command.destination, command.source, tint, command.sortLayer, textureIndex);
+			break;
+		}
+
+		m_VPtr += m_SpriteSize;
+
+		if (++m_SpriteCount == m_Capacity)
+		{
+			flush();
+		}
+	}
+
+	void SpriteBatcher::flush()
+	{
+		m_VBO->SetSubData(0, (const float *)m_VertexData.data(), m_SpriteCount * m_SpriteSize);
+
+		m_ShaderProgram.bind();
+		m_ShaderProgram.sendUniformMat4x4("u_ProjectionView", *m_TransformationMatrix);
+
+		for (int idx = 0; idx < m_TexturesCount; idx++)
+		{
+			m_Textures[idx]->bind();
+		}
+
+		m_VBO->Bind();
+
+		if (m_VertexFormat == VertexFormat::Instanced)
+		{
+			CommandLog::get().record(CommandLog::CommandType::DrawInstanced, this, 0, m_SpriteCount);
+		}
+		else
+		{
+			CommandLog::get().record(CommandLog::CommandType::Draw, this, 0, m_SpriteCount * 6);
+		}
+
+		m_VBO->Unbind();
+
+		m_VPtr = m_VertexData.data();
+		m_SpriteCount = 0;
+		m_TexturesCount = 0;
+
+		++m_FlushCount;
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "alvere/graphics/sprite_batcher.hpp"
+
+#include "graphics_api/null/null_buffers.hpp"
+#include "graphics_api/null/null_shader_program.hpp"
+
+//The same as the OpenGL backend, so batches are split into the same number of draws
+#define ALV_NULL_MAX_TEXTUREUNITS_FRAGMENT 16
+
+namespace alvere::graphics_api::null
+{
+	//Writes sprites into the vertex format it was made with and records what the OpenGL batcher would do with them.
+	//The writing is real, so it costs the same CPU time and uploads the same number of bytes.
+	class SpriteBatcher : public alvere::SpriteBatcher
+	{
+	public:
+		SpriteBatcher(unsigned int capacity, VertexFormat vertexFormat);
+
+	protected:
+		ShaderProgram m_ShaderProgram;
+
+		//Bytes written for each sprite, four vertices or one instance
+		unsigned int m_SpriteSize;
+		std::vector<unsigned char> m_VertexData;
+		unsigned char * m_VPtr;
+		const Texture * m_Textures[ALV_NULL_MAX_TEXTUREUNITS_FRAGMENT];
+		Vector2 m_TexelScales[ALV_NULL_MAX_TEXTUREUNITS_FRAGMENT];
+		int m_TexturesCount;
+		bool m_Premultiplied;
+		std::unique_ptr<VertexBuffer> m_VBO;
+		std::unique_ptr<IndexBuffer> m_EBO;
+
+		void processDrawCommandData(const DrawSpriteCommand& command) override;
+
+		void flush() override;
+	};
+}
@@ -0,0 +1,81 @@
+#include "graphics_api/null/null_static_sprite_batch.hpp"
+
+#include "alvere/graphics/sprite_vertices.hpp"
+#include "graphics_api/null/null_command_log.hpp"
+#include "graphics_api/null/null_sprite_batcher.hpp"
+
+namespace alvere::graphics_api::null
+{
+	void StaticSpriteBatch::upload(const std::vector<StaticSprite> & sprites)
+	{
+		m_DrawRanges.clear();
+		m_VBO.reset();
+
+		if (sprites.empty())
+		{
+			return;
+		}
+
+		std::vector<SpriteInstance> instances(sprites.size());
+
+		for (unsigned int idx = 0; idx < sprites.size(); ++idx)
+		{
+			const StaticSprite & sprite = sprites[idx];
+			bool premultiplied = sprite.texture->isPremultiplied();
+
+			if (m_DrawRanges.empty())
+			{
+				m_DrawRanges.push_back({ idx, 0, {}, premultiplied });
+			}
+
+			int textureIndex = -1;
+			for (int textureIdx = 0; textureIdx < (int)m_DrawRanges.back().textures.size(); ++textureIdx)
+			{
+				if (m_DrawRanges.back().textures[textureIdx] == sprite.texture)
+				{
+					textureIndex = textureIdx;
+				}
+			}
+
+			if (textureIndex == -1)
+			{
+				if (m_DrawRanges.back().textures.size() == ALV_NULL_MAX_TEXTUREUNITS_FRAGMENT || m_DrawRanges.back().premultiplied != premultiplied)
+				{
+					m_DrawRanges.push_back({ idx, 0, {}, premultiplied });
+				}
+
+				textureIndex = (int)m_DrawRanges.back().textures.size();
+				m_DrawRanges.back().textures.push_back(sprite.texture);
+			}
+
+			++m_DrawRanges.back().spriteCount;
+
+			SpriteInstance::write(instances[idx], *sprite.texture, sprite.destination, sprite.source, premultiplied ? premultiplyTint(sprite.tint) : sprite.tint, 0.0f, textureIndex);
+		}
+
+		m_VBO = std::make_unique<VertexBuffer>((const float *)instances.data(), (unsigned int)(instances.size() * sizeof(SpriteInstance)));
+	}
+
+	void StaticSpriteBatch::draw(const Matrix4 & transformationMatrix)
+	{
+		if (m_VBO == nullptr)
+		{
+			return;
+		}
+
+		m_ShaderProgram.bind();
+		m_ShaderProgram.sendUniformMat4x4("u_ProjectionView", transformationMatrix);
+
+		for (const DrawRange & range : m_DrawRanges)
+		{
+			for (const Texture * texture : range.textures)
+			{
+				texture->bind();
+			}
+
+			m_VBO->Bind();
+			CommandLog::get().record(CommandLog::CommandType::DrawInstanced, this, 0, range.spriteCount);
+			m_VBO->Unbind();
+		}
+	}
+}
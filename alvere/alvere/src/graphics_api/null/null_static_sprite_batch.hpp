@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "alvere/graphics/static_sprite_batch.hpp"
+
+#include "graphics_api/null/null_buffers.hpp"
+#include "graphics_api/null/null_shader_program.hpp"
+
+namespace alvere::graphics_api::null
+{
+	class StaticSpriteBatch : public alvere::StaticSpriteBatch
+	{
+	public:
+		void draw(const Matrix4 & transformationMatrix) override;
+
+		unsigned int getDrawCallCount() const override { return (unsigned int)m_DrawRanges.size(); }
+
+	protected:
+		struct DrawRange
+		{
+			unsigned int firstSprite;
+			unsigned int spriteCount;
+			std::vector<const Texture *> textures;
+			bool premultiplied;
+		};
+
+		std::vector<DrawRange> m_DrawRanges;
+
+		ShaderProgram m_ShaderProgram;
+		std::unique_ptr<VertexBuffer> m_VBO;
+
+		void upload(const std::vector<StaticSprite> & sprites) override;
+	};
+}
@@ -0,0 +1,123 @@
+#include "graphics_api/null/null_texture.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "graphics_api/null/null_command_log.hpp"
+
+namespace alvere::graphics_api::null
+{
+	Texture::Texture(const char * filename, Channels channels, bool keepPixelData)
+		: alvere::Texture(filename, channels, keepPixelData)
+	{
+		init();
+	}
+
+	Texture::Texture(const unsigned char * data, int width, int height, Channels channels)
+		: alvere::Texture(data, width, height, channels)
+	{
+		init();
+	}
+
+	Texture::Texture(int width, int height, Channels channels)
+		: alvere::Texture(width, height, channels)
+	{
+		init();
+	}
+
+	Texture::Texture(const alvere::Texture & sourceTexture, alvere::RectI sourceRect)
+		: alvere::Texture(sourceTexture, sourceRect)
+	{
+		init();
+	}
+
+	Texture::Texture(Placeholder placeholder, int width, int height, Channels channels, bool keepPixelData)
+		: alvere::Texture(placeholder, width, height, channels, keepPixelData)
+	{
+		init();
+	}
+
+	void Texture::bind() const
+	{
+		CommandLog::get().record(CommandLog::CommandType::BindTexture, this);
+	}
+
+	void Texture::unbind() const
+	{
+		CommandLog::get().record(CommandLog::CommandType::BindTexture, nullptr);
+	}
+
+	void * Texture::getHandle() const
+	{
+		return nullptr;
+	}
+
+	bool Texture::resize(unsigned int width, unsigned int height)
+	{
+		if (width <= 0 || height <= 0)
+			return false;
+
+		if (restorePixelData() == false)
+			return false;
+
+		unsigned char * newPixelData = (unsigned char *)std::calloc((std::size_t)width * height, m_channelCount);
+
+		if (newPixelData == nullptr)
+			return false;
+
+		int copyWidth = width > (unsigned int)m_dimensions.x ? m_dimensions.x : width;
+
+		for (int y = 0; y < (int)height && y < m_dimensions.y; ++y)
+		{
+			unsigned int start = y * m_dimensions.x;
+
+			std::copy(
+				m_pixelData + start * m_channelCount,
+				m_pixelData + (start + copyWidth) * m_channelCount,
+				newPixelData + (y * width) * m_channelCount);
+		}
+
+		std::free(m_pixelData);
+
+		m_pixelData = newPixelData;
+		m_dimensions.x = width;
+		m_dimensions.y = height;
+
+		CommandLog::get().record(CommandLog::CommandType::UploadTexture, this, (std::size_t)m_dimensions.x * m_dimensions.y * m_channelCount);
+
+		return true;
+	}
+
+	void Texture::uploadPixelData()
+	{
+		//A placeholder is a single texel, as it is for the other backends
+		std::size_t texels = m_pixelData != nullptr ? (std::size_t)m_dimensions.x * m_dimensions.y : 1;
+
+		if (m_mipChain.m_levelCount > 0)
+		{
+			texels = 0;
+			for (uint32_t level = 0; level < m_mipChain.m_levelCount; ++level)
+			{
+				Vec2i dimensions = texture_cache::getLevelDimensions(m_mipChain.m_dimensions, level);
+				texels += (std::size_t)dimensions.x * dimensions.y;
+			}
+		}
+
+		CommandLog::get().record(CommandLog::CommandType::UploadTexture, this, texels * m_channelCount);
+	}
+
+	unsigned char * Texture::readPixelData() const
+	{
+		//Nothing was really uploaded, so there is nothing to read back but a blank texture of the right size
+		if (m_dimensions.x <= 0 || m_dimensions.y <= 0)
+			return nullptr;
+
+		return (unsigned char *)std::calloc((std::size_t)m_dimensions.x * m_dimensions.y, m_channelCount);
+	}
+
+	void Texture::init()
+	{
+		CommandLog::get().record(CommandLog::CommandType::CreateTexture, this);
+		upload();
+	}
+}
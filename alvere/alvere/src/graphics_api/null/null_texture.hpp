@@ -0,0 +1,40 @@
+#pragma once
+
+#include "alvere/graphics/texture.hpp"
+
+namespace alvere::graphics_api::null
+{
+	//Keeps its pixels on the CPU like any other texture, the upload is only recorded
+	class Texture : public alvere::Texture
+	{
+	public:
+		Texture(const char * filename, Channels channels = Channels::RGBAlpha, bool keepPixelData = false);
+
+		Texture(const unsigned char * data, int width, int height, Channels channels = Channels::RGBAlpha);
+
+		Texture(int width, int height, Channels channels = Channels::RGBAlpha);
+
+		Texture(const alvere::Texture & sourceTexture, alvere::RectI sourceRect);
+
+		Texture(Placeholder placeholder, int width, int height, Channels channels = Channels::RGBAlpha, bool keepPixelData = false);
+
+		void bind() const override;
+
+		void unbind() const override;
+
+		//There is nothing for a GPU API to refer to
+		void * getHandle() const override;
+
+		bool resize(unsigned int width, unsigned int height) override;
+
+	protected:
+
+		void uploadPixelData() override;
+
+		unsigned char * readPixelData() const override;
+
+	private:
+
+		void init();
+	};
+}
@@ -2,6 +2,7 @@
 
 #include "graphics_api/opengl/opengl_buffers.hpp"
 #include "graphics_api/opengl/opengl_errors.hpp"
+#include "graphics_api/opengl/opengl_state_cache.hpp"
 
 namespace alvere::graphics_api::opengl
 {
@@ -19,70 +20,73 @@ namespace alvere::graphics_api::opengl
 
 	VertexBuffer::~VertexBuffer()
 	{
-		glDeleteBuffers(1, &m_Handle);
+		StateCache::get().deleteBuffer(m_Handle);
 	}
 
+	//Left bound afterwards, so uploading to the same buffer again doesn't bind it again
 	void VertexBuffer::SetData(const float * vertexData, unsigned int size)
 	{
 		m_Size = size;
-		glBindBuffer(GL_ARRAY_BUFFER, m_Handle);
+		StateCache::get().bindBuffer(GL_ARRAY_BUFFER, m_Handle);
 		ALV_LOG_OPENGL_CALL(glBufferData(GL_ARRAY_BUFFER, size, vertexData, GL_DYNAMIC_DRAW));
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	void VertexBuffer::SetSubData(unsigned int offset, const float * vertexData, unsigned int size)
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_Handle);
+		StateCache::get().bindBuffer(GL_ARRAY_BUFFER, m_Handle);
 		ALV_LOG_OPENGL_CALL(glBufferSubData(GL_ARRAY_BUFFER, offset, size, vertexData));
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	void VertexBuffer::Bind()
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_Handle);
+		StateCache::get().bindBuffer(GL_ARRAY_BUFFER, m_Handle);
 	}
 
 	void VertexBuffer::Unbind()
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		StateCache::get().bindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	IndexBuffer::IndexBuffer(const unsigned int * indices, unsigned int count)
+	{
+		Create(indices, count, sizeof(unsigned int));
+	}
+
+	IndexBuffer::IndexBuffer(const unsigned short * indices, unsigned int count)
+	{
+		Create(indices, count, sizeof(unsigned short));
+	}
+
+	void IndexBuffer::Create(const void * indices, unsigned int count, unsigned int indexSize)
 	{
 		m_Count = count;
+		m_IndexSize = indexSize;
 		glGenBuffers(1, &m_Handle);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Handle);
-		ALV_LOG_OPENGL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), indices, GL_STATIC_DRAW));
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+		//The element array binding belongs to the vertex array, so one left bound by a draw would pick this buffer up
+		StateCache::get().bindVertexArray(0);
+		StateCache::get().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Handle);
+		ALV_LOG_OPENGL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)count * indexSize, indices, GL_STATIC_DRAW));
+		StateCache::get().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
+	unsigned int IndexBuffer::GetIndexType() const
+	{
+		return m_IndexSize == sizeof(unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
 	}
 
 	IndexBuffer::~IndexBuffer()
 	{
-		glDeleteBuffers(1, &m_Handle);
+		StateCache::get().deleteBuffer(m_Handle);
 	}
 
 	void IndexBuffer::Bind()
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Handle);
+		StateCache::get().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Handle);
 	}
 
 	void IndexBuffer::Unbind()
 	{
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		StateCache::get().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 }
-
-alvere::VertexBuffer * alvere::VertexBuffer::New()
-{
-	return new alvere::graphics_api::opengl::VertexBuffer();
-}
-
-alvere::VertexBuffer * alvere::VertexBuffer::New(const float * vertexData, unsigned int size)
-{
-	return new alvere::graphics_api::opengl::VertexBuffer(vertexData, size);
-}
-
-alvere::IndexBuffer * alvere::IndexBuffer::New(const unsigned int * indices, unsigned int size)
-{
-	return new alvere::graphics_api::opengl::IndexBuffer(indices, size);
-}
\ No newline at end of file
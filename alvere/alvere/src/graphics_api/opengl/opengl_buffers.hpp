@@ -16,6 +16,11 @@ namespace alvere::graphics_api::opengl
 		void Bind() override;
 		void Unbind() override;
 
+		inline unsigned int GetHandle() const
+		{
+			return m_Handle;
+		}
+
 	private:
 		unsigned int m_Handle;
 	};
@@ -24,12 +29,18 @@ namespace alvere::graphics_api::opengl
 	{
 	public:
 		IndexBuffer(const unsigned int * indices, unsigned int count);
+		IndexBuffer(const unsigned short * indices, unsigned int count);
 		~IndexBuffer();
 
 		void Bind() override;
 		void Unbind() override;
 
+		//GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, for drawing with
+		unsigned int GetIndexType() const;
+
 	private:
 		unsigned int m_Handle;
+
+		void Create(const void * indices, unsigned int count, unsigned int indexSize);
 	};
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "alvere/debug/exceptions.hpp"
 #include "alvere/debug/logging.hpp"
 #include "alvere/graphics/shader.hpp"
+#include "graphics_api/opengl/opengl_state_cache.hpp"
 
 namespace alvere::graphics_api::opengl
 {
@@ -19,8 +20,8 @@ namespace alvere::graphics_api::opengl
 
 	RenderingContext::~RenderingContext()
 	{
-		glDeleteVertexArrays(1, &m_screenQuadVAOHandle);
-		glDeleteBuffers(1, &m_screenQuadVBOHandle);
+		StateCache::get().deleteVertexArray(m_screenQuadVAOHandle);
+		StateCache::get().deleteBuffer(m_screenQuadVBOHandle);
 	}
 
 	void RenderingContext::init(int width, int height)
@@ -81,10 +82,10 @@ namespace alvere::graphics_api::opengl
 		};
 
 		glGenVertexArrays(1, &m_screenQuadVAOHandle);
-		glBindVertexArray(m_screenQuadVAOHandle);
+		StateCache::get().bindVertexArray(m_screenQuadVAOHandle);
 
 		glGenBuffers(1, &m_screenQuadVBOHandle);
-		glBindBuffer(GL_ARRAY_BUFFER, m_screenQuadVBOHandle);
+		StateCache::get().bindBuffer(GL_ARRAY_BUFFER, m_screenQuadVBOHandle);
 
 		glBufferData(GL_ARRAY_BUFFER, sizeof(screenQuadVertices), &screenQuadVertices, GL_STATIC_DRAW);
 
@@ -92,6 +93,8 @@ namespace alvere::graphics_api::opengl
 		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
 		glEnableVertexAttribArray(1);
 		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)(2 * sizeof(float)));
+
+		StateCache::get().bindVertexArray(0);
 	}
 
 	void RenderingContext::renderFrameBuffer()
@@ -101,17 +104,17 @@ namespace alvere::graphics_api::opengl
 		// bind the shader that draws the screen quad
 		m_screenQuadShaderProgram->bind();
 
+		StateCache::get().setCapability(GL_BLEND, false);
+
 		// send framebuffer texture to shader
-		glActiveTexture(GL_TEXTURE0);
+		StateCache::get().activeTexture(0);
 		m_frameBuffer->getTexture().bind();
 
 		// bind the vao with the screen quad
-		glBindVertexArray(m_screenQuadVAOHandle);
+		StateCache::get().bindVertexArray(m_screenQuadVAOHandle);
 		glDrawArrays(GL_TRIANGLES, 0, 6);
-		glBindVertexArray(0);
-
-		m_frameBuffer->getTexture().unbind();
 
-		m_screenQuadShaderProgram->unbind();
+		// the screen quad is the last thing drawn each frame
+		StateCache::get().endFrame();
 	}
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "alvere/debug/logging.hpp"
 
 #include "graphics_api/opengl/opengl_errors.hpp"
+#include "graphics_api/opengl/opengl_state_cache.hpp"
 
 namespace alvere::graphics_api::opengl
 {
@@ -26,7 +27,7 @@ namespace alvere::graphics_api::opengl
 	FrameBuffer::~FrameBuffer()
 	{
 		glDeleteRenderbuffers(1, &m_depthStencilBufferHandle);
-		glDeleteFramebuffers(1, &m_handle);
+		StateCache::get().deleteFrameBuffer(m_handle);
 	}
 
 	FrameBuffer& FrameBuffer::operator=(const FrameBuffer& frameBuffer)
@@ -48,21 +49,21 @@ namespace alvere::graphics_api::opengl
 
 	void FrameBuffer::bind() const
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_handle);
+		StateCache::get().bindFrameBuffer(m_handle);
 	}
 
 	void FrameBuffer::unbind() const
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		StateCache::get().bindFrameBuffer(0);
 	}
 
 	void FrameBuffer::init(unsigned int width, unsigned int height)
 	{
-		glDeleteFramebuffers(1, &m_handle);
+		StateCache::get().deleteFrameBuffer(m_handle);
 		glDeleteRenderbuffers(1, &m_depthStencilBufferHandle);
 
 		glGenFramebuffers(1, &m_handle);
-		glBindFramebuffer(GL_FRAMEBUFFER, m_handle);
+		StateCache::get().bindFrameBuffer(m_handle);
 
 		m_texture = Texture::New(width, height, Texture::Channels::RGB);
 		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, (unsigned int)m_texture->getHandle(), 0);
@@ -78,9 +79,9 @@ namespace alvere::graphics_api::opengl
 
 	void FrameBuffer::checkCompleteness()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_handle);
+		StateCache::get().bindFrameBuffer(m_handle);
 		unsigned int status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		StateCache::get().bindFrameBuffer(0);
 
 		switch (status)
 		{
@@ -96,8 +97,3 @@ namespace alvere::graphics_api::opengl
 		}
 	}
 }
-
-std::unique_ptr<alvere::FrameBuffer> alvere::FrameBuffer::create(unsigned int width, unsigned int height)
-{
-	return std::make_unique<alvere::graphics_api::opengl::FrameBuffer>(width, height);
-}
\ No newline at end of file
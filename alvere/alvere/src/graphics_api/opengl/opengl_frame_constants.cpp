@@ -0,0 +1,29 @@
+#include "graphics_api/opengl/opengl_frame_constants.hpp"
+
+#include <glad/glad.h>
+
+#include "graphics_api/opengl/opengl_state_cache.hpp"
+
+namespace alvere::graphics_api::opengl
+{
+	FrameConstants::FrameConstants()
+	{
+		glGenBuffers(1, &m_Handle);
+
+		StateCache::get().bindBuffer(GL_UNIFORM_BUFFER, m_Handle);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(Block), nullptr, GL_DYNAMIC_DRAW);
+
+		glBindBufferBase(GL_UNIFORM_BUFFER, ALV_FRAME_CONSTANTS_BINDING, m_Handle);
+	}
+
+	FrameConstants::~FrameConstants()
+	{
+		StateCache::get().deleteBuffer(m_Handle);
+	}
+
+	void FrameConstants::uploadBlock(const Block & block)
+	{
+		StateCache::get().bindBuffer(GL_UNIFORM_BUFFER, m_Handle);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Block), &block);
+	}
+}
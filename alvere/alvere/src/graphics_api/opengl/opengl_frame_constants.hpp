@@ -0,0 +1,20 @@
+#pragma once
+
+#include "alvere/graphics/frame_constants.hpp"
+
+namespace alvere::graphics_api::opengl
+{
+	//The buffer stays bound to its binding point for its whole life, so drawing never has to bind it
+	class FrameConstants : public alvere::FrameConstants
+	{
+	public:
+		FrameConstants();
+		~FrameConstants();
+
+	protected:
+		void uploadBlock(const Block & block) override;
+
+	private:
+		unsigned int m_Handle;
+	};
+}
@@ -6,46 +6,121 @@
 #include "alvere/utils/file_reader.hpp"
 
 #include "graphics_api/opengl/opengl_errors.hpp"
+#include "graphics_api/opengl/opengl_state_cache.hpp"
 
 namespace alvere::graphics_api::opengl
 {
+	BufferLayout Renderer::s_instanceDataLayout = {
+		BufferElementProperties{Shader::DataType::Float4, "a_modelMatrix[0]" },
+		BufferElementProperties{Shader::DataType::Float4, "a_modelMatrix[1]" },
+		BufferElementProperties{Shader::DataType::Float4, "a_modelMatrix[2]" },
+		BufferElementProperties{Shader::DataType::Float4, "a_modelMatrix[3]" }, };
+
 	Renderer::Renderer()
-	{ }
+		: m_instanceBuffer(std::make_unique<VertexBuffer>()), m_firstInstance(0), m_currentMesh(nullptr), m_currentMaterial(nullptr), m_depthWritesDisabled(false), m_currentShaderProgram(nullptr)
+	{
+		m_instanceBuffer->SetLayout(s_instanceDataLayout);
+		m_VAO.AddInstanceBuffer(m_instanceBuffer.get(), ALV_RENDERER_MODEL_MATRIX_LOCATION);
+	}
 
 	void Renderer::flush()
 	{
 		sortDrawCommands();
 
-		for (const DrawCommand & command : m_drawCommands)
-			processDrawCommand(command);
+		m_instanceData.resize(m_drawCommands.size());
+		for (std::size_t idx = 0; idx < m_drawCommands.size(); ++idx)
+			m_instanceData[idx] = m_drawCommands[idx].m_localTransform;
+
+		//Given new storage every flush, so the driver doesn't wait for the last flush's draws to finish reading it
+		m_instanceBuffer->SetData(&m_instanceData[0][0][0], (unsigned int)(m_instanceData.size() * sizeof(Matrix4)));
+
+		//Meshes can be destroyed between flushes and their buffers' names reused, so the vertex array is always set up again for the first draw
+		m_currentMesh = nullptr;
+		m_currentMaterial = nullptr;
+		m_currentShaderProgram = nullptr;
+
+		for (std::size_t first = 0; first < m_drawCommands.size(); )
+		{
+			std::size_t end = findGroupEnd(first);
+
+			m_firstInstance = first;
+			processDrawGroup(&m_drawCommands[first], end - first);
+
+			first = end;
+		}
+
+		if (m_depthWritesDisabled)
+		{
+			glDepthMask(GL_TRUE);
+			m_depthWritesDisabled = false;
+		}
 
 		m_drawCommands.clear();
 	}
 
-	void Renderer::processDrawCommand(const DrawCommand & command)
+	void Renderer::processDrawGroup(const DrawCommand * commands, std::size_t count)
 	{
-		glEnable(GL_DEPTH_TEST);
+		StateCache & stateCache = StateCache::get();
 
-		command.material->bind();
+		bool transparent = getSortKeyPass(commands[0].m_sortKey) == Pass::Transparent;
 
-		command.material->getBaseMaterial()->getShaderProgram()->sendUniformMat4x4("u_projectionMatrix", *m_projectionMatrix);
-		command.material->getBaseMaterial()->getShaderProgram()->sendUniformMat4x4("u_viewMatrix", *m_viewMatrix);
-		command.material->getBaseMaterial()->getShaderProgram()->sendUniformMat4x4("u_modelMatrix", command.m_localTransform);
+		stateCache.setCapability(GL_BLEND, transparent);
+		stateCache.setCapability(GL_DEPTH_TEST, true);
 
-		glActiveTexture(GL_TEXTURE0);
-		command.material->sendPropertiesToShader();
+		//Transparent draws come after every opaque one, so this only changes once per flush
+		if (transparent && m_depthWritesDisabled == false)
+		{
+			stateCache.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			glDepthMask(GL_FALSE);
+			m_depthWritesDisabled = true;
+		}
 
-		m_VAO.AddVertexBuffer(command.mesh->GetVertexBuffer());
-		m_VAO.SetIndexBuffer(command.mesh->GetElementBuffer());
-		m_VAO.Bind();
+		const Mesh * mesh = commands[0].mesh;
+		const MaterialInstance * material = commands[0].material;
 
-		ALV_LOG_OPENGL_CALL(glDrawElements(GL_TRIANGLES, command.mesh->GetElementBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr));
+		material->bind();
 
-		command.material->unbind();
+		const alvere::ShaderProgram * shaderProgram = material->getBaseMaterial()->getShaderProgram();
+		if (shaderProgram != m_currentShaderProgram)
+		{
+			m_modelMatrixUniform = shaderProgram->getUniform<Shader::DataType::Mat4x4>("u_modelMatrix");
+			m_currentShaderProgram = shaderProgram;
+		}
+
+		if (material != m_currentMaterial)
+		{
+			stateCache.activeTexture(0);
+			material->sendPropertiesToShader();
+			m_currentMaterial = material;
+		}
+
+		if (mesh != m_currentMesh)
+		{
+			m_VAO.SetVertexBuffer(mesh->GetVertexBuffer());
+			m_VAO.SetIndexBuffer(mesh->GetElementBuffer());
+			m_currentMesh = mesh;
+		}
+
+		const IndexBuffer * elementBuffer = (const IndexBuffer *)mesh->GetElementBuffer();
+		GLsizei indexCount = elementBuffer->GetCount();
+		GLenum indexType = elementBuffer->GetIndexType();
+
+		//The camera comes from the frame constants, uploaded once by begin(), so only the model matrix is per draw
+		if (m_modelMatrixUniform.isValid())
+		{
+			m_VAO.Bind();
+
+			for (std::size_t idx = 0; idx < count; ++idx)
+			{
+				shaderProgram->sendUniform(m_modelMatrixUniform, commands[idx].m_localTransform);
+				ALV_LOG_OPENGL_CALL(glDrawElements(GL_TRIANGLES, indexCount, indexType, nullptr));
+			}
+			return;
+		}
+
+		m_VAO.SetInstanceOffset(m_instanceBuffer.get(), (unsigned int)m_firstInstance, ALV_RENDERER_MODEL_MATRIX_LOCATION);
+		m_VAO.Bind();
+
+		ALV_LOG_OPENGL_CALL(glDrawElementsInstanced(GL_TRIANGLES, indexCount, indexType, nullptr, (GLsizei)count));
 	}
 }
-
-alvere::Renderer* alvere::Renderer::New()
-{
-	return new alvere::graphics_api::opengl::Renderer();
-}
\ No newline at end of file
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "alvere/graphics/renderer.hpp"
 
+#include "graphics_api/opengl/opengl_buffers.hpp"
 #include "graphics_api/opengl/opengl_shader_program.hpp"
 #include "graphics_api/opengl/opengl_vertex_array.hpp"
 
 namespace alvere::graphics_api::opengl
 {
+	//Every command's model matrix is uploaded into one instance buffer per flush, in sorted order. A group of draws
+	//sharing a mesh and material is then a single instanced draw, pointed at its run of matrices.
 	class Renderer : public alvere::Renderer
 	{
 	public:
@@ -15,10 +21,32 @@ namespace alvere::graphics_api::opengl
 
 	private:
 
+		static BufferLayout s_instanceDataLayout;
+
 		VertexArray m_VAO;
 
+		std::unique_ptr<VertexBuffer> m_instanceBuffer;
+
+		std::vector<Matrix4> m_instanceData;
+
+		//Where the group being drawn starts in the instance buffer
+		std::size_t m_firstInstance;
+
+		//The mesh the vertex array points at
+		const Mesh * m_currentMesh;
+
+		//The material whose properties were last sent, since runs of its draws are sorted together
+		const MaterialInstance * m_currentMaterial;
+
+		//Transparent draws don't write depth, and it has to be turned back on before anything clears it
+		bool m_depthWritesDisabled;
+
+		//The program the uniform handles below were got from
+		const alvere::ShaderProgram * m_currentShaderProgram;
+		UniformHandle<Shader::DataType::Mat4x4> m_modelMatrixUniform;
+
 		void flush() override;
 
-		void processDrawCommand(const DrawCommand & command) override;
+		void processDrawGroup(const DrawCommand * commands, std::size_t count) override;
 	};
-}
\ No newline at end of file
+}
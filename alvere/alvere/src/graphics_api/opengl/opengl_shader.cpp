@@ -56,8 +56,3 @@ namespace alvere::graphics_api::opengl
 		return true;
 	}
 }
-
-std::unique_ptr<alvere::Shader> alvere::Shader::New(Shader::Type type, const std::string& source = "")
-{
-	return std::make_unique<alvere::graphics_api::opengl::Shader>(type, source);
-}
\ No newline at end of file
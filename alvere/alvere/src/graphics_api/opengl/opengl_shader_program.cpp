@@ -3,8 +3,11 @@
 #include "graphics_api/opengl/opengl_shader_program.hpp"
 
 #include <glad/glad.h>
+#include <vector>
 
 #include "alvere/debug/logging.hpp"
+#include "alvere/graphics/frame_constants.hpp"
+#include "graphics_api/opengl/opengl_state_cache.hpp"
 
 
 namespace alvere::graphics_api::opengl
@@ -17,7 +20,7 @@ namespace alvere::graphics_api::opengl
 
 	ShaderProgram::~ShaderProgram()
 	{
-		glDeleteProgram(m_handle);
+		StateCache::get().deleteProgram(m_handle);
 	}
 
 	bool ShaderProgram::build()
@@ -37,7 +40,16 @@ namespace alvere::graphics_api::opengl
 		glGetProgramiv(m_handle, GL_LINK_STATUS, (int*)&isLinked);
 
 		if (isLinked == GL_TRUE)
+		{
+			ReflectUniforms();
+
+			//Programs that read the frame constants all share the one buffer bound at their binding point
+			GLuint frameConstantsIndex = glGetUniformBlockIndex(m_handle, ALV_FRAME_CONSTANTS_BLOCK_NAME);
+			if (frameConstantsIndex != GL_INVALID_INDEX)
+				glUniformBlockBinding(m_handle, frameConstantsIndex, ALV_FRAME_CONSTANTS_BINDING);
+
 			return true;
+		}
 
 		GLint maxLength = 0;
 		glGetProgramiv(m_handle, GL_INFO_LOG_LENGTH, &maxLength);
@@ -53,75 +65,141 @@ namespace alvere::graphics_api::opengl
 
 	void ShaderProgram::bind() const
 	{
-		glUseProgram(m_handle);
+		StateCache::get().useProgram(m_handle);
 	}
 
 	void ShaderProgram::unbind() const
 	{
-		glUseProgram(0);
+		StateCache::get().useProgram(0);
 	}
 
-	void ShaderProgram::sendUniformInt1(const std::string & id, int value) const
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Int> uniform, int value) const
 	{
-		int loc = GetUniformLocation(id);
-		glUniform1i(loc, value);
+		if (uniform.isValid())
+			glUniform1i(uniform.getLocation(), value);
 	}
 
-	void ShaderProgram::sendUniformInt2(const std::string & id, int value1, int value2) const
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Int2> uniform, int value1, int value2) const
 	{
-		int loc = GetUniformLocation(id);
-		glUniform2i(loc, value1, value2);
+		if (uniform.isValid())
+			glUniform2i(uniform.getLocation(), value1, value2);
 	}
 
-	void ShaderProgram::sendUniformInt3(const std::string & id, int value1, int value2, int value3) const
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Int3> uniform, int value1, int value2, int value3) const
 	{
-		int loc = GetUniformLocation(id);
-		glUniform3i(loc, value1, value2, value3);
+		if (uniform.isValid())
+			glUniform3i(uniform.getLocation(), value1, value2, value3);
 	}
 
-	void ShaderProgram::sendUniformInt4(const std::string & id, int value1, int value2, int value3, int value4) const
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Int4> uniform, int value1, int value2, int value3, int value4) const
 	{
-		int loc = GetUniformLocation(id);
-		glUniform4i(loc, value1, value2, value3, value4);
+		if (uniform.isValid())
+			glUniform4i(uniform.getLocation(), value1, value2, value3, value4);
 	}
 
-	void ShaderProgram::sendUniformFloat1(const std::string & id, float value) const
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Float> uniform, float value) const
 	{
-		int loc = GetUniformLocation(id);
-		glUniform1f(loc, value);
+		if (uniform.isValid())
+			glUniform1f(uniform.getLocation(), value);
 	}
 
-	void ShaderProgram::sendUniformFloat2(const std::string & id, float value1, float value2) const
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Float2> uniform, float value1, float value2) const
 	{
-		int loc = GetUniformLocation(id);
-		glUniform2f(loc, value1, value2);
+		if (uniform.isValid())
+			glUniform2f(uniform.getLocation(), value1, value2);
 	}
 
-	void ShaderProgram::sendUniformFloat3(const std::string & id, float value1, float value2, float value3) const
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Float3> uniform, float value1, float value2, float value3) const
 	{
-		int loc = GetUniformLocation(id);
-		glUniform3f(loc, value1, value2, value3);
+		if (uniform.isValid())
+			glUniform3f(uniform.getLocation(), value1, value2, value3);
 	}
 
-	void ShaderProgram::sendUniformFloat4(const std::string & id, float value1, float value2, float value3, float value4) const
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Float4> uniform, float value1, float value2, float value3, float value4) const
 	{
-		int loc = GetUniformLocation(id);
-		glUniform4f(loc, value1, value2, value3, value4);
+		if (uniform.isValid())
+			glUniform4f(uniform.getLocation(), value1, value2, value3, value4);
 	}
 
-	void ShaderProgram::sendUniformMat4x4(const std::string & id, const alvere::Matrix4 & matrix) const
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Mat4x4> uniform, const alvere::Matrix4 & matrix) const
 	{
-		int loc = GetUniformLocation(id);
-		glUniformMatrix4fv(loc, 1, false, &matrix[0][0]);
+		if (uniform.isValid())
+			glUniformMatrix4fv(uniform.getLocation(), 1, false, &matrix[0][0]);
 	}
 
-	int ShaderProgram::GetUniformLocation(const std::string & id) const
+	void ShaderProgram::sendUniform(UniformHandle<Shader::DataType::Sampler2D> uniform, int textureUnit) const
 	{
-		return glGetUniformLocation(m_handle, id.c_str());
+		if (uniform.isValid())
+			glUniform1i(uniform.getLocation(), textureUnit);
 	}
-}
 
-std::unique_ptr<alvere::ShaderProgram> alvere::ShaderProgram::New()
-{
-	return std::make_unique<alvere::graphics_api::opengl::ShaderProgram>();
-}
\ No newline at end of file
+	static bool GetUniformDataType(GLenum type, Shader::DataType & dataType)
+	{
+		switch (type)
+		{
+		case GL_FLOAT: dataType = Shader::DataType::Float; return true;
+		case GL_FLOAT_VEC2: dataType = Shader::DataType::Float2; return true;
+		case GL_FLOAT_VEC3: dataType = Shader::DataType::Float3; return true;
+		case GL_FLOAT_VEC4: dataType = Shader::DataType::Float4; return true;
+		case GL_INT: dataType = Shader::DataType::Int; return true;
+		case GL_INT_VEC2: dataType = Shader::DataType::Int2; return true;
+		case GL_INT_VEC3: dataType = Shader::DataType::Int3; return true;
+		case GL_INT_VEC4: dataType = Shader::DataType::Int4; return true;
+		case GL_FLOAT_MAT4: dataType = Shader::DataType::Mat4x4; return true;
+		case GL_SAMPLER_2D: dataType = Shader::DataType::Sampler2D; return true;
+		case GL_UNSIGNED_INT: dataType = Shader::DataType::UInt; return true;
+		}
+		return false;
+	}
+
+	void ShaderProgram::ReflectUniforms()
+	{
+		m_uniforms.clear();
+
+		GLint uniformCount = 0;
+		glGetProgramiv(m_handle, GL_ACTIVE_UNIFORMS, &uniformCount);
+
+		GLint maxNameLength = 0;
+		glGetProgramiv(m_handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+		std::vector<GLchar> nameBuffer(maxNameLength + 1);
+
+		for (GLint index = 0; index < uniformCount; ++index)
+		{
+			GLsizei nameLength = 0;
+			GLint arraySize = 0;
+			GLenum type = 0;
+			glGetActiveUniform(m_handle, (GLuint)index, (GLsizei)nameBuffer.size(), &nameLength, &arraySize, &type, nameBuffer.data());
+
+			Shader::DataType dataType;
+			if (GetUniformDataType(type, dataType) == false)
+				continue;
+
+			std::string name(nameBuffer.data(), nameLength);
+
+			//Uniform blocks' members have no location
+			GLint location = glGetUniformLocation(m_handle, name.c_str());
+			if (location < 0)
+				continue;
+
+			if (arraySize <= 1)
+			{
+				m_uniforms[name] = Uniform{ dataType, location };
+				continue;
+			}
+
+			//Arrays are reported as "name[0]". Every element gets its own entry, and the bare name refers to the first.
+			std::string baseName = name.substr(0, name.find('['));
+			m_uniforms[baseName] = Uniform{ dataType, location };
+
+			for (GLint element = 0; element < arraySize; ++element)
+			{
+				std::string elementName = baseName + "[" + std::to_string(element) + "]";
+				GLint elementLocation = glGetUniformLocation(m_handle, elementName.c_str());
+
+				if (elementLocation >= 0)
+					m_uniforms[elementName] = Uniform{ dataType, elementLocation };
+			}
+		}
+	}
+}
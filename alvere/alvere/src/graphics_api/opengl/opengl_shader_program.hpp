@@ -15,25 +15,28 @@ namespace alvere::graphics_api::opengl
 		void bind() const override;
 		void unbind() const override;
 
-		void sendUniformInt1(const std::string & id, int value) const override;
+		void sendUniform(UniformHandle<Shader::DataType::Int> uniform, int value) const override;
 
-		void sendUniformInt2(const std::string & id, int value1, int value2) const override;
+		void sendUniform(UniformHandle<Shader::DataType::Int2> uniform, int value1, int value2) const override;
 
-		void sendUniformInt3(const std::string & id, int value1, int value2, int value3) const override;
+		void sendUniform(UniformHandle<Shader::DataType::Int3> uniform, int value1, int value2, int value3) const override;
 
-		void sendUniformInt4(const std::string & id, int value1, int value2, int value3, int value4) const override;
+		void sendUniform(UniformHandle<Shader::DataType::Int4> uniform, int value1, int value2, int value3, int value4) const override;
 
-		void sendUniformFloat1(const std::string & id, float value) const override;
+		void sendUniform(UniformHandle<Shader::DataType::Float> uniform, float value) const override;
 
-		void sendUniformFloat2(const std::string & id, float value1, float value2) const override;
+		void sendUniform(UniformHandle<Shader::DataType::Float2> uniform, float value1, float value2) const override;
 
-		void sendUniformFloat3(const std::string & id, float value1, float value2, float value3) const override;
+		void sendUniform(UniformHandle<Shader::DataType::Float3> uniform, float value1, float value2, float value3) const override;
 
-		void sendUniformFloat4(const std::string & id, float value1, float value2, float value3, float value4) const override;
+		void sendUniform(UniformHandle<Shader::DataType::Float4> uniform, float value1, float value2, float value3, float value4) const override;
 
-		void sendUniformMat4x4(const std::string & id, const Matrix4 & matrix) const override;
+		void sendUniform(UniformHandle<Shader::DataType::Mat4x4> uniform, const Matrix4 & matrix) const override;
+
+		void sendUniform(UniformHandle<Shader::DataType::Sampler2D> uniform, int textureUnit) const override;
 
 	private:
-		int GetUniformLocation(const std::string & id) const;
+		//Fills the uniform table with every active uniform of the linked program
+		void ReflectUniforms();
 	};
 }
\ No newline at end of file
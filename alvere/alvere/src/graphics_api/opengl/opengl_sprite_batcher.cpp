@@ -1,16 +1,19 @@
 #include "graphics_api/opengl/opengl_sprite_batcher.hpp"
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 
 #include <glad/glad.h>
 
+#include "alvere/graphics/sprite_vertices.hpp"
 #include "alvere/utils/file_reader.hpp"
 #include "graphics_api/opengl/opengl_errors.hpp"
+#include "graphics_api/opengl/opengl_state_cache.hpp"
 #include "graphics_api/opengl/opengl_vertex_array.hpp"
 
 #define ALV_STRINGIFY(x) #x
 #define ALV_STRINGIFY2(x) ALV_STRINGIFY(x)
-#define ALV_OPENGL_MAX_TEXTUREUNITS_FRAGMENT 16
 
 namespace alvere::graphics_api::opengl
 {
@@ -20,37 +23,103 @@ namespace alvere::graphics_api::opengl
 		BufferElementProperties{Shader::DataType::Float4, "a_Colour" },
 		BufferElementProperties{Shader::DataType::Int, "a_TextureIndex" }, };
 
-	unsigned int SpriteBatcher::s_Indices[ALV_MAX_SPRITEBATCH_SPRITES * 6];
+	BufferLayout SpriteBatcher::s_compactVertexDataLayout = {
+		BufferElementProperties{Shader::DataType::Float2, "a_Position" },
+		BufferElementProperties{Shader::DataType::UShort2, "a_TexCoords", true },
+		BufferElementProperties{Shader::DataType::UByte4, "a_Colour", true },
+		BufferElementProperties{Shader::DataType::UInt, "a_TextureIndexAndLayer" }, };
+
+	BufferLayout SpriteBatcher::s_instanceDataLayout = {
+		BufferElementProperties{Shader::DataType::Float4, "a_Destination" },
+		BufferElementProperties{Shader::DataType::UShort4, "a_TexCoords", true },
+		BufferElementProperties{Shader::DataType::UByte4, "a_Colour", true },
+		BufferElementProperties{Shader::DataType::UInt, "a_TextureIndexAndLayer" }, };
 
 	std::unique_ptr<Shader> SpriteBatcher::s_vertexShader;
+	std::unique_ptr<Shader> SpriteBatcher::s_compactVertexShader;
+	std::unique_ptr<Shader> SpriteBatcher::s_instancedVertexShader;
 	std::unique_ptr<Shader> SpriteBatcher::s_fragmentShader;
 	std::unique_ptr<ShaderProgram> SpriteBatcher::s_shaderProgram;
+	std::unique_ptr<ShaderProgram> SpriteBatcher::s_compactShaderProgram;
+	std::unique_ptr<ShaderProgram> SpriteBatcher::s_instancedShaderProgram;
 
-	SpriteBatcher::SpriteBatcher()
-		: m_VPtr(m_VertexData), m_TexturesCount(0)
+	SpriteBatcher::SpriteBatcher(unsigned int capacity, VertexFormat vertexFormat)
+		: alvere::SpriteBatcher(capacity, vertexFormat)
+		, m_VertexDataLayout(GetLayout(vertexFormat))
+		, m_TexturesCount(0), m_Premultiplied(false), m_RegionFences{}, m_Region(0), m_RegionCursor(0), m_FirstSprite(0)
 	{
 		if (s_shaderProgram == nullptr)
 		{
 			InitStatic();
 		}
 
-		int texCount = ALV_OPENGL_MAX_TEXTUREUNITS_FRAGMENT;
+		switch (vertexFormat)
+		{
+		case VertexFormat::Compact: m_ShaderProgram = s_compactShaderProgram.get(); break;
+		case VertexFormat::Instanced: m_ShaderProgram = s_instancedShaderProgram.get(); break;
+		default: m_ShaderProgram = s_shaderProgram.get(); break;
+		}
+
+		m_ProjectionViewUniform = m_ShaderProgram->getUniform<Shader::DataType::Mat4x4>("u_ProjectionView");
+
 		m_Textures = new const Texture *[ALV_OPENGL_MAX_TEXTUREUNITS_FRAGMENT];
 
-		m_VBO = alvere::VertexBuffer::New(m_VertexData, sizeof(m_VertexData));
-		m_VBO->SetLayout(s_vertexDataLayout);
+		m_SpriteSize = m_VertexDataLayout.GetStride() * (vertexFormat == VertexFormat::Instanced ? 1 : 4);
+
+		m_VertexData.resize(m_Capacity * m_SpriteSize);
+		m_VPtr = m_VertexData.data();
+
+		m_VBO = std::make_unique<VertexBuffer>(nullptr, m_Capacity * m_SpriteSize * ALV_SPRITEBATCH_FRAMES_IN_FLIGHT);
+		m_VBO->SetLayout(m_VertexDataLayout);
+
+		//Instances are expanded into quads by the vertex shader, so they need no indices
+		if (vertexFormat == VertexFormat::Instanced)
+		{
+			m_VAO.AddInstanceBuffer(m_VBO.get());
+			return;
+		}
 
-		m_EBO = alvere::IndexBuffer::New(s_Indices, ALV_MAX_SPRITEBATCH_SPRITES * 6);
-		
-		m_VAO.AddVertexBuffer(m_VBO);
-		m_VAO.SetIndexBuffer(m_EBO);
+		//Every flush draws from the start of the index buffer and offsets its vertices into the ring instead
+		std::vector<unsigned int> indices(m_Capacity * 6);
+		for (unsigned int idx = 0; idx < m_Capacity; idx++)
+		{
+			unsigned int vertex = idx * 4;
+			unsigned int index = idx * 6;
+			indices[index + 0] = vertex + 0;
+			indices[index + 1] = vertex + 1;
+			indices[index + 2] = vertex + 2;
+			indices[index + 3] = vertex + 2;
+			indices[index + 4] = vertex + 1;
+			indices[index + 5] = vertex + 3;
+		}
+
+		m_EBO.reset(alvere::IndexBuffer::New(indices.data(), (unsigned int)indices.size()));
+
+		m_VAO.AddVertexBuffer(m_VBO.get());
+		m_VAO.SetIndexBuffer(m_EBO.get());
 	}
 
 	SpriteBatcher::~SpriteBatcher()
 	{
+		for (GLsync fence : m_RegionFences)
+		{
+			if (fence != nullptr)
+			{
+				glDeleteSync(fence);
+			}
+		}
+
 		delete[] m_Textures;
-		delete m_VBO;
-		delete m_EBO;
+	}
+
+	const BufferLayout & SpriteBatcher::GetLayout(VertexFormat vertexFormat)
+	{
+		switch (vertexFormat)
+		{
+		case VertexFormat::Compact: return s_compactVertexDataLayout;
+		case VertexFormat::Instanced: return s_instanceDataLayout;
+		default: return s_vertexDataLayout;
+		}
 	}
 
 	void SpriteBatcher::processDrawCommandData(const DrawSpriteCommand& command)
@@ -66,69 +135,43 @@ namespace alvere::graphics_api::opengl
 
 		if (textureIndex == -1)
 		{
-			if (m_TexturesCount == ALV_OPENGL_MAX_TEXTUREUNITS_FRAGMENT)
+			//Premultiplied textures are blended differently, so they can't share a draw with straight alpha ones
+			if (m_TexturesCount == ALV_OPENGL_MAX_TEXTUREUNITS_FRAGMENT || (m_TexturesCount > 0 && command.texture->isPremultiplied() != m_Premultiplied))
 			{
 				flush();
 			}
 
+			if (m_TexturesCount == 0)
+			{
+				m_Premultiplied = command.texture->isPremultiplied();
+			}
+
 			textureIndex = m_TexturesCount;
 			m_Textures[textureIndex] = command.texture;
+			m_TexelScales[textureIndex] = getTexelScale(*command.texture);
 			m_TexturesCount++;
 		}
 
-		alvere::Vector2 topLeftTexCoords = command.texture->texCoords(command.source.getTopLeft());
-		*m_VPtr = command.destination.getLeft();
-		*++m_VPtr = command.destination.getTop();
-		*++m_VPtr = command.sortLayer;
-		*++m_VPtr = topLeftTexCoords.x;
-		*++m_VPtr = topLeftTexCoords.y;
-		*++m_VPtr = command.tint.x;
-		*++m_VPtr = command.tint.y;
-		*++m_VPtr = command.tint.z;
-		*++m_VPtr = command.tint.w;
-		*((int*)++m_VPtr) = textureIndex;
-
-		alvere::Vector2 bottomLeftTexCoords = command.texture->texCoords(command.source.getBottomLeft());
-		*++m_VPtr = command.destination.getLeft();
-		*++m_VPtr = command.destination.getBottom();
-		*++m_VPtr = command.sortLayer;
-		*++m_VPtr = bottomLeftTexCoords.x;
-		*++m_VPtr = bottomLeftTexCoords.y;
-		*++m_VPtr = command.tint.x;
-		*++m_VPtr = command.tint.y;
-		*++m_VPtr = command.tint.z;
-		*++m_VPtr = command.tint.w;
-		*((int*)++m_VPtr) = textureIndex;
-
-		alvere::Vector2 topRightTexCoords = command.texture->texCoords(command.source.getTopRight());
-		*++m_VPtr = command.destination.getRight();
-		*++m_VPtr = command.destination.getTop();
-		*++m_VPtr = command.sortLayer;
-		*++m_VPtr = topRightTexCoords.x;
-		*++m_VPtr = topRightTexCoords.y;
-		*++m_VPtr = command.tint.x;
-		*++m_VPtr = command.tint.y;
-		*++m_VPtr = command.tint.z;
-		*++m_VPtr = command.tint.w;
-		*((int*)++m_VPtr) = textureIndex;
-
-		alvere::Vector2 bottomRightTexCoords = command.texture->texCoords(command.source.getBottomRight());
-		*++m_VPtr = command.destination.getRight();
-		*++m_VPtr = command.destination.getBottom();
-		*++m_VPtr = command.sortLayer;
-		*++m_VPtr = bottomRightTexCoords.x;
-		*++m_VPtr = bottomRightTexCoords.y;
-		*++m_VPtr = command.tint.x;
-		*++m_VPtr = command.tint.y;
-		*++m_VPtr = command.tint.z;
-		*++m_VPtr = command.tint.w;
-		*((int*)++m_VPtr) = textureIndex;
-
-		if (++m_SpriteCount < ALV_MAX_SPRITEBATCH_SPRITES)
-		{
-			++m_VPtr;
+		Vector4 tint = m_Premultiplied ? premultiplyTint(command.tint) : command.tint;
+
+		switch (m_VertexFormat)
+		{
+		case VertexFormat::Compact:
+			CompactSpriteVertex::writeQuad((CompactSpriteVertex *)m_VPtr, m_TexelScales[textureIndex], command.destination, command.source, tint, command.sortLayer, textureIndex);
+			break;
+
+		case VertexFormat::Instanced:
+			SpriteInstance::write(*(SpriteInstance *)m_VPtr, m_TexelScales[textureIndex], command.destination, command.source, tint, command.sortLayer, textureIndex);
+			break;
+
+		default:
+			SpriteVertex::writeQuad((SpriteVertex *)m_VPtr, *command.texture, command.destination, command.source, tint, command.sortLayer, textureIndex);
+			break;
 		}
-		else
+
+		m_VPtr += m_SpriteSize;
+
+		if (++m_SpriteCount == m_Capacity)
 		{
 			flush();
 		}
@@ -136,56 +179,104 @@ namespace alvere::graphics_api::opengl
 
 	void SpriteBatcher::Draw()
 	{
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		glDisable(GL_DEPTH_TEST);
+		//Everything is left bound afterwards, so the next flush only changes what differs
+		StateCache & stateCache = StateCache::get();
 
-		m_VBO->SetSubData(0, m_VertexData, m_SpriteCount * sizeof(float) * s_vertexDataLayout.GetStride());
+		stateCache.setCapability(GL_BLEND, true);
+		stateCache.setBlendFunc(m_Premultiplied ? GL_ONE : GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		stateCache.setCapability(GL_DEPTH_TEST, false);
 
-		s_shaderProgram->bind();
+		m_ShaderProgram->bind();
 
-		s_shaderProgram->sendUniformMat4x4("u_ProjectionView", *m_TransformationMatrix);
+		m_ShaderProgram->sendUniform(m_ProjectionViewUniform, *m_TransformationMatrix);
 
 		for (int idx = 0; idx < m_TexturesCount; idx++)
 		{
-			glActiveTexture(GL_TEXTURE0 + idx);
-			m_Textures[idx]->bind();
+			stateCache.bindTexture(idx, (unsigned int)(std::uintptr_t)m_Textures[idx]->getHandle());
 		}
 
-		m_VAO.Bind();
-		ALV_LOG_OPENGL_CALL(glDrawElements(GL_TRIANGLES, m_SpriteCount * 6, GL_UNSIGNED_INT, nullptr));
-		m_VAO.Unbind();
+		if (m_VertexFormat == VertexFormat::Instanced)
+		{
+			m_VAO.SetInstanceOffset(m_VBO.get(), m_FirstSprite);
 
-		glDisable(GL_BLEND);
+			m_VAO.Bind();
+			ALV_LOG_OPENGL_CALL(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, m_SpriteCount));
+		}
+		else
+		{
+			m_VAO.Bind();
+			ALV_LOG_OPENGL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, m_SpriteCount * 6, GL_UNSIGNED_INT, nullptr, m_FirstSprite * 4));
+		}
+	}
+
+	void SpriteBatcher::Upload()
+	{
+		if (m_RegionCursor + m_SpriteCount > m_Capacity)
+		{
+			NextRegion();
+		}
+
+		m_FirstSprite = m_Region * m_Capacity + m_RegionCursor;
+		m_RegionCursor += m_SpriteCount;
+
+		//Nothing the GPU could still be reading is written over, so there is no need to wait for it
+		m_VBO->Bind();
+		void * destination = glMapBufferRange(GL_ARRAY_BUFFER, m_FirstSprite * m_SpriteSize, m_SpriteCount * m_SpriteSize,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+		if (destination != nullptr)
+		{
+			std::memcpy(destination, m_VertexData.data(), m_SpriteCount * m_SpriteSize);
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+		}
+		else
+		{
+			ALV_LOG_OPENGL_CALL(glBufferSubData(GL_ARRAY_BUFFER, m_FirstSprite * m_SpriteSize, m_SpriteCount * m_SpriteSize, m_VertexData.data()));
+		}
+	}
+
+	void SpriteBatcher::NextRegion()
+	{
+		m_RegionFences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_Region = (m_Region + 1) % ALV_SPRITEBATCH_FRAMES_IN_FLIGHT;
+		m_RegionCursor = 0;
+
+		GLsync & fence = m_RegionFences[m_Region];
+		if (fence == nullptr)
+		{
+			return;
+		}
+
+		//Only stalls when the GPU is more than a full ring of sprites behind
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		while (result == GL_TIMEOUT_EXPIRED)
+		{
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
 	}
 
 	void SpriteBatcher::Clear()
 	{
-		m_VPtr = m_VertexData;
+		m_VPtr = m_VertexData.data();
 		m_SpriteCount = 0;
 		m_TexturesCount = 0;
 	}
 
 	void SpriteBatcher::flush()
 	{
+		Upload();
 		Draw();
 		Clear();
+
+		++m_FlushCount;
 	}
 
 	void SpriteBatcher::InitStatic()
 	{
-		for (int idx = 0; idx < ALV_MAX_SPRITEBATCH_SPRITES; idx++)
-		{
-			int vertex = idx * 4;
-			int index = idx * 6;
-			s_Indices[index + 0] = vertex + 0;
-			s_Indices[index + 1] = vertex + 1;
-			s_Indices[index + 2] = vertex + 2;
-			s_Indices[index + 3] = vertex + 2;
-			s_Indices[index + 4] = vertex + 1;
-			s_Indices[index + 5] = vertex + 3;
-		}
-
 		s_vertexShader = alvere::Shader::New(Shader::Type::Vertex, file::read("res/shaders/spritebatcher.vert"));
 
 		s_fragmentShader = alvere::Shader::New(Shader::Type::Fragment, R"(
@@ -215,18 +306,31 @@ namespace alvere::graphics_api::opengl
 		s_shaderProgram->SetShader(s_fragmentShader.get());
 		s_shaderProgram->build();
 
-		s_shaderProgram->bind();
+		//These unpack their vertices into the same outputs, so they can share the fragment shader
+		s_compactVertexShader = alvere::Shader::New(Shader::Type::Vertex, file::read("res/shaders/spritebatcher_compact.vert"));
+
+		s_compactShaderProgram = std::make_unique<ShaderProgram>();
+		s_compactShaderProgram->SetShader(s_compactVertexShader.get());
+		s_compactShaderProgram->SetShader(s_fragmentShader.get());
+		s_compactShaderProgram->build();
+
+		s_instancedVertexShader = alvere::Shader::New(Shader::Type::Vertex, file::read("res/shaders/spritebatcher_instanced.vert"));
+
+		s_instancedShaderProgram = std::make_unique<ShaderProgram>();
+		s_instancedShaderProgram->SetShader(s_instancedVertexShader.get());
+		s_instancedShaderProgram->SetShader(s_fragmentShader.get());
+		s_instancedShaderProgram->build();
 
 		char numstr[16];
-		for (int idx = 0; idx < ALV_OPENGL_MAX_TEXTUREUNITS_FRAGMENT; idx++)
+		for (ShaderProgram * shaderProgram : { s_shaderProgram.get(), s_compactShaderProgram.get(), s_instancedShaderProgram.get() })
 		{
-			sprintf(numstr, "u_Textures[%d]", idx);
-			s_shaderProgram->sendUniformInt1(numstr, idx);
+			shaderProgram->bind();
+
+			for (int idx = 0; idx < ALV_OPENGL_MAX_TEXTUREUNITS_FRAGMENT; idx++)
+			{
+				sprintf(numstr, "u_Textures[%d]", idx);
+				shaderProgram->sendUniformInt1(numstr, idx);
+			}
 		}
 	}
 }
-
-std::unique_ptr<alvere::SpriteBatcher> alvere::SpriteBatcher::New()
-{
-	return std::make_unique<alvere::graphics_api::opengl::SpriteBatcher>();
-}
\ No newline at end of file
@@ -1,42 +1,80 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+
+#include <glad/glad.h>
 
 #include "alvere/graphics/sprite_batcher.hpp"
 #include "alvere/graphics/buffers.hpp"
 
+#include "graphics_api/opengl/opengl_buffers.hpp"
 #include "graphics_api/opengl/opengl_shader_program.hpp"
 #include "graphics_api/opengl/opengl_vertex_array.hpp"
 
+#define ALV_OPENGL_MAX_TEXTUREUNITS_FRAGMENT 16
+#define ALV_SPRITEBATCH_FRAMES_IN_FLIGHT 3
+
 namespace alvere::graphics_api::opengl
 {
+	//Each flush is written into fresh space in a ring of vertex storage, split into one region per frame in flight.
+	//A region is fenced when the batcher moves past it and only waited on when the ring wraps back around to it,
+	//so an upload never has to wait for the GPU to finish drawing the sprites before it.
 	class SpriteBatcher : public alvere::SpriteBatcher
 	{
 	public:
-		SpriteBatcher();
+		SpriteBatcher(unsigned int capacity, VertexFormat vertexFormat);
 		~SpriteBatcher();
 
 	protected:
 		static BufferLayout s_vertexDataLayout;
-		static unsigned int s_Indices[];
+		static BufferLayout s_compactVertexDataLayout;
+		static BufferLayout s_instanceDataLayout;
 		static std::unique_ptr<Shader> s_vertexShader;
+		static std::unique_ptr<Shader> s_compactVertexShader;
+		static std::unique_ptr<Shader> s_instancedVertexShader;
 		static std::unique_ptr<Shader> s_fragmentShader;
 		static std::unique_ptr<ShaderProgram> s_shaderProgram;
+		static std::unique_ptr<ShaderProgram> s_compactShaderProgram;
+		static std::unique_ptr<ShaderProgram> s_instancedShaderProgram;
 
-		float m_VertexData[ALV_MAX_SPRITEBATCH_SPRITES * (3 + 2 + 4 + 1) * sizeof(float)], *m_VPtr;
+		const BufferLayout & m_VertexDataLayout;
+		ShaderProgram * m_ShaderProgram;
+		UniformHandle<Shader::DataType::Mat4x4> m_ProjectionViewUniform;
+
+		//Bytes written for each sprite, four vertices or one instance
+		unsigned int m_SpriteSize;
+		std::vector<unsigned char> m_VertexData;
+		unsigned char * m_VPtr;
 		const Texture * * m_Textures;
+		//getTexelScale of each bound texture, so packing texture coordinates doesn't divide per sprite
+		Vector2 m_TexelScales[ALV_OPENGL_MAX_TEXTUREUNITS_FRAGMENT];
 		int m_TexturesCount;
-		alvere::VertexBuffer * m_VBO;
-		alvere::IndexBuffer * m_EBO;
+		//Whether the textures in this flush are premultiplied, which picks the blend function it's drawn with
+		bool m_Premultiplied;
+		std::unique_ptr<VertexBuffer> m_VBO;
+		std::unique_ptr<alvere::IndexBuffer> m_EBO;
 		VertexArray m_VAO;
 
+		GLsync m_RegionFences[ALV_SPRITEBATCH_FRAMES_IN_FLIGHT];
+		unsigned int m_Region;
+		unsigned int m_RegionCursor;
+		unsigned int m_FirstSprite;
+
 		void processDrawCommandData(const DrawSpriteCommand& command) override;
 
+		static const BufferLayout & GetLayout(VertexFormat vertexFormat);
+
 		void Clear();
+		void Upload();
 		void Draw();
 		void flush() override;
 
+		void NextRegion();
+
 	private:
-		void InitStatic();
+		friend class StaticSpriteBatch;
+
+		static void InitStatic();
 	};
 }
\ No newline at end of file
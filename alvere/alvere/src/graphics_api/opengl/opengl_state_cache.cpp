@@ -0,0 +1,217 @@
+#include "graphics_api/opengl/opengl_state_cache.hpp"
+
+#include <glad/glad.h>
+
+#include "alvere/debug/exceptions.hpp"
+
+namespace alvere::graphics_api::opengl
+{
+	StateCache & StateCache::get()
+	{
+		static StateCache s_stateCache;
+		return s_stateCache;
+	}
+
+	StateCache::StateCache()
+	{
+		invalidate();
+	}
+
+	void StateCache::useProgram(unsigned int program)
+	{
+		if (change(m_program, program))
+			glUseProgram(program);
+	}
+
+	void StateCache::bindVertexArray(unsigned int vertexArray)
+	{
+		if (change(m_vertexArray, vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+			m_elementArrayBuffer = Unknown;
+		}
+	}
+
+	void StateCache::bindBuffer(unsigned int target, unsigned int buffer)
+	{
+		switch (target)
+		{
+		case GL_ARRAY_BUFFER:
+			if (change(m_arrayBuffer, buffer))
+				glBindBuffer(target, buffer);
+			break;
+		case GL_ELEMENT_ARRAY_BUFFER:
+			if (change(m_elementArrayBuffer, buffer))
+				glBindBuffer(target, buffer);
+			break;
+		default:
+			++m_frame.issued;
+			glBindBuffer(target, buffer);
+			break;
+		}
+	}
+
+	void StateCache::activeTexture(unsigned int unit)
+	{
+		AlvAssert(unit < ALV_OPENGL_STATE_CACHE_TEXTURE_UNITS, "Texture unit is out of range");
+
+		if (change(m_activeTexture, unit))
+			glActiveTexture(GL_TEXTURE0 + unit);
+	}
+
+	void StateCache::bindTexture(unsigned int texture)
+	{
+		//Nothing is known about the unit until it's been set once, so the bind can't be skipped
+		if (m_activeTexture == Unknown)
+		{
+			++m_frame.issued;
+			glBindTexture(GL_TEXTURE_2D, texture);
+			return;
+		}
+
+		if (change(m_textures[m_activeTexture], texture))
+			glBindTexture(GL_TEXTURE_2D, texture);
+	}
+
+	void StateCache::bindTexture(unsigned int unit, unsigned int texture)
+	{
+		AlvAssert(unit < ALV_OPENGL_STATE_CACHE_TEXTURE_UNITS, "Texture unit is out of range");
+
+		//The active unit only matters to the bind, so it's left alone when the bind is skipped
+		if (m_textures[unit] == texture)
+		{
+			++m_frame.skipped;
+			return;
+		}
+
+		activeTexture(unit);
+		bindTexture(texture);
+	}
+
+	void StateCache::bindFrameBuffer(unsigned int frameBuffer)
+	{
+		if (change(m_frameBuffer, frameBuffer))
+			glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+	}
+
+	void StateCache::setCapability(unsigned int capability, bool enabled)
+	{
+		unsigned int * current = nullptr;
+		switch (capability)
+		{
+		case GL_BLEND: current = &m_blend; break;
+		case GL_DEPTH_TEST: current = &m_depthTest; break;
+		}
+
+		if (current != nullptr && change(*current, enabled ? 1 : 0) == false)
+			return;
+
+		if (current == nullptr)
+			++m_frame.issued;
+
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+	}
+
+	void StateCache::setBlendFunc(unsigned int source, unsigned int destination)
+	{
+		if (m_blendSource == source && m_blendDestination == destination)
+		{
+			++m_frame.skipped;
+			return;
+		}
+
+		++m_frame.issued;
+		m_blendSource = source;
+		m_blendDestination = destination;
+		glBlendFunc(source, destination);
+	}
+
+	void StateCache::deleteProgram(unsigned int program)
+	{
+		glDeleteProgram(program);
+
+		//A program being used isn't deleted until it stops being used, so it's safest to forget it
+		if (m_program == program)
+			m_program = Unknown;
+	}
+
+	void StateCache::deleteVertexArray(unsigned int vertexArray)
+	{
+		glDeleteVertexArrays(1, &vertexArray);
+
+		if (m_vertexArray == vertexArray)
+		{
+			m_vertexArray = 0;
+			m_elementArrayBuffer = Unknown;
+		}
+	}
+
+	void StateCache::deleteBuffer(unsigned int buffer)
+	{
+		glDeleteBuffers(1, &buffer);
+
+		if (m_arrayBuffer == buffer)
+			m_arrayBuffer = 0;
+
+		if (m_elementArrayBuffer == buffer)
+			m_elementArrayBuffer = 0;
+	}
+
+	void StateCache::deleteTexture(unsigned int texture)
+	{
+		glDeleteTextures(1, &texture);
+
+		for (unsigned int & boundTexture : m_textures)
+		{
+			if (boundTexture == texture)
+				boundTexture = 0;
+		}
+	}
+
+	void StateCache::deleteFrameBuffer(unsigned int frameBuffer)
+	{
+		glDeleteFramebuffers(1, &frameBuffer);
+
+		if (m_frameBuffer == frameBuffer)
+			m_frameBuffer = 0;
+	}
+
+	void StateCache::invalidate()
+	{
+		m_program = Unknown;
+		m_vertexArray = Unknown;
+		m_arrayBuffer = Unknown;
+		m_elementArrayBuffer = Unknown;
+		m_activeTexture = Unknown;
+		m_frameBuffer = Unknown;
+		m_blend = Unknown;
+		m_depthTest = Unknown;
+		m_blendSource = Unknown;
+		m_blendDestination = Unknown;
+
+		for (unsigned int & texture : m_textures)
+			texture = Unknown;
+	}
+
+	void StateCache::endFrame()
+	{
+		m_lastFrame = m_frame;
+		m_frame = Counters();
+	}
+
+	bool StateCache::change(unsigned int & current, unsigned int value)
+	{
+		if (current == value)
+		{
+			++m_frame.skipped;
+			return false;
+		}
+
+		++m_frame.issued;
+		current = value;
+		return true;
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#define ALV_OPENGL_STATE_CACHE_TEXTURE_UNITS 32
+
+namespace alvere::graphics_api::opengl
+{
+	//Remembers what is bound to the context, so calls that wouldn't change anything are never made.
+	//Only stays accurate while every bind in the backend goes through it. Code that changes state behind its back
+	//must call invalidate() afterwards. ImGui's renderer restores everything it touches, so it needs nothing.
+	class StateCache
+	{
+	public:
+
+		struct Counters
+		{
+			unsigned int issued = 0;
+			unsigned int skipped = 0;
+		};
+
+		static StateCache & get();
+
+		void useProgram(unsigned int program);
+
+		void bindVertexArray(unsigned int vertexArray);
+
+		//Only the array and element array bindings are tracked. Other targets are always bound.
+		//The element array binding belongs to the vertex array, so it is forgotten whenever that changes.
+		void bindBuffer(unsigned int target, unsigned int buffer);
+
+		void activeTexture(unsigned int unit);
+
+		//Binds a 2D texture to the active unit
+		void bindTexture(unsigned int texture);
+
+		void bindTexture(unsigned int unit, unsigned int texture);
+
+		void bindFrameBuffer(unsigned int frameBuffer);
+
+		//For GL_BLEND and GL_DEPTH_TEST. Other capabilities are always set.
+		void setCapability(unsigned int capability, bool enabled);
+
+		void setBlendFunc(unsigned int source, unsigned int destination);
+
+		//GL frees a name once it's deleted and hands it out again, so these forget anything bound with it
+		void deleteProgram(unsigned int program);
+		void deleteVertexArray(unsigned int vertexArray);
+		void deleteBuffer(unsigned int buffer);
+		void deleteTexture(unsigned int texture);
+		void deleteFrameBuffer(unsigned int frameBuffer);
+
+		//Forgets everything, so the next call of each kind is made
+		void invalidate();
+
+		//Called once the frame has been presented
+		void endFrame();
+
+		//Calls made and skipped during the last whole frame
+		const Counters & getFrameCounters() const { return m_lastFrame; }
+
+	private:
+
+		static const unsigned int Unknown = ~0u;
+
+		unsigned int m_program = Unknown;
+		unsigned int m_vertexArray = Unknown;
+		unsigned int m_arrayBuffer = Unknown;
+		unsigned int m_elementArrayBuffer = Unknown;
+		unsigned int m_activeTexture = Unknown;
+		unsigned int m_textures[ALV_OPENGL_STATE_CACHE_TEXTURE_UNITS];
+		unsigned int m_frameBuffer = Unknown;
+
+		//0 or 1 once known
+		unsigned int m_blend = Unknown;
+		unsigned int m_depthTest = Unknown;
+		unsigned int m_blendSource = Unknown;
+		unsigned int m_blendDestination = Unknown;
+
+		Counters m_frame;
+		Counters m_lastFrame;
+
+		StateCache();
+
+		//Records the call as made or skipped, returning whether it has to be made
+		bool change(unsigned int & current, unsigned int value);
+	};
+}
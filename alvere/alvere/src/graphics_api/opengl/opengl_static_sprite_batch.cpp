@@ -0,0 +1,111 @@
+#include "graphics_api/opengl/opengl_static_sprite_batch.hpp"
+
+#include <cstdint>
+
+#include <glad/glad.h>
+
+#include "alvere/graphics/sprite_vertices.hpp"
+#include "graphics_api/opengl/opengl_errors.hpp"
+#include "graphics_api/opengl/opengl_sprite_batcher.hpp"
+#include "graphics_api/opengl/opengl_state_cache.hpp"
+
+namespace alvere::graphics_api::opengl
+{
+	StaticSpriteBatch::StaticSpriteBatch()
+	{
+		//Shares its instance layout and shaders with the sprite batcher
+		if (SpriteBatcher::s_shaderProgram == nullptr)
+		{
+			SpriteBatcher::InitStatic();
+		}
+
+		m_ProjectionViewUniform = SpriteBatcher::s_instancedShaderProgram->getUniform<Shader::DataType::Mat4x4>("u_ProjectionView");
+	}
+
+	void StaticSpriteBatch::upload(const std::vector<StaticSprite> & sprites)
+	{
+		m_DrawRanges.clear();
+
+		m_VAO.reset();
+		m_VBO.reset();
+
+		if (sprites.empty())
+		{
+			return;
+		}
+
+		std::vector<SpriteInstance> instances(sprites.size());
+
+		for (unsigned int idx = 0; idx < sprites.size(); ++idx)
+		{
+			const StaticSprite & sprite = sprites[idx];
+			bool premultiplied = sprite.texture->isPremultiplied();
+
+			if (m_DrawRanges.empty())
+			{
+				m_DrawRanges.push_back({ idx, 0, {}, premultiplied });
+			}
+
+			int textureIndex = -1;
+			for (int textureIdx = 0; textureIdx < (int)m_DrawRanges.back().textures.size(); ++textureIdx)
+			{
+				if (m_DrawRanges.back().textures[textureIdx] == sprite.texture)
+				{
+					textureIndex = textureIdx;
+				}
+			}
+
+			if (textureIndex == -1)
+			{
+				if (m_DrawRanges.back().textures.size() == ALV_OPENGL_MAX_TEXTUREUNITS_FRAGMENT || m_DrawRanges.back().premultiplied != premultiplied)
+				{
+					m_DrawRanges.push_back({ idx, 0, {}, premultiplied });
+				}
+
+				textureIndex = (int)m_DrawRanges.back().textures.size();
+				m_DrawRanges.back().textures.push_back(sprite.texture);
+			}
+
+			++m_DrawRanges.back().spriteCount;
+
+			SpriteInstance::write(instances[idx], *sprite.texture, sprite.destination, sprite.source, premultiplied ? premultiplyTint(sprite.tint) : sprite.tint, 0.0f, textureIndex);
+		}
+
+		m_VBO.reset(alvere::VertexBuffer::New((const float *)instances.data(), (unsigned int)(instances.size() * sizeof(SpriteInstance))));
+		m_VBO->SetLayout(SpriteBatcher::s_instanceDataLayout);
+
+		m_VAO = std::make_unique<VertexArray>();
+		m_VAO->AddInstanceBuffer(m_VBO.get());
+	}
+
+	void StaticSpriteBatch::draw(const Matrix4 & transformationMatrix)
+	{
+		if (m_VAO == nullptr)
+		{
+			return;
+		}
+
+		StateCache & stateCache = StateCache::get();
+
+		stateCache.setCapability(GL_BLEND, true);
+		stateCache.setCapability(GL_DEPTH_TEST, false);
+
+		SpriteBatcher::s_instancedShaderProgram->bind();
+		SpriteBatcher::s_instancedShaderProgram->sendUniform(m_ProjectionViewUniform, transformationMatrix);
+
+		for (const DrawRange & range : m_DrawRanges)
+		{
+			stateCache.setBlendFunc(range.premultiplied ? GL_ONE : GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+			for (int idx = 0; idx < (int)range.textures.size(); idx++)
+			{
+				stateCache.bindTexture(idx, (unsigned int)(std::uintptr_t)range.textures[idx]->getHandle());
+			}
+
+			m_VAO->SetInstanceOffset(m_VBO.get(), range.firstSprite);
+
+			m_VAO->Bind();
+			ALV_LOG_OPENGL_CALL(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, range.spriteCount));
+		}
+	}
+}
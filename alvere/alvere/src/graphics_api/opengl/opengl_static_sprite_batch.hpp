@@ -0,0 +1,43 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "alvere/graphics/static_sprite_batch.hpp"
+#include "alvere/graphics/buffers.hpp"
+#include "alvere/graphics/shader_program.hpp"
+
+#include "graphics_api/opengl/opengl_vertex_array.hpp"
+
+namespace alvere::graphics_api::opengl
+{
+	class StaticSpriteBatch : public alvere::StaticSpriteBatch
+	{
+	public:
+		StaticSpriteBatch();
+
+		void draw(const Matrix4 & transformationMatrix) override;
+
+		unsigned int getDrawCallCount() const override { return (unsigned int)m_DrawRanges.size(); }
+
+	protected:
+		//A run of sprites that fits within the texture units available to a single draw call, all with the same alpha
+		struct DrawRange
+		{
+			unsigned int firstSprite;
+			unsigned int spriteCount;
+			std::vector<const Texture *> textures;
+			bool premultiplied;
+		};
+
+		std::vector<DrawRange> m_DrawRanges;
+
+		//One instance per sprite, expanded into quads by the sprite batcher's instanced shader
+		std::unique_ptr<alvere::VertexBuffer> m_VBO;
+		std::unique_ptr<VertexArray> m_VAO;
+
+		UniformHandle<Shader::DataType::Mat4x4> m_ProjectionViewUniform;
+
+		void upload(const std::vector<StaticSprite> & sprites) override;
+	};
+}
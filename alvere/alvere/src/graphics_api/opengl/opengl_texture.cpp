@@ -3,11 +3,12 @@
 #include <glad/glad.h>
 
 #include "graphics_api/opengl/opengl_errors.hpp"
+#include "graphics_api/opengl/opengl_state_cache.hpp"
 
 namespace alvere::graphics_api::opengl
 {
-	Texture::Texture(const char * filename, Channels channels)
-		: alvere::Texture(filename, channels)
+	Texture::Texture(const char * filename, Channels channels, bool keepPixelData)
+		: alvere::Texture(filename, channels, keepPixelData)
 	{
 		init();
 	}
@@ -24,7 +25,11 @@ namespace alvere::graphics_api::opengl
 		init();
 	}
 
-
+	Texture::Texture(Placeholder placeholder, int width, int height, Channels channels, bool keepPixelData)
+		: alvere::Texture(placeholder, width, height, channels, keepPixelData)
+	{
+		init();
+	}
 
 	Texture::Texture(int width, int height, Channels channels)
 		: alvere::Texture(width, height, channels)
@@ -34,17 +39,17 @@ namespace alvere::graphics_api::opengl
 
 	Texture::~Texture()
 	{
-		glDeleteTextures(1, &m_Handle);
+		StateCache::get().deleteTexture(m_Handle);
 	}
 
 	void Texture::bind() const
 	{
-		glBindTexture(GL_TEXTURE_2D, m_Handle);
+		StateCache::get().bindTexture(m_Handle);
 	}
 
 	void Texture::unbind() const
 	{
-		glBindTexture(GL_TEXTURE_2D, 0);
+		StateCache::get().bindTexture(0);
 	}
 
 	void * Texture::getHandle() const
@@ -57,6 +62,9 @@ namespace alvere::graphics_api::opengl
 		if (width <= 0 || height <= 0)
 			return false;
 
+		if (restorePixelData() == false)
+			return false;
+
 		unsigned char * newPixelData = (unsigned char *)std::malloc(width * height * m_channelCount);
 
 		if (newPixelData == nullptr)
@@ -80,11 +88,11 @@ namespace alvere::graphics_api::opengl
 		m_dimensions.y = height;
 		m_pixelData = newPixelData;
 
-		glBindTexture(GL_TEXTURE_2D, m_Handle);
+		StateCache::get().bindTexture(m_Handle);
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 		ALV_LOG_OPENGL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, m_dimensions.x, m_dimensions.y, 0, m_format, GL_UNSIGNED_BYTE, m_pixelData));
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		StateCache::get().bindTexture(0);
 
 		return true;
 	}
@@ -108,38 +116,71 @@ namespace alvere::graphics_api::opengl
 		}
 
 		glGenTextures(1, &m_Handle);
-		glBindTexture(GL_TEXTURE_2D, m_Handle);
+		StateCache::get().bindTexture(m_Handle);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		ALV_LOG_OPENGL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, m_dimensions.x, m_dimensions.y, 0, m_format, GL_UNSIGNED_BYTE, m_pixelData));
-		glGenerateMipmap(GL_TEXTURE_2D);
-		glBindTexture(GL_TEXTURE_2D, 0);
+
+		upload();
 	}
-}
 
-std::unique_ptr<alvere::Texture> alvere::Texture::New(const char * filename, Channels channels)
-{
-	return std::make_unique<graphics_api::opengl::Texture>(filename, channels);
-}
+	void Texture::uploadPixelData()
+	{
+		StateCache::get().bindTexture(m_Handle);
 
-std::unique_ptr<alvere::Texture> alvere::Texture::New(const unsigned char * data, int width, int height, Channels channels)
-{
-	return std::make_unique<graphics_api::opengl::Texture>(data, width, height, channels);
-}
+		//Cooked levels have no row padding
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-std::unique_ptr<alvere::Texture> alvere::Texture::New(int width, int height, Channels channels)
-{
-	return std::make_unique<graphics_api::opengl::Texture>(width, height, channels);
-}
+		if (m_mipChain.m_levelCount > 0)
+		{
+			for (uint32_t level = 0; level < m_mipChain.m_levelCount; ++level)
+			{
+				Vec2i dimensions = texture_cache::getLevelDimensions(m_mipChain.m_dimensions, level);
+				ALV_LOG_OPENGL_CALL(glTexImage2D(GL_TEXTURE_2D, level, m_internalFormat, dimensions.x, dimensions.y, 0, m_format, GL_UNSIGNED_BYTE, m_mipChain.m_levels[level]));
+			}
+
+			//Textures too large for a full chain in the cache stop short of 1x1
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_mipChain.m_levelCount - 1);
+
+			//Texels stay sharp within a level, like the magnified ones, but minified textures blend between the cooked levels
+			//instead of skipping texels. A single level chain has nothing to blend.
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_mipChain.m_levelCount > 1 ? GL_NEAREST_MIPMAP_LINEAR : GL_NEAREST);
+		}
+		else
+		{
+			//Texture coordinates are normalised, so a single texel stands in for a texture of any size
+			const unsigned char placeholder[4] = ALV_TEXTURE_PLACEHOLDER_COLOUR;
+			bool hasPixels = m_pixelData != nullptr;
 
-alvere::Texture * alvere::Texture::loadFromFile(const std::string & filepath)
-{
-	return new graphics_api::opengl::Texture(filepath.c_str());
-}
+			ALV_LOG_OPENGL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormat, hasPixels ? m_dimensions.x : 1, hasPixels ? m_dimensions.y : 1, 0, m_format, GL_UNSIGNED_BYTE, hasPixels ? m_pixelData : placeholder));
+			//OpenGL's default, so every generated level is used
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
+			glGenerateMipmap(GL_TEXTURE_2D);
 
-std::unique_ptr<alvere::Texture> alvere::Texture::New(const alvere::Texture & sourceTexture, alvere::RectI sourceRect)
-{
-	return std::make_unique<graphics_api::opengl::Texture>(sourceTexture, sourceRect);
+			//Atlas pages and textures built at runtime pack sprites edge to edge, so their levels would bleed into each other
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		StateCache::get().bindTexture(0);
+	}
+
+	unsigned char * Texture::readPixelData() const
+	{
+		if (m_dimensions.x <= 0 || m_dimensions.y <= 0)
+			return nullptr;
+
+		unsigned char * pixelData = (unsigned char *)std::malloc((std::size_t)m_dimensions.x * m_dimensions.y * m_channelCount);
+		if (pixelData == nullptr)
+			return nullptr;
+
+		StateCache::get().bindTexture(m_Handle);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		ALV_LOG_OPENGL_CALL(glGetTexImage(GL_TEXTURE_2D, 0, m_format, GL_UNSIGNED_BYTE, pixelData));
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		StateCache::get().bindTexture(0);
+
+		return pixelData;
+	}
 }
@@ -7,7 +7,7 @@ namespace alvere::graphics_api::opengl
 	class Texture : public alvere::Texture
 	{
 	public:
-		Texture(const char * filename, Channels channels = Channels::RGBAlpha);
+		Texture(const char * filename, Channels channels = Channels::RGBAlpha, bool keepPixelData = false);
 
 		Texture(const unsigned char * data, int width, int height, Channels channels = Channels::RGBAlpha);
 
@@ -15,6 +15,8 @@ namespace alvere::graphics_api::opengl
 
 		Texture(const alvere::Texture & sourceTexture, alvere::RectI sourceRect);
 
+		Texture(Placeholder placeholder, int width, int height, Channels channels = Channels::RGBAlpha, bool keepPixelData = false);
+
 		~Texture();
 
 		void bind() const override;
@@ -25,6 +27,12 @@ namespace alvere::graphics_api::opengl
 
 		bool resize(unsigned int width, unsigned int height) override;
 
+	protected:
+
+		void uploadPixelData() override;
+
+		unsigned char * readPixelData() const override;
+
 	private:
 
 		unsigned int m_Handle;
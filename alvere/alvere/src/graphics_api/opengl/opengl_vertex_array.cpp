@@ -5,6 +5,7 @@
 #include "alvere/graphics/shader.hpp"
 
 #include "graphics_api/opengl/opengl_errors.hpp"
+#include "graphics_api/opengl/opengl_state_cache.hpp"
 
 namespace alvere::graphics_api::opengl
 {
@@ -20,10 +21,19 @@ namespace alvere::graphics_api::opengl
 		case Shader::DataType::Int2:
 		case Shader::DataType::Int3:
 		case Shader::DataType::Int4: return GL_INT;
+		case Shader::DataType::UInt: return GL_UNSIGNED_INT;
+		case Shader::DataType::UShort2:
+		case Shader::DataType::UShort4: return GL_UNSIGNED_SHORT;
+		case Shader::DataType::UByte4: return GL_UNSIGNED_BYTE;
 		}
 		return 0;
 	}
 
+	static bool IsIntegerDataType(Shader::DataType dataType)
+	{
+		return (dataType >= Shader::DataType::Int && dataType <= Shader::DataType::Int4) || dataType == Shader::DataType::UInt;
+	}
+
 	VertexArray::VertexArray()
 	{
 		glGenVertexArrays(1, &m_Handle);
@@ -31,32 +41,62 @@ namespace alvere::graphics_api::opengl
 
 	VertexArray::~VertexArray()
 	{
-		glDeleteVertexArrays(1, &m_Handle);
+		StateCache::get().deleteVertexArray(m_Handle);
 	}
 
 	void VertexArray::Bind()
 	{
-		glBindVertexArray(m_Handle);
+		StateCache::get().bindVertexArray(m_Handle);
 	}
 
 	void VertexArray::Unbind()
 	{
-		glBindVertexArray(0);
+		StateCache::get().bindVertexArray(0);
+	}
+
+	void VertexArray::AddVertexBuffer(alvere::VertexBuffer * buffer)
+	{
+		StateCache::get().bindVertexArray(m_Handle);
+
+		SetAttributePointers(buffer, 0, 0, 0);
+
+		m_VertexBuffers.push_back(buffer);
+	}
+
+	void VertexArray::SetVertexBuffer(alvere::VertexBuffer * buffer)
+	{
+		m_VertexBuffers.clear();
+
+		AddVertexBuffer(buffer);
+	}
+
+	void VertexArray::AddInstanceBuffer(alvere::VertexBuffer * buffer, unsigned int firstLocation)
+	{
+		StateCache::get().bindVertexArray(m_Handle);
+
+		SetAttributePointers(buffer, 0, 1, firstLocation);
+
+		m_VertexBuffers.push_back(buffer);
 	}
 
-	void VertexArray::AddVertexBuffer(VertexBuffer * buffer)
+	void VertexArray::SetInstanceOffset(alvere::VertexBuffer * buffer, unsigned int firstInstance, unsigned int firstLocation)
 	{
-		glBindVertexArray(m_Handle);
+		StateCache::get().bindVertexArray(m_Handle);
 
+		SetAttributePointers(buffer, (std::size_t)firstInstance * buffer->GetLayout().GetStride(), 1, firstLocation);
+	}
+
+	void VertexArray::SetAttributePointers(alvere::VertexBuffer * buffer, std::size_t baseOffset, unsigned int divisor, unsigned int firstLocation)
+	{
 		buffer->Bind();
 
-		unsigned int index = 0;
+		unsigned int index = firstLocation;
 		const BufferLayout& layout = buffer->GetLayout();
 		const std::vector<BufferElementProperties>& layoutElements = layout.GetElements();
 		for (const BufferElementProperties& element : layoutElements)
 		{
 			glEnableVertexAttribArray(index);
-			if (element.m_DataType < Shader::DataType::Int || element.m_DataType > Shader::DataType::Int4)
+			if (!IsIntegerDataType(element.m_DataType))
 			{
 				ALV_LOG_OPENGL_CALL(glVertexAttribPointer(
 					index,
@@ -64,7 +104,7 @@ namespace alvere::graphics_api::opengl
 					ShaderDataTypeToOpenGLTypeEnum(element.m_DataType),
 					element.m_Normalise,
 					layout.GetStride(),
-					(const void*)element.m_Offset));
+					(const void*)(baseOffset + element.m_Offset)));
 			}
 			else
 			{
@@ -73,33 +113,28 @@ namespace alvere::graphics_api::opengl
 					element.m_ComponentCount,
 					ShaderDataTypeToOpenGLTypeEnum(element.m_DataType),
 					layout.GetStride(),
-					(const void*)element.m_Offset));
+					(const void*)(baseOffset + element.m_Offset)));
 			}
+			glVertexAttribDivisor(index, divisor);
 			index++;
 		}
-
-		m_VertexBuffers.push_back(buffer);
-
-		glBindVertexArray(0);
 	}
 
-	const std::vector<VertexBuffer *>& VertexArray::GetVertexBuffers() const
+	const std::vector<alvere::VertexBuffer *>& VertexArray::GetVertexBuffers() const
 	{
 		return m_VertexBuffers;
 	}
 
-	void VertexArray::SetIndexBuffer(IndexBuffer * buffer)
+	void VertexArray::SetIndexBuffer(alvere::IndexBuffer * buffer)
 	{
-		glBindVertexArray(m_Handle);
+		StateCache::get().bindVertexArray(m_Handle);
 
 		buffer->Bind();
 
 		m_IndexBuffer = buffer;
-
-		glBindVertexArray(0);
 	}
 
-	const IndexBuffer * VertexArray::GetIndexBuffer() const
+	const alvere::IndexBuffer * VertexArray::GetIndexBuffer() const
 	{
 		return m_IndexBuffer;
 	}
@@ -6,6 +6,8 @@
 
 namespace alvere::graphics_api::opengl
 {
+	//Editing a vertex array binds it through the StateCache and leaves it bound, so drawing straight after costs no bind.
+	//Index buffers bind vertex array 0 before uploading, so one left bound never picks up their element array binding.
 	class VertexArray
 	{
 	public:
@@ -17,15 +19,27 @@ namespace alvere::graphics_api::opengl
 		void Bind();
 		void Unbind();
 
-		void AddVertexBuffer(VertexBuffer * buffer);
-		void SetIndexBuffer(IndexBuffer * buffer);
+		void AddVertexBuffer(alvere::VertexBuffer * buffer);
 
-		const std::vector<VertexBuffer *>& GetVertexBuffers() const;
-		const IndexBuffer * GetIndexBuffer() const;
+		//Replaces every vertex buffer added so far
+		void SetVertexBuffer(alvere::VertexBuffer * buffer);
+
+		//Attributes from an instance buffer advance once per instance instead of once per vertex. They take the
+		//locations from firstLocation on, so they can sit after a vertex buffer's.
+		void AddInstanceBuffer(alvere::VertexBuffer * buffer, unsigned int firstLocation = 0);
+
+		//Points an instance buffer's attributes at a later instance, since GL 3.3 has no base instance to draw from
+		void SetInstanceOffset(alvere::VertexBuffer * buffer, unsigned int firstInstance, unsigned int firstLocation = 0);
+		void SetIndexBuffer(alvere::IndexBuffer * buffer);
+
+		const std::vector<alvere::VertexBuffer *>& GetVertexBuffers() const;
+		const alvere::IndexBuffer * GetIndexBuffer() const;
 
 	private:
+		void SetAttributePointers(alvere::VertexBuffer * buffer, std::size_t baseOffset, unsigned int divisor, unsigned int firstLocation);
+
 		unsigned int m_Handle;
-		std::vector<VertexBuffer *> m_VertexBuffers;
-		IndexBuffer * m_IndexBuffer;
+		std::vector<alvere::VertexBuffer *> m_VertexBuffers;
+		alvere::IndexBuffer * m_IndexBuffer;
 	};
 }
\ No newline at end of file
@@ -1,15 +1,17 @@
 #version 330 core
 
-//uniform struct {
-//	mat4 u_
-//} rendererInput;
-
-uniform mat4 u_projectionMatrix;
-uniform mat4 u_viewMatrix;
-uniform mat4 u_modelMatrix;
+layout(std140) uniform FrameConstants
+{
+	mat4 u_projectionMatrix;
+	mat4 u_viewMatrix;
+	mat4 u_projectionViewMatrix;
+	float u_time;
+};
 
 layout(location = 0) in vec3 a_position;
 layout(location = 1) in vec3 a_texCoords;
+//Per instance, see ALV_RENDERER_MODEL_MATRIX_LOCATION
+layout(location = 8) in mat4 a_modelMatrix;
 
 out vec3 v_texCoords;
 
@@ -17,5 +19,5 @@ void main()
 {
 	v_texCoords = a_texCoords;
 
-	gl_Position = u_projectionMatrix * u_viewMatrix * u_modelMatrix * vec4(a_position, 1.0);
+	gl_Position = u_projectionViewMatrix * a_modelMatrix * vec4(a_position, 1.0);
 }
\ No newline at end of file
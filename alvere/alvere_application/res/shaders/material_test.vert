@@ -1,6 +1,12 @@
 #version 330 core
 
-uniform mat4 u_ProjectionView;
+layout(std140) uniform FrameConstants
+{
+	mat4 u_projectionMatrix;
+	mat4 u_viewMatrix;
+	mat4 u_projectionViewMatrix;
+	float u_time;
+};
 
 layout(location = 0) in vec3 a_Position;
 
@@ -9,5 +15,5 @@ out vec3 v_Position;
 void main()
 {
 	v_Position = a_Position;
-	gl_Position = u_ProjectionView * vec4(a_Position, 1.0);
+	gl_Position = u_projectionViewMatrix * vec4(a_Position, 1.0);
 }
\ No newline at end of file
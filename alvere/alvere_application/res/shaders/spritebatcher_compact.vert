@@ -0,0 +1,26 @@
+#version 330 core
+
+uniform mat4 u_ProjectionView;
+
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec2 a_TexCoords;
+layout(location = 2) in vec4 a_Colour;
+layout(location = 3) in uint a_TextureIndexAndLayer;
+
+out vec3 v_Position;
+out vec2 v_TexCoords;
+out vec4 v_Colour;
+flat out int v_TextureIndex;
+
+void main()
+{
+	//The texture index is in the low byte and the layer is in the top 16 bits, quantised over [0, 1]
+	float layer = float(a_TextureIndexAndLayer >> 16u) / 65535.0;
+
+	v_Position = vec3(a_Position, layer);
+	v_TexCoords = a_TexCoords;
+	v_Colour = a_Colour;
+	v_TextureIndex = int(a_TextureIndexAndLayer & 0xFFu);
+
+	gl_Position = u_ProjectionView * vec4(v_Position, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#version 330 core
+
+uniform mat4 u_ProjectionView;
+
+layout(location = 0) in vec4 a_Destination;
+layout(location = 1) in vec4 a_TexCoords;
+layout(location = 2) in vec4 a_Colour;
+layout(location = 3) in uint a_TextureIndexAndLayer;
+
+out vec3 v_Position;
+out vec2 v_TexCoords;
+out vec4 v_Colour;
+flat out int v_TextureIndex;
+
+void main()
+{
+	//Drawn as a triangle strip of top left, bottom left, top right, bottom right
+	vec2 corner = vec2(float(gl_VertexID >> 1), float(1 - (gl_VertexID & 1)));
+
+	float layer = float(a_TextureIndexAndLayer >> 16u) / 65535.0;
+
+	v_Position = vec3(a_Destination.xy + corner * a_Destination.zw, layer);
+	//The texture coordinates are the bottom left then the top right of the source
+	v_TexCoords = mix(a_TexCoords.xy, a_TexCoords.zw, corner);
+	v_Colour = a_Colour;
+	v_TextureIndex = int(a_TextureIndexAndLayer & 0xFFu);
+
+	gl_Position = u_ProjectionView * vec4(v_Position, 1.0);
+}
\ No newline at end of file
@@ -3,9 +3,13 @@
 #include <alvere/math/vectors.hpp>
 #include <alvere/world/component/pooled_component.hpp>
 
+#include "physics/collision_layers.hpp"
+
 struct ColliderInstance
 {
 	alvere::Rect m_LocalBounds;
+	std::uint32_t m_Category = CollisionLayer_Default;
+	std::uint32_t m_Mask = CollisionLayer_All;
 };
 
 class C_Collider : public alvere::PooledComponent<C_Collider>
@@ -11,6 +11,9 @@ public:
 	float m_Horizontal;
 	bool m_Jump;
 
+	//Time left that holding jump keeps pushing the entity upwards
+	float m_JumpTimeRemaining = -1.0f;
+
 	virtual std::string to_string() const
 	{
 		std::string str = "";
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <alvere/world/component/pooled_component.hpp>
+
+//Lets S_Sleep put the entity to sleep when it has been still for long enough or is far from every camera
+class C_Sleep : public alvere::PooledComponent<C_Sleep>
+{
+public:
+
+	//Number of ticks in a row the entity has been moving slower than the sleep speed
+	unsigned int m_StillTicks = 0;
+
+	virtual std::string to_string() const
+	{
+		std::string str = "";
+
+		str += "Still ticks: " + std::to_string(m_StillTicks) + '\n';
+
+		return str;
+	}
+};
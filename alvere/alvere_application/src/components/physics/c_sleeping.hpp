@@ -0,0 +1,29 @@
+#pragma once
+
+#include <alvere/world/component/pooled_component.hpp>
+
+//Added and removed by S_Sleep. The physics systems exclude anything with this component.
+class C_Sleeping : public alvere::PooledComponent<C_Sleeping>
+{
+public:
+
+	enum class Reason
+	{
+		//Was moving slower than the sleep speed for long enough. Cameras don't wake these, only contacts and impulses do.
+		Idle,
+
+		//Was further than the sleep distance from every camera, so it wakes as soon as a camera comes within the wake distance
+		Distant,
+	};
+
+	Reason m_Reason = Reason::Idle;
+
+	virtual std::string to_string() const
+	{
+		std::string str = "";
+
+		str += std::string("Reason: ") + (m_Reason == Reason::Idle ? "Idle" : "Distant") + '\n';
+
+		return str;
+	}
+};
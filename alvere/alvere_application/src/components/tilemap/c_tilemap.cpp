@@ -1,6 +1,9 @@
 #include "c_tilemap.hpp"
 #include "editor/io/serialization_utils.hpp"
 
+unsigned int C_Tilemap::s_versionCounter = 0;
+unsigned int C_Tilemap::s_tileAppearanceVersion = 0;
+
 C_Tilemap::C_Tilemap()
 	: m_size({ 0, 0 })
 	, m_tileSize({ 0, 0 })
@@ -12,6 +15,7 @@ C_Tilemap::C_Tilemap(alvere::Vector2i size, alvere::Vector2 tileSize)
 	, m_tileSize(tileSize)
 	, m_map(std::make_unique<TileInstance[]>(size[0] * size[1]))
 {
+	ResetChunks();
 }
 
 //These values can be negative
@@ -41,13 +45,47 @@ void C_Tilemap::Resize(int left, int right, int top, int bottom)
 
 	m_size = newSize;
 	m_map = std::move(newMap);
+	ResetChunks();
 	UpdateTiles(GetBounds());
 }
 
+void C_Tilemap::ResetChunks()
+{
+	alvere::Vector2i chunkCount = GetChunkCount();
+	m_chunkVersions.assign(chunkCount[0] * chunkCount[1], NextVersion());
+}
+
+void C_Tilemap::MarkDirty(alvere::RectI area)
+{
+	area = alvere::RectI::overlap(area, GetBounds());
+	if (area.m_width <= 0 || area.m_height <= 0)
+	{
+		return;
+	}
+
+	unsigned int version = NextVersion();
+	int chunksWide = GetChunkCount()[0];
+
+	for (int y = area.getBottom() / CHUNK_SIZE; y <= (area.getTop() - 1) / CHUNK_SIZE; ++y)
+	{
+		for (int x = area.getLeft() / CHUNK_SIZE; x <= (area.getRight() - 1) / CHUNK_SIZE; ++x)
+		{
+			m_chunkVersions[x + y * chunksWide] = version;
+		}
+	}
+}
+
+alvere::RectI C_Tilemap::GetChunkBounds(alvere::Vector2i chunk) const
+{
+	alvere::RectI bounds{ chunk[0] * CHUNK_SIZE, chunk[1] * CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE };
+	return alvere::RectI::overlap(bounds, GetBounds());
+}
+
 void C_Tilemap::UpdateTiles(alvere::RectI area)
 {
 	//Ensure the given area is within the tilemap bounds
 	area = alvere::RectI::overlap(area, {0, 0, m_size[0], m_size[1]});
+	MarkDirty(area);
 
 	for (int y = 0; y < area.m_height; ++y)
 	{
@@ -175,6 +213,23 @@ bool C_Tilemap::TileCollides_s(alvere::Vector2i position) const
 	return tile == nullptr ? false : tile->m_collides;
 }
 
+bool C_Tilemap::TileCollides_s(alvere::Vector2i position, std::uint32_t category, std::uint32_t mask) const
+{
+	if (position[0] < 0 || position[1] < 0 || position[0] >= m_size[0] || position[1] >= m_size[1])
+	{
+		return false;
+	}
+
+	//Empty tiles are solid, the same as above, and sit on the default layer
+	Tile * tile = m_map[position[0] + position[1] * m_size[0]].m_tile;
+	if (tile == nullptr)
+	{
+		return CollisionFiltersMatch(CollisionLayer_Default, CollisionLayer_All, category, mask);
+	}
+
+	return tile->m_collides && CollisionFiltersMatch(tile->m_collisionCategory, tile->m_collisionMask, category, mask);
+}
+
 void C_Tilemap::DemoFill()
 {
 	SetTiles(GetBounds(), &m_tiles[1]);
@@ -210,6 +265,12 @@ bool C_Tilemap::Load(std::fstream & file)
 
 		serialization::Read(file, m_tiles[i].m_spritesheet.m_tileSize);
 		serialization::Read(file, m_tiles[i].m_collides);
+
+		if (version >= 2u)
+		{
+			serialization::Read(file, m_tiles[i].m_collisionCategory);
+			serialization::Read(file, m_tiles[i].m_collisionMask);
+		}
 	}
 	
 	TileInstance * map = m_map.get();
@@ -229,6 +290,8 @@ bool C_Tilemap::Load(std::fstream & file)
 		serialization::Read(file, tileInstance.m_spritesheetCoordinate);
 	}
 
+	MarkDirty(GetBounds());
+
 	return true;
 }
 
@@ -5,18 +5,26 @@
 #include <alvere/world/component/pooled_component.hpp>
 
 #include "tilemap/tile.hpp"
+#include "tilemap/tilemap_query.hpp"
 
 struct C_Tilemap : public alvere::PooledComponent<C_Tilemap>
 {
-	const static unsigned int SAVE_VERSION = 1u;
+	const static unsigned int SAVE_VERSION = 2u;
 	const static unsigned int OLDEST_LOADABLE_SAVE_VERSION = 1u;
 
+	//Width and height in tiles of the areas that renderers cache
+	const static int CHUNK_SIZE = 32;
+
 	alvere::Vector2i m_size;
 	alvere::Vector2 m_tileSize;
 
 	std::unique_ptr<TileInstance[]> m_map;
 	std::vector<Tile> m_tiles;
 
+	//Changed whenever a tile in the chunk changes. Versions are unique across every tilemap,
+	//so a renderer can tell a chunk has changed even if the whole tilemap was replaced.
+	std::vector<unsigned int> m_chunkVersions;
+
 
 
 	C_Tilemap();
@@ -31,6 +39,17 @@ struct C_Tilemap : public alvere::PooledComponent<C_Tilemap>
 
 	void Resize(int left, int right, int top, int bottom); //These values can be negative
 
+	//Anything that writes to m_map directly needs to call this afterwards
+	void MarkDirty(alvere::RectI area);
+
+	alvere::Vector2i GetChunkCount() const { return { (m_size[0] + CHUNK_SIZE - 1) / CHUNK_SIZE, (m_size[1] + CHUNK_SIZE - 1) / CHUNK_SIZE }; }
+	alvere::RectI GetChunkBounds(alvere::Vector2i chunk) const;
+	unsigned int GetChunkVersion(alvere::Vector2i chunk) const { return m_chunkVersions[chunk[0] + chunk[1] * GetChunkCount()[0]]; }
+
+	//Changed whenever the look of any tile is edited, rather than where tiles are placed
+	static unsigned int GetTileAppearanceVersion() { return s_tileAppearanceVersion; }
+	static void MarkTileAppearanceChanged() { s_tileAppearanceVersion = NextVersion(); }
+
 	alvere::RectI GetBounds() const { return { 0, 0, m_size[0], m_size[1] }; }
 
 	alvere::Vector2i WorldToTilemap(alvere::Vector2 worldPosition) const;
@@ -39,6 +58,8 @@ struct C_Tilemap : public alvere::PooledComponent<C_Tilemap>
 	alvere::Vector2 WorldToLocal(alvere::Vector2 worldPosition) const;
 	alvere::Vector2 LocalToWorld(alvere::Vector2 localPosition) const;
 
+	TilemapQuery Query(std::uint32_t category = CollisionLayer_All, std::uint32_t mask = CollisionLayer_All) const { return TilemapQuery(*this, category, mask); }
+
 	bool Load(std::fstream & file);
 
 	virtual std::string to_string() const;
@@ -46,5 +67,15 @@ struct C_Tilemap : public alvere::PooledComponent<C_Tilemap>
 	//These methods are temporary
 	TileDirection GetUnmatchingSurroundings(alvere::Vector2i position, bool collides) const;
 	bool TileCollides_s(alvere::Vector2i position) const;
+	bool TileCollides_s(alvere::Vector2i position, std::uint32_t category, std::uint32_t mask) const;
 	void DemoFill();
+
+private:
+
+	static unsigned int s_versionCounter;
+	static unsigned int s_tileAppearanceVersion;
+
+	static unsigned int NextVersion() { return ++s_versionCounter; }
+
+	void ResetChunks();
 };
\ No newline at end of file
@@ -0,0 +1,1362 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <alvere/debug/command_console/arg.hpp>
+#include <alvere/debug/command_console/command.hpp>
+#include <alvere/debug/command_console/command_console.hpp>
+#include <alvere/debug/command_console/param.hpp>
+#include <alvere/graphics/graphics_api.hpp>
+#include <alvere/graphics/mesh.hpp>
+#include <alvere/graphics/mesh_cache.hpp>
+#include <alvere/graphics/mesh_optimiser.hpp>
+#include <alvere/graphics/render_thread.hpp>
+#include <alvere/graphics/renderer.hpp>
+#include <alvere/graphics/sprite_batcher.hpp>
+#include <alvere/graphics/sprite_vertices.hpp>
+#include <alvere/graphics/texture.hpp>
+#include <alvere/graphics/texture_cache.hpp>
+#include <alvere/graphics/texture_loader.hpp>
+#include <alvere/world/world.hpp>
+#include <alvere/utils/radix_sort.hpp>
+#include <alvere/utils/thread_pool.hpp>
+#include <alvere/world/component/components/c_camera.hpp>
+#include <alvere/world/component/components/c_transform.hpp>
+#include <graphics_api/null/null_command_log.hpp>
+
+#include "benchmarks.hpp"
+#include "components/physics/c_collider.hpp"
+#include "components/physics/c_velocity.hpp"
+#include "components/physics/c_movement.hpp"
+#include "components/physics/c_gravity.hpp"
+#include "components/physics/c_friction.hpp"
+#include "components/physics/c_tilemap_collision.hpp"
+#include "components/physics/c_sleep.hpp"
+#include "components/tilemap/c_tilemap.hpp"
+#include "systems/physics/s_entity_collision.hpp"
+#include "systems/physics/s_physics_integration.hpp"
+#include "systems/physics/s_physics_pipeline.hpp"
+#include "systems/physics/s_sleep.hpp"
+#include "systems/physics/s_tilemap_collision_resolution.hpp"
+#include "systems/physics/s_gravity.hpp"
+#include "systems/physics/s_friction.hpp"
+#include "systems/physics/s_velocity.hpp"
+#include "systems/s_movement.hpp"
+#include "systems/s_jump.hpp"
+
+using BenchmarkClock = std::chrono::high_resolution_clock;
+
+static std::vector<std::unique_ptr<alvere::console::Command>> s_benchmarkCommands;
+
+static double MillisecondsSince(BenchmarkClock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(BenchmarkClock::now() - start).count();
+}
+
+static unsigned int GetArgOrDefault(const std::vector<const alvere::console::IArg *> & args, std::size_t index, unsigned int defaultValue)
+{
+	return index < args.size() && args[index] != nullptr ? args[index]->getValue<unsigned int>() : defaultValue;
+}
+
+static std::size_t CountOverlappingPairs(alvere::World & world)
+{
+	alvere::Archetype::Query query;
+	query.Include<alvere::C_Transform, C_Collider>();
+	std::vector<std::reference_wrapper<alvere::Archetype>> archetypes;
+	world.QueryArchetypes(query, archetypes);
+
+	std::vector<alvere::Rect> bounds;
+	for (alvere::Archetype & archetype : archetypes)
+	{
+		for (const alvere::EntityHandle & entity : archetype.GetEntities())
+		{
+			alvere::Vector2 position = archetype.GetComponent<alvere::C_Transform>(entity)->getPosition();
+			const alvere::Rect & local = archetype.GetComponent<C_Collider>(entity).m_ColliderInstances[0].m_LocalBounds;
+			bounds.emplace_back(position + local.getBottomLeft(), alvere::Vector2(local.m_width, local.m_height));
+		}
+	}
+
+	std::size_t pairs = 0;
+	for (std::size_t i = 0; i < bounds.size(); ++i)
+	{
+		for (std::size_t j = i + 1; j < bounds.size(); ++j)
+		{
+			pairs += bounds[i].getLeft() < bounds[j].getRight() && bounds[j].getLeft() < bounds[i].getRight()
+				&& bounds[i].getBottom() < bounds[j].getTop() && bounds[j].getBottom() < bounds[i].getTop();
+		}
+	}
+
+	return pairs;
+}
+
+static alvere::CompositeText RunBroadphaseBenchmark(unsigned int colliderCount, unsigned int ticks)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	//Roughly four colliders per 8x8 area so every tick has a realistic number of pairs
+	float worldSize = std::sqrt((float) colliderCount) * 4.0f;
+
+	alvere::World world;
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(0.0f, worldSize);
+	std::uniform_real_distribution<float> speed(-10.0f, 10.0f);
+
+	for (unsigned int i = 0; i < colliderCount; ++i)
+	{
+		alvere::EntityHandle entity = world.SpawnEntity<alvere::C_Transform, C_Collider, C_Velocity>();
+
+		world.GetComponent<alvere::C_Transform>(entity)->setPosition({ position(random), position(random), 0.0f });
+		world.GetComponent<C_Collider>(entity).AddInstance({ alvere::Rect(-0.5f, -0.5f, 1.0f, 1.0f) });
+		world.GetComponent<C_Velocity>(entity).m_Velocity = { speed(random), speed(random) };
+	}
+
+	S_EntityCollision collision;
+
+	alvere::Archetype::Query query;
+	query.Include<alvere::C_Transform, C_Velocity>();
+	std::vector<std::reference_wrapper<alvere::Archetype>> archetypes;
+	world.QueryArchetypes(query, archetypes);
+
+	const float deltaTime = 1.0f / 60.0f;
+
+	//Check the grid against the naive O(n^2) answer once before timing anything
+	collision.Update(world, deltaTime);
+	std::size_t bruteForcePairs = CountOverlappingPairs(world);
+	if (bruteForcePairs != collision.GetPairs().size())
+	{
+		output.append("broadphase: found " + std::to_string(collision.GetPairs().size()) + " pairs, expected " + std::to_string(bruteForcePairs) + "\n");
+	}
+
+	double totalMilliseconds = 0.0;
+	std::size_t totalPairs = 0;
+
+	for (unsigned int tick = 0; tick < ticks; ++tick)
+	{
+		//Move everything, bouncing off the edges of the area so the density stays the same
+		for (alvere::Archetype & archetype : archetypes)
+		{
+			for (const alvere::EntityHandle & entity : archetype.GetEntities())
+			{
+				alvere::C_Transform & transform = archetype.GetComponent<alvere::C_Transform>(entity);
+				C_Velocity & velocity = archetype.GetComponent<C_Velocity>(entity);
+
+				alvere::Vector2 next = alvere::Vector2(transform->getPosition()) + velocity.m_Velocity * deltaTime;
+				if (next.x < 0.0f || next.x > worldSize) velocity.m_Velocity.x = -velocity.m_Velocity.x;
+				if (next.y < 0.0f || next.y > worldSize) velocity.m_Velocity.y = -velocity.m_Velocity.y;
+
+				transform->move(velocity.m_Velocity * deltaTime);
+			}
+		}
+
+		BenchmarkClock::time_point start = BenchmarkClock::now();
+		collision.Update(world, deltaTime);
+		totalMilliseconds += MillisecondsSince(start);
+		totalPairs += collision.GetPairs().size();
+	}
+
+	output.append("broadphase: " + std::to_string(colliderCount) + " colliders, " + std::to_string(ticks) + " ticks\n");
+	output.append("  avg update: " + std::to_string(totalMilliseconds / std::max(ticks, 1u)) + " ms\n");
+	output.append("  avg pairs: " + std::to_string(totalPairs / std::max(ticks, 1u))
+		+ ", contacts last tick: " + std::to_string(collision.GetContacts().size()) + "\n");
+	output.append("  grid cells: " + std::to_string(collision.GetBroadphase().GetCellCount()) + "\n");
+
+	return output;
+}
+
+//Every third body is a full player style body, every third only has gravity and the rest just move
+static void SpawnIntegrationBodies(alvere::World & world, unsigned int count, std::vector<alvere::EntityHandle> & bodies)
+{
+	std::mt19937 random(4321);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> speed(-30.0f, 30.0f);
+
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		alvere::EntityHandle entity;
+		switch (i % 3)
+		{
+			case 0: entity = world.SpawnEntity<alvere::C_Transform, C_Velocity, C_Movement, C_TilemapCollision, C_Gravity, C_Friction>(); break;
+			case 1: entity = world.SpawnEntity<alvere::C_Transform, C_Velocity, C_Gravity>(); break;
+			default: entity = world.SpawnEntity<alvere::C_Transform, C_Velocity>(); break;
+		}
+
+		world.GetComponent<alvere::C_Transform>(entity)->setPosition({ position(random), position(random), 0.0f });
+		world.GetComponent<C_Velocity>(entity).m_Velocity = { speed(random), speed(random) };
+		bodies.push_back(entity);
+	}
+}
+
+//Bit 0 and 1 pick the horizontal input, bit 2 is jump held and bit 3 is on ground
+static void ApplyRecordedInput(alvere::World & world, const std::vector<alvere::EntityHandle> & bodies, const std::uint8_t * input)
+{
+	for (std::size_t i = 0; i < bodies.size(); i += 3)
+	{
+		C_Movement & movement = world.GetComponent<C_Movement>(bodies[i]);
+		movement.m_Horizontal = (float) (input[i] & 3) - 1.0f;
+		movement.m_Jump = (input[i] & 4) != 0;
+
+		world.GetComponent<C_TilemapCollision>(bodies[i]).m_OnGround = (input[i] & 8) != 0;
+	}
+}
+
+static bool BitwiseEqual(float a, float b)
+{
+	return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+static alvere::CompositeText RunIntegrationBenchmark(unsigned int bodyCount, unsigned int ticks)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	const float deltaTime = 1.0f / 60.0f;
+	const IntegrationParameters parameters{ 15.0f, 10.0f, 20.0f, 0.2f, { 0.0f, -70.0f }, { 100.0f, 0.0f } };
+
+	alvere::World chainWorld;
+	alvere::World fusedWorld;
+	std::vector<alvere::EntityHandle> chainBodies;
+	std::vector<alvere::EntityHandle> fusedBodies;
+	SpawnIntegrationBodies(chainWorld, bodyCount, chainBodies);
+	SpawnIntegrationBodies(fusedWorld, bodyCount, fusedBodies);
+
+	//Record the input up front so both worlds see exactly the same thing every tick
+	std::vector<std::uint8_t> recording((std::size_t) bodyCount * ticks);
+	std::mt19937 random(8765);
+	for (std::uint8_t & input : recording)
+	{
+		input = (std::uint8_t) (random() % 16);
+		input = (input & 3) == 3 ? input & ~3 : input;
+	}
+
+	S_Movement movement(parameters.m_HorizontalSpeed, parameters.m_Acceleration);
+	S_Jump jump(parameters.m_JumpStrength, parameters.m_JumpDuration);
+	S_Gravity gravity(parameters.m_Gravity);
+	S_Friction friction(parameters.m_Friction);
+	S_Velocity velocity;
+	S_PhysicsIntegration integration(parameters);
+
+	//In the order the fused kernel applies them
+	alvere::UpdatedSystem * chain[] = { &movement, &jump, &gravity, &friction, &velocity };
+
+	double chainMilliseconds = 0.0;
+	double fusedMilliseconds = 0.0;
+
+	for (unsigned int tick = 0; tick < ticks; ++tick)
+	{
+		ApplyRecordedInput(chainWorld, chainBodies, &recording[(std::size_t) tick * bodyCount]);
+		ApplyRecordedInput(fusedWorld, fusedBodies, &recording[(std::size_t) tick * bodyCount]);
+
+		BenchmarkClock::time_point start = BenchmarkClock::now();
+		for (alvere::UpdatedSystem * system : chain)
+		{
+			system->Update(chainWorld, deltaTime);
+		}
+		chainMilliseconds += MillisecondsSince(start);
+
+		start = BenchmarkClock::now();
+		integration.Update(fusedWorld, deltaTime);
+		fusedMilliseconds += MillisecondsSince(start);
+	}
+
+	std::size_t mismatches = 0;
+	for (std::size_t i = 0; i < chainBodies.size(); ++i)
+	{
+		const alvere::Vector3 & chainPosition = chainWorld.GetComponent<alvere::C_Transform>(chainBodies[i])->getPosition();
+		const alvere::Vector3 & fusedPosition = fusedWorld.GetComponent<alvere::C_Transform>(fusedBodies[i])->getPosition();
+		const alvere::Vector2 & chainVelocity = chainWorld.GetComponent<C_Velocity>(chainBodies[i]).m_Velocity;
+		const alvere::Vector2 & fusedVelocity = fusedWorld.GetComponent<C_Velocity>(fusedBodies[i]).m_Velocity;
+
+		bool equal = BitwiseEqual(chainPosition.x, fusedPosition.x) && BitwiseEqual(chainPosition.y, fusedPosition.y)
+			&& BitwiseEqual(chainVelocity.x, fusedVelocity.x) && BitwiseEqual(chainVelocity.y, fusedVelocity.y);
+
+		if (i % 3 == 0)
+		{
+			equal &= BitwiseEqual(chainWorld.GetComponent<C_Movement>(chainBodies[i]).m_JumpTimeRemaining,
+								  fusedWorld.GetComponent<C_Movement>(fusedBodies[i]).m_JumpTimeRemaining);
+		}
+
+		mismatches += equal ? 0 : 1;
+	}
+
+	//Time the kernels on their own, without the gather and scatter through the world
+	IntegrationBodies scalarBodies;
+	for (std::size_t i = 0; i < bodyCount; ++i)
+	{
+		scalarBodies.m_VelocityX.push_back((float) (recording[i] * 3) - 20.0f);
+		scalarBodies.m_VelocityY.push_back((float) (recording[i] * 5) - 40.0f);
+		scalarBodies.m_MoveDirection.push_back((float) (recording[i] & 3) - 1.0f);
+		scalarBodies.m_JumpTimeRemaining.push_back(-1.0f);
+		scalarBodies.m_Flags.push_back(IntegrationFlag_Movement | IntegrationFlag_Jump | IntegrationFlag_Gravity | IntegrationFlag_Friction
+			| ((recording[i] & 4) ? IntegrationFlag_JumpHeld : 0) | ((recording[i] & 8) ? IntegrationFlag_OnGround : 0));
+	}
+	IntegrationBodies vectorBodies = scalarBodies;
+
+	BenchmarkClock::time_point start = BenchmarkClock::now();
+	for (unsigned int tick = 0; tick < ticks; ++tick)
+	{
+		IntegrateBodiesScalar(scalarBodies, parameters, deltaTime);
+	}
+	double scalarMilliseconds = MillisecondsSince(start);
+
+	start = BenchmarkClock::now();
+	for (unsigned int tick = 0; tick < ticks; ++tick)
+	{
+		IntegrateBodies(vectorBodies, parameters, deltaTime);
+	}
+	double vectorMilliseconds = MillisecondsSince(start);
+
+	bool kernelsMatch = std::memcmp(scalarBodies.m_VelocityX.data(), vectorBodies.m_VelocityX.data(), bodyCount * sizeof(float)) == 0
+		&& std::memcmp(scalarBodies.m_VelocityY.data(), vectorBodies.m_VelocityY.data(), bodyCount * sizeof(float)) == 0
+		&& std::memcmp(scalarBodies.m_JumpTimeRemaining.data(), vectorBodies.m_JumpTimeRemaining.data(), bodyCount * sizeof(float)) == 0;
+
+	unsigned int tickCount = std::max(ticks, 1u);
+	output.append("integration: " + std::to_string(bodyCount) + " bodies, " + std::to_string(ticks) + " ticks\n");
+	output.append("  system chain: " + std::to_string(chainMilliseconds / tickCount) + " ms\n");
+	output.append("  fused system: " + std::to_string(fusedMilliseconds / tickCount) + " ms\n");
+	output.append("  scalar kernel: " + std::to_string(scalarMilliseconds / tickCount) + " ms\n");
+	output.append("  kernel: " + std::to_string(vectorMilliseconds / tickCount) + " ms\n");
+	output.append("  bodies not matching the chain: " + std::to_string(mismatches) + "\n");
+	output.append(std::string("  scalar and vector kernels match: ") + (kernelsMatch ? "yes" : "no") + "\n");
+
+	return output;
+}
+
+//A tilemap with a solid border and scattered blocks, with bodies raining down on it
+static void SpawnTilemapCollisionWorld(alvere::World & world, unsigned int count, int mapSize, std::vector<alvere::EntityHandle> & bodies)
+{
+	alvere::EntityHandle tilemapEntity = world.SpawnEntity<C_Tilemap>();
+	C_Tilemap & tilemap = world.GetComponent<C_Tilemap>(tilemapEntity);
+	tilemap = C_Tilemap({ mapSize, mapSize });
+	tilemap.m_tiles.push_back(Tile{ false });
+	tilemap.m_tiles.push_back(Tile{ true });
+
+	//Written straight into the map so no spritesheets are needed
+	std::mt19937 random(2468);
+	for (int y = 0; y < mapSize; ++y)
+	{
+		for (int x = 0; x < mapSize; ++x)
+		{
+			bool border = x == 0 || y == 0 || x == mapSize - 1 || y == mapSize - 1;
+			bool block = random() % 8 == 0;
+			tilemap.m_map[x + y * mapSize].m_tile = &tilemap.m_tiles[border || block ? 1 : 0];
+		}
+	}
+
+	std::uniform_real_distribution<float> position(2.0f, (float) mapSize - 2.0f);
+	std::uniform_real_distribution<float> speed(-10.0f, 10.0f);
+
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		alvere::EntityHandle entity = world.SpawnEntity<alvere::C_Transform, C_Velocity, C_Collider, C_TilemapCollision, C_Gravity>();
+
+		world.GetComponent<alvere::C_Transform>(entity)->setPosition({ position(random), position(random), 0.0f });
+		world.GetComponent<C_Collider>(entity).AddInstance({ alvere::Rect(-0.4f, -0.5f, 0.8f, 1.0f) });
+		world.GetComponent<C_Velocity>(entity).m_Velocity = { speed(random), speed(random) };
+		bodies.push_back(entity);
+	}
+}
+
+static alvere::CompositeText RunTilemapCollisionBenchmark(unsigned int bodyCount, unsigned int ticks)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	const float deltaTime = 1.0f / 60.0f;
+	const IntegrationParameters parameters{ 15.0f, 10.0f, 20.0f, 0.2f, { 0.0f, -70.0f }, { 100.0f, 0.0f } };
+	const int mapSize = std::max(16, (int) std::sqrt((float) bodyCount) * 2);
+
+	alvere::World serialWorld;
+	alvere::World parallelWorld;
+	std::vector<alvere::EntityHandle> serialBodies;
+	std::vector<alvere::EntityHandle> parallelBodies;
+	SpawnTilemapCollisionWorld(serialWorld, bodyCount, mapSize, serialBodies);
+	SpawnTilemapCollisionWorld(parallelWorld, bodyCount, mapSize, parallelBodies);
+
+	alvere::ThreadPool threadPool;
+
+	S_PhysicsIntegration serialIntegration(parameters);
+	S_PhysicsIntegration parallelIntegration(parameters);
+	S_TilemapCollisionResolution serialResolution(serialWorld);
+	S_TilemapCollisionResolution parallelResolution(parallelWorld, &threadPool);
+
+	double serialMilliseconds = 0.0;
+	double parallelMilliseconds = 0.0;
+
+	for (unsigned int tick = 0; tick < ticks; ++tick)
+	{
+		serialIntegration.Update(serialWorld, deltaTime);
+		parallelIntegration.Update(parallelWorld, deltaTime);
+
+		BenchmarkClock::time_point start = BenchmarkClock::now();
+		serialResolution.Update(serialWorld, deltaTime);
+		serialMilliseconds += MillisecondsSince(start);
+
+		start = BenchmarkClock::now();
+		parallelResolution.Update(parallelWorld, deltaTime);
+		parallelMilliseconds += MillisecondsSince(start);
+	}
+
+	std::size_t mismatches = 0;
+	for (std::size_t i = 0; i < serialBodies.size(); ++i)
+	{
+		const alvere::Vector3 & serialPosition = serialWorld.GetComponent<alvere::C_Transform>(serialBodies[i])->getPosition();
+		const alvere::Vector3 & parallelPosition = parallelWorld.GetComponent<alvere::C_Transform>(parallelBodies[i])->getPosition();
+		const alvere::Vector2 & serialVelocity = serialWorld.GetComponent<C_Velocity>(serialBodies[i]).m_Velocity;
+		const alvere::Vector2 & parallelVelocity = parallelWorld.GetComponent<C_Velocity>(parallelBodies[i]).m_Velocity;
+
+		bool equal = BitwiseEqual(serialPosition.x, parallelPosition.x) && BitwiseEqual(serialPosition.y, parallelPosition.y)
+			&& BitwiseEqual(serialVelocity.x, parallelVelocity.x) && BitwiseEqual(serialVelocity.y, parallelVelocity.y)
+			&& serialWorld.GetComponent<C_TilemapCollision>(serialBodies[i]).m_OnGround == parallelWorld.GetComponent<C_TilemapCollision>(parallelBodies[i]).m_OnGround;
+
+		mismatches += equal ? 0 : 1;
+	}
+
+	unsigned int tickCount = std::max(ticks, 1u);
+	output.append("tilemap collision: " + std::to_string(bodyCount) + " bodies, " + std::to_string(mapSize) + "x" + std::to_string(mapSize)
+		+ " tiles, " + std::to_string(threadPool.getThreadCount()) + " threads\n");
+	output.append("  serial: " + std::to_string(serialMilliseconds / tickCount) + " ms\n");
+	output.append("  parallel: " + std::to_string(parallelMilliseconds / tickCount) + " ms\n");
+	output.append("  bodies not matching serial: " + std::to_string(mismatches) + "\n");
+
+	return output;
+}
+
+//The same systems GameplayState runs
+static void AddPhysicsSystems(S_PhysicsPipeline & pipeline, alvere::World & world)
+{
+	pipeline.AddSystem<S_PhysicsIntegration>(IntegrationParameters{ 15.0f, 10.0f, 20.0f, 0.2f, { 0.0f, -70.0f }, { 100.0f, 0.0f } });
+	pipeline.AddSystem<S_TilemapCollisionResolution>(world);
+	pipeline.AddSystem<S_EntityCollision>();
+}
+
+static alvere::CompositeText RunSleepBenchmark(unsigned int bodyCount, unsigned int ticks)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	const float deltaTime = 1.0f / 60.0f;
+	const int mapSize = std::max(16, (int) std::sqrt((float) bodyCount) * 2);
+
+	alvere::World awakeWorld;
+	alvere::World sleepingWorld;
+	std::vector<alvere::EntityHandle> awakeBodies;
+	std::vector<alvere::EntityHandle> sleepingBodies;
+	SpawnTilemapCollisionWorld(awakeWorld, bodyCount, mapSize, awakeBodies);
+	SpawnTilemapCollisionWorld(sleepingWorld, bodyCount, mapSize, sleepingBodies);
+
+	for (alvere::EntityHandle & body : sleepingBodies)
+	{
+		sleepingWorld.AddComponent<C_Sleep>(body);
+	}
+
+	//A camera in one corner, so most of the map is out of view
+	alvere::EntityHandle camera = sleepingWorld.SpawnEntity<alvere::C_Camera>();
+	sleepingWorld.GetComponent<alvere::C_Camera>(camera).setPosition(16.0f, 16.0f, 0.0f);
+
+	S_PhysicsPipeline awakePipeline;
+	S_PhysicsPipeline sleepingPipeline;
+	AddPhysicsSystems(awakePipeline, awakeWorld);
+	AddPhysicsSystems(sleepingPipeline, sleepingWorld);
+	S_Sleep sleep(0.1f, 30, 24.0f, 20.0f);
+
+	double awakeMilliseconds = 0.0;
+	double sleepingMilliseconds = 0.0;
+
+	for (unsigned int tick = 0; tick < ticks; ++tick)
+	{
+		BenchmarkClock::time_point start = BenchmarkClock::now();
+		awakePipeline.Update(awakeWorld, deltaTime);
+		awakeMilliseconds += MillisecondsSince(start);
+
+		start = BenchmarkClock::now();
+		sleep.Update(sleepingWorld, deltaTime);
+		sleepingPipeline.Update(sleepingWorld, deltaTime);
+		sleepingMilliseconds += MillisecondsSince(start);
+	}
+
+	unsigned int tickCount = std::max(ticks, 1u);
+	output.append("sleep: " + std::to_string(bodyCount) + " bodies, " + std::to_string(mapSize) + "x" + std::to_string(mapSize) + " tiles, " + std::to_string(ticks) + " ticks\n");
+	output.append("  without sleeping: " + std::to_string(awakeMilliseconds / tickCount) + " ms\n");
+	output.append("  with sleeping: " + std::to_string(sleepingMilliseconds / tickCount) + " ms\n");
+	output.append("  asleep at the end: " + std::to_string(sleep.GetSleepingCount()) + "\n");
+
+	return output;
+}
+
+template <typename Write>
+static double TimeSpriteWrites(unsigned int spriteCount, unsigned int iterations, Write write)
+{
+	BenchmarkClock::time_point start = BenchmarkClock::now();
+
+	for (unsigned int iteration = 0; iteration < iterations; ++iteration)
+	{
+		for (unsigned int idx = 0; idx < spriteCount; ++idx)
+		{
+			write(idx);
+		}
+	}
+
+	return MillisecondsSince(start) * 1000000.0 / ((double)std::max(spriteCount, 1u) * std::max(iterations, 1u));
+}
+
+static alvere::CompositeText RunSpriteFormatBenchmark(unsigned int spriteCount, unsigned int iterations)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	std::unique_ptr<alvere::Texture> texture = alvere::Texture::New(256, 256);
+
+	//The batchers work this out once per texture slot, not per sprite
+	alvere::Vector2 texelScale = alvere::getTexelScale(*texture);
+
+	struct SpriteInput
+	{
+		alvere::Rect destination;
+		alvere::RectI source;
+		alvere::Vector4 tint;
+		int textureIndex;
+	};
+
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+	std::uniform_int_distribution<int> tile(0, 15);
+	std::uniform_int_distribution<int> textureIndex(0, 15);
+
+	std::vector<SpriteInput> sprites(spriteCount);
+	for (SpriteInput & sprite : sprites)
+	{
+		sprite.destination = alvere::Rect(position(random), position(random), 1.0f, 1.0f);
+		sprite.source = alvere::RectI(tile(random) * 16, tile(random) * 16, 16, 16);
+		sprite.tint = alvere::Vector4::unit;
+		sprite.textureIndex = textureIndex(random);
+	}
+
+	std::vector<alvere::SpriteVertex> vertices(spriteCount * 4);
+	std::vector<alvere::CompactSpriteVertex> compactVertices(spriteCount * 4);
+	std::vector<alvere::SpriteInstance> instances(spriteCount);
+
+	double standardNanoseconds = TimeSpriteWrites(spriteCount, iterations, [&](unsigned int idx)
+	{
+		const SpriteInput & sprite = sprites[idx];
+		alvere::SpriteVertex::writeQuad(&vertices[idx * 4], *texture, sprite.destination, sprite.source, sprite.tint, 0.0f, sprite.textureIndex);
+	});
+
+	double compactNanoseconds = TimeSpriteWrites(spriteCount, iterations, [&](unsigned int idx)
+	{
+		const SpriteInput & sprite = sprites[idx];
+		alvere::CompactSpriteVertex::writeQuad(&compactVertices[idx * 4], texelScale, sprite.destination, sprite.source, sprite.tint, 0.0f, sprite.textureIndex);
+	});
+
+	double instancedNanoseconds = TimeSpriteWrites(spriteCount, iterations, [&](unsigned int idx)
+	{
+		const SpriteInput & sprite = sprites[idx];
+		alvere::SpriteInstance::write(instances[idx], texelScale, sprite.destination, sprite.source, sprite.tint, 0.0f, sprite.textureIndex);
+	});
+
+	output.append("sprite formats: " + std::to_string(spriteCount) + " sprites, " + std::to_string(iterations) + " iterations\n");
+	output.append("  standard: " + std::to_string(sizeof(alvere::SpriteVertex) * 4) + " bytes, " + std::to_string(standardNanoseconds) + " ns per sprite\n");
+	output.append("  compact: " + std::to_string(sizeof(alvere::CompactSpriteVertex) * 4) + " bytes, " + std::to_string(compactNanoseconds) + " ns per sprite\n");
+	output.append("  instanced: " + std::to_string(sizeof(alvere::SpriteInstance)) + " bytes, " + std::to_string(instancedNanoseconds) + " ns per sprite\n");
+
+	return output;
+}
+
+static alvere::CompositeText RunSpriteSortBenchmark(unsigned int spriteCount, unsigned int iterations)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	using SortMode = alvere::SpriteBatcher::SortMode;
+
+	std::mt19937 random(1234);
+	std::uniform_int_distribution<int> layer(-8, 8);
+	std::uniform_int_distribution<uint32_t> textureId(0, 63);
+
+	output.append("sprite sort: " + std::to_string(spriteCount) + " sprites, " + std::to_string(iterations) + " iterations\n");
+
+	const std::pair<SortMode, const char *> modes[] = {
+		{ SortMode::FrontToBack, "front to back" },
+		{ SortMode::BackToFront, "back to front" },
+		{ SortMode::Texture, "texture" } };
+
+	for (const auto & mode : modes)
+	{
+		std::vector<uint64_t> keys(spriteCount);
+		for (uint32_t idx = 0; idx < spriteCount; ++idx)
+		{
+			keys[idx] = alvere::SpriteBatcher::makeSortKey(mode.first, (float)layer(random), textureId(random), idx);
+		}
+
+		std::vector<uint64_t> radixSorted;
+		std::vector<uint64_t> scratch;
+		std::vector<uint64_t> stdSorted;
+
+		BenchmarkClock::time_point start = BenchmarkClock::now();
+		for (unsigned int iteration = 0; iteration < iterations; ++iteration)
+		{
+			radixSorted = keys;
+			alvere::utils::radixSort(radixSorted, scratch, 4);
+		}
+		double radixMilliseconds = MillisecondsSince(start);
+
+		start = BenchmarkClock::now();
+		for (unsigned int iteration = 0; iteration < iterations; ++iteration)
+		{
+			stdSorted = keys;
+			std::sort(stdSorted.begin(), stdSorted.end());
+		}
+		double stdMilliseconds = MillisecondsSince(start);
+
+		unsigned int iterationCount = std::max(iterations, 1u);
+		output.append("  " + std::string(mode.second) + ": radix " + std::to_string(radixMilliseconds / iterationCount) + " ms, std::sort "
+			+ std::to_string(stdMilliseconds / iterationCount) + " ms" + (radixSorted == stdSorted ? "" : ", ORDER MISMATCH") + "\n");
+	}
+
+	return output;
+}
+
+static alvere::CompositeText RunSpriteBatchingBenchmark(unsigned int spriteCount, unsigned int textureCount)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	using SortMode = alvere::SpriteBatcher::SortMode;
+	using VertexFormat = alvere::SpriteBatcher::VertexFormat;
+	using CommandLog = alvere::graphics_api::null::CommandLog;
+
+	//Everything made here only counts what it would have sent to the GPU, so the results don't depend on the driver
+	alvere::GraphicsAPI previousGraphicsAPI = alvere::getGraphicsAPI();
+	alvere::setGraphicsAPI(alvere::GraphicsAPI::Null);
+
+	CommandLog & log = CommandLog::get();
+	bool wasRecording = log.isRecording();
+	log.setRecording(false);
+
+	std::vector<std::unique_ptr<alvere::Texture>> textures;
+	for (unsigned int idx = 0; idx < std::max(textureCount, 1u); ++idx)
+	{
+		textures.emplace_back(alvere::Texture::New(64, 64));
+	}
+
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+	std::uniform_int_distribution<std::size_t> texture(0, textures.size() - 1);
+	std::uniform_int_distribution<int> layer(-8, 8);
+
+	struct SpriteInput
+	{
+		const alvere::Texture * texture;
+		alvere::Rect destination;
+		float sortLayer;
+	};
+
+	std::vector<SpriteInput> sprites(spriteCount);
+	for (SpriteInput & sprite : sprites)
+	{
+		sprite.texture = textures[texture(random)].get();
+		sprite.destination = alvere::Rect(position(random), position(random), 1.0f, 1.0f);
+		sprite.sortLayer = (float)layer(random);
+	}
+
+	output.append("sprite batching: " + std::to_string(spriteCount) + " sprites, " + std::to_string(textures.size()) + " textures\n");
+
+	const std::pair<VertexFormat, const char *> formats[] = {
+		{ VertexFormat::Standard, "standard" },
+		{ VertexFormat::Compact, "compact" },
+		{ VertexFormat::Instanced, "instanced" } };
+
+	const std::pair<SortMode, const char *> modes[] = {
+		{ SortMode::Default, "default" },
+		{ SortMode::BackToFront, "back to front" },
+		{ SortMode::Texture, "texture" } };
+
+	for (const auto & format : formats)
+	{
+		std::unique_ptr<alvere::SpriteBatcher> batcher = alvere::SpriteBatcher::New(ALV_SPRITEBATCH_DEFAULT_CAPACITY, format.first);
+
+		for (const auto & mode : modes)
+		{
+			log.reset();
+
+			batcher->begin(alvere::Matrix4::identity, mode.first);
+			for (const SpriteInput & sprite : sprites)
+			{
+				batcher->submit(sprite.texture, sprite.destination, sprite.texture->getBounds(), alvere::Vector4::unit, sprite.sortLayer);
+			}
+			batcher->end();
+
+			const CommandLog::Counters & counters = log.getCounters();
+			output.append("  " + std::string(format.second) + ", " + mode.second + ": " + std::to_string(counters.drawCalls) + " draws, "
+				+ std::to_string(counters.getStateChanges()) + " state changes, " + std::to_string(counters.bytesUploaded) + " bytes uploaded\n");
+		}
+	}
+
+	textures.clear();
+
+	log.reset();
+	log.setRecording(wasRecording);
+	alvere::setGraphicsAPI(previousGraphicsAPI);
+
+	return output;
+}
+
+static alvere::CompositeText RunRenderThreadBenchmark(unsigned int spriteCount, unsigned int frames)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	alvere::GraphicsAPI previousGraphicsAPI = alvere::getGraphicsAPI();
+	alvere::setGraphicsAPI(alvere::GraphicsAPI::Null);
+
+	alvere::graphics_api::null::CommandLog & log = alvere::graphics_api::null::CommandLog::get();
+	bool wasRecording = log.isRecording();
+	log.setRecording(false);
+
+	std::vector<std::unique_ptr<alvere::Texture>> textures;
+	for (unsigned int idx = 0; idx < 16; ++idx)
+	{
+		textures.emplace_back(alvere::Texture::New(64, 64));
+	}
+
+	struct Body
+	{
+		alvere::Vector2 position;
+		alvere::Vector2 velocity;
+		const alvere::Texture * texture;
+	};
+
+	struct SpriteInput
+	{
+		const alvere::Texture * texture;
+		alvere::Rect destination;
+	};
+
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> distribution(-500.0f, 500.0f);
+
+	std::vector<Body> bodies(spriteCount);
+	for (std::size_t idx = 0; idx < bodies.size(); ++idx)
+	{
+		bodies[idx].position = alvere::Vector2(distribution(random), distribution(random));
+		bodies[idx].velocity = alvere::Vector2(distribution(random), distribution(random)) * 0.01f;
+		bodies[idx].texture = textures[idx % textures.size()].get();
+	}
+
+	std::unique_ptr<alvere::SpriteBatcher> batcher = alvere::SpriteBatcher::New();
+
+	//One snapshot per command list. The render thread is never more than a frame behind, so the snapshot
+	//recorded two frames ago is always finished with by the time it is written again.
+	std::vector<SpriteInput> snapshots[2];
+
+	auto simulate = [&bodies]()
+	{
+		for (Body & body : bodies)
+		{
+			body.velocity.y -= 0.0981f;
+			body.position += body.velocity;
+			if (body.position.y < -500.0f)
+			{
+				body.position.y = -500.0f;
+				body.velocity.y = std::abs(body.velocity.y) * 0.9f;
+			}
+		}
+	};
+
+	//The front end only copies what the back end needs. Sorting, writing vertices and submitting happen when the list is executed.
+	auto record = [&](alvere::CommandList & list, std::vector<SpriteInput> & snapshot)
+	{
+		snapshot.resize(bodies.size());
+		for (std::size_t idx = 0; idx < bodies.size(); ++idx)
+		{
+			snapshot[idx].texture = bodies[idx].texture;
+			snapshot[idx].destination = alvere::Rect(bodies[idx].position.x, bodies[idx].position.y, 1.0f, 1.0f);
+		}
+
+		alvere::SpriteBatcher * spriteBatcher = batcher.get();
+		const std::vector<SpriteInput> * sprites = &snapshot;
+		list.record([spriteBatcher, sprites]()
+		{
+			spriteBatcher->begin(alvere::Matrix4::identity, alvere::SpriteBatcher::SortMode::Texture);
+			for (const SpriteInput & sprite : *sprites)
+			{
+				spriteBatcher->submit(sprite.texture, sprite.destination, sprite.texture->getBounds());
+			}
+			spriteBatcher->end();
+		});
+	};
+
+	output.append("render thread: " + std::to_string(spriteCount) + " sprites, " + std::to_string(frames) + " frames\n");
+
+	{
+		alvere::CommandList list;
+
+		BenchmarkClock::time_point start = BenchmarkClock::now();
+		for (unsigned int frame = 0; frame < frames; ++frame)
+		{
+			simulate();
+			record(list, snapshots[0]);
+			list.execute();
+			log.reset();
+		}
+		double milliseconds = MillisecondsSince(start);
+
+		output.append("  one thread: " + std::to_string(milliseconds / std::max(frames, 1u)) + " ms per frame\n");
+	}
+
+	{
+		alvere::RenderThread renderThread(nullptr, [&log]() { log.reset(); });
+
+		BenchmarkClock::time_point start = BenchmarkClock::now();
+		for (unsigned int frame = 0; frame < frames; ++frame)
+		{
+			simulate();
+			record(renderThread.getCommandList(), snapshots[frame % 2]);
+			renderThread.submit();
+		}
+		renderThread.wait();
+		double milliseconds = MillisecondsSince(start);
+
+		alvere::RenderThread::Stats stats = renderThread.getStats();
+		output.append("  render thread: " + std::to_string(milliseconds / std::max(frames, 1u)) + " ms per frame, "
+			+ std::to_string(stats.m_framesPerSecond) + " frames per second\n");
+		output.append("  latency " + std::to_string(stats.m_averageLatency * 1000.0) + " ms average, " + std::to_string(stats.m_maximumLatency * 1000.0)
+			+ " ms worst, render thread busy " + std::to_string(stats.m_averageExecuteTime * 1000.0) + " ms, front end waited "
+			+ std::to_string(stats.m_averageWaitTime * 1000.0) + " ms per frame\n");
+	}
+
+	batcher.reset();
+	textures.clear();
+
+	log.reset();
+	log.setRecording(wasRecording);
+	alvere::setGraphicsAPI(previousGraphicsAPI);
+
+	return output;
+}
+
+struct RendererStateChanges
+{
+	unsigned int programs = 0;
+	unsigned int materials = 0;
+	unsigned int meshes = 0;
+	//Runs of the same mesh and material, which the renderer draws instanced
+	unsigned int draws = 0;
+};
+
+struct RendererDrawInput
+{
+	uint32_t program;
+	uint32_t material;
+	uint32_t mesh;
+	float depth;
+};
+
+static RendererStateChanges CountRendererStateChanges(const std::vector<RendererDrawInput> & draws, const std::vector<uint32_t> & order)
+{
+	RendererStateChanges changes;
+	const RendererDrawInput * previous = nullptr;
+
+	for (uint32_t idx : order)
+	{
+		const RendererDrawInput & draw = draws[idx];
+
+		changes.programs += previous == nullptr || previous->program != draw.program;
+		changes.materials += previous == nullptr || previous->material != draw.material;
+		changes.meshes += previous == nullptr || previous->mesh != draw.mesh;
+		changes.draws += previous == nullptr || previous->material != draw.material || previous->mesh != draw.mesh;
+
+		previous = &draw;
+	}
+
+	return changes;
+}
+
+static alvere::CompositeText RunRendererSortBenchmark(unsigned int drawCount, unsigned int iterations)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	//Every material uses one of a few programs, as they would when most share the engine's shaders
+	const uint32_t programCount = 8;
+	const uint32_t materialCount = 64;
+	const uint32_t meshCount = 32;
+
+	std::mt19937 random(1234);
+	std::uniform_int_distribution<uint32_t> material(0, materialCount - 1);
+	std::uniform_int_distribution<uint32_t> mesh(0, meshCount - 1);
+	std::uniform_real_distribution<float> depth(0.1f, 500.0f);
+
+	std::vector<RendererDrawInput> draws(drawCount);
+	for (RendererDrawInput & draw : draws)
+	{
+		draw.material = material(random);
+		draw.program = draw.material % programCount;
+		draw.mesh = mesh(random);
+		draw.depth = depth(random);
+	}
+
+	std::vector<uint32_t> submissionOrder(drawCount);
+	for (uint32_t idx = 0; idx < drawCount; ++idx)
+	{
+		submissionOrder[idx] = idx;
+	}
+
+	//What Renderer::sortDrawCommands used to do, ordering by nothing but the mesh
+	std::vector<uint32_t> meshOrder;
+	BenchmarkClock::time_point start = BenchmarkClock::now();
+	for (unsigned int iteration = 0; iteration < iterations; ++iteration)
+	{
+		meshOrder = submissionOrder;
+		std::sort(meshOrder.begin(), meshOrder.end(), [&](uint32_t lhs, uint32_t rhs) { return draws[lhs].mesh < draws[rhs].mesh; });
+	}
+	double meshMilliseconds = MillisecondsSince(start);
+
+	std::vector<uint64_t> keys(drawCount);
+	for (uint32_t idx = 0; idx < drawCount; ++idx)
+	{
+		const RendererDrawInput & draw = draws[idx];
+		keys[idx] = alvere::Renderer::makeSortKey(alvere::Renderer::Pass::Opaque, draw.program, draw.material, draw.mesh, draw.depth);
+	}
+
+	std::vector<uint64_t> sortedKeys;
+	std::vector<uint32_t> keyOrder;
+	std::vector<uint64_t> keyScratch;
+	std::vector<uint32_t> orderScratch;
+	start = BenchmarkClock::now();
+	for (unsigned int iteration = 0; iteration < iterations; ++iteration)
+	{
+		sortedKeys = keys;
+		keyOrder = submissionOrder;
+		alvere::utils::radixSort(sortedKeys, keyOrder, keyScratch, orderScratch);
+	}
+	double keyMilliseconds = MillisecondsSince(start);
+
+	//Within a run of the same state, the depth should go front to back
+	bool frontToBack = true;
+	for (std::size_t idx = 1; idx < keyOrder.size(); ++idx)
+	{
+		const RendererDrawInput & previous = draws[keyOrder[idx - 1]];
+		const RendererDrawInput & current = draws[keyOrder[idx]];
+		if (previous.material == current.material && previous.mesh == current.mesh && previous.depth > current.depth)
+		{
+			frontToBack = false;
+		}
+	}
+
+	unsigned int iterationCount = std::max(iterations, 1u);
+
+	const std::pair<const std::vector<uint32_t> *, std::string> orders[] = {
+		{ &submissionOrder, "submission order" },
+		{ &meshOrder, "by mesh, " + std::to_string(meshMilliseconds / iterationCount) + " ms" },
+		{ &keyOrder, "by state key, " + std::to_string(keyMilliseconds / iterationCount) + " ms" + (frontToBack ? "" : ", DEPTH OUT OF ORDER") } };
+
+	output.append("renderer sort: " + std::to_string(drawCount) + " draws, " + std::to_string(programCount) + " programs, " + std::to_string(materialCount) + " materials, "
+		+ std::to_string(meshCount) + " meshes, " + std::to_string(iterations) + " iterations\n");
+
+	for (const auto & order : orders)
+	{
+		RendererStateChanges changes = CountRendererStateChanges(draws, *order.first);
+		output.append("  " + order.second + ": " + std::to_string(changes.programs) + " program, " + std::to_string(changes.materials) + " material and "
+			+ std::to_string(changes.meshes) + " mesh changes, " + std::to_string(changes.draws) + " draws\n");
+	}
+
+	return output;
+}
+
+static void WriteGridObj(const std::string & filepath, unsigned int gridSize)
+{
+	std::ofstream file(filepath, std::ios::trunc);
+
+	for (unsigned int y = 0; y <= gridSize; ++y)
+	{
+		for (unsigned int x = 0; x <= gridSize; ++x)
+		{
+			float u = (float)x / gridSize;
+			float v = (float)y / gridSize;
+			file << "v " << u << " " << std::sin(u * 10.0f) * std::cos(v * 10.0f) << " " << v << "\n";
+			file << "vt " << u << " " << v << "\n";
+		}
+	}
+
+	//OBJ indices start at 1
+	for (unsigned int y = 0; y < gridSize; ++y)
+	{
+		for (unsigned int x = 0; x < gridSize; ++x)
+		{
+			unsigned int a = y * (gridSize + 1) + x + 1;
+			unsigned int b = a + 1;
+			unsigned int c = a + gridSize + 1;
+			unsigned int d = c + 1;
+			file << "f " << a << "/" << a << " " << b << "/" << b << " " << c << "/" << c << "\n";
+			file << "f " << b << "/" << b << " " << d << "/" << d << " " << c << "/" << c << "\n";
+		}
+	}
+}
+
+static alvere::CompositeText RunMeshLoadBenchmark(unsigned int gridSize, unsigned int iterations)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	gridSize = std::max(gridSize, 1u);
+	iterations = std::max(iterations, 1u);
+
+	const std::string filepath = "bench_mesh_load.obj";
+	const std::string cachePath = alvere::mesh_cache::getCachePath(filepath);
+
+	WriteGridObj(filepath, gridSize);
+	std::remove(cachePath.c_str());
+
+	//Both paths upload to the current graphics API, so the difference is only in getting the data ready
+	BenchmarkClock::time_point start = BenchmarkClock::now();
+	for (unsigned int iteration = 0; iteration < iterations; ++iteration)
+	{
+		delete new alvere::Mesh(filepath.c_str(), false);
+	}
+	double importMilliseconds = MillisecondsSince(start) / iterations;
+
+	start = BenchmarkClock::now();
+	delete new alvere::Mesh(filepath.c_str());
+	double firstLoadMilliseconds = MillisecondsSince(start);
+
+	start = BenchmarkClock::now();
+	for (unsigned int iteration = 0; iteration < iterations; ++iteration)
+	{
+		delete new alvere::Mesh(filepath.c_str());
+	}
+	double cachedMilliseconds = MillisecondsSince(start) / iterations;
+
+	std::ifstream cacheFile(cachePath, std::ios::binary | std::ios::ate);
+	std::size_t cacheBytes = cacheFile.is_open() ? (std::size_t)cacheFile.tellg() : 0;
+	cacheFile.close();
+
+	std::remove(filepath.c_str());
+	std::remove(cachePath.c_str());
+
+	unsigned int vertexCount = (gridSize + 1) * (gridSize + 1);
+	output.append("mesh load: " + std::to_string(vertexCount) + " vertices, " + std::to_string(gridSize * gridSize * 2) + " triangles, " + std::to_string(iterations) + " iterations\n");
+	output.append("  assimp: " + std::to_string(importMilliseconds) + " ms\n");
+	output.append("  first load, importing and writing the cache: " + std::to_string(firstLoadMilliseconds) + " ms\n");
+	output.append("  mapped cache: " + std::to_string(cachedMilliseconds) + " ms, " + std::to_string(cacheBytes) + " bytes" + (cacheBytes == 0 ? ", CACHE NOT WRITTEN" : "") + "\n");
+
+	return output;
+}
+
+static alvere::CompositeText RunMeshOptimiseBenchmark(unsigned int gridSize, unsigned int iterations)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	gridSize = std::max(gridSize, 1u);
+	iterations = std::max(iterations, 1u);
+
+	//A triangle soup in shuffled order, the worst an exporter could hand over: no vertex is shared and no
+	//triangle is near the one before it
+	const unsigned int vertexStride = 6;
+	std::vector<uint32_t> triangleOrder(gridSize * gridSize * 2);
+	for (uint32_t idx = 0; idx < triangleOrder.size(); ++idx)
+		triangleOrder[idx] = idx;
+
+	std::mt19937 random(1234);
+	std::shuffle(triangleOrder.begin(), triangleOrder.end(), random);
+
+	std::vector<float> soupVertices;
+	std::vector<uint32_t> soupIndices;
+	soupVertices.reserve(triangleOrder.size() * 3 * vertexStride);
+	soupIndices.reserve(triangleOrder.size() * 3);
+
+	for (uint32_t triangle : triangleOrder)
+	{
+		unsigned int x = (triangle / 2) % gridSize;
+		unsigned int y = (triangle / 2) / gridSize;
+		const unsigned int corners[2][3][2] = { { { 0, 0 }, { 1, 0 }, { 0, 1 } }, { { 1, 0 }, { 1, 1 }, { 0, 1 } } };
+
+		for (const auto & corner : corners[triangle % 2])
+		{
+			float u = (float)(x + corner[0]) / gridSize;
+			float v = (float)(y + corner[1]) / gridSize;
+			soupIndices.push_back((uint32_t)soupIndices.size());
+			soupVertices.insert(soupVertices.end(), { u, 0.0f, v, u, v, 0.0f });
+		}
+	}
+
+	alvere::mesh_optimiser::Report report;
+	double milliseconds = 0.0;
+
+	for (unsigned int iteration = 0; iteration < iterations; ++iteration)
+	{
+		std::vector<float> vertices = soupVertices;
+		std::vector<uint32_t> indices = soupIndices;
+
+		BenchmarkClock::time_point start = BenchmarkClock::now();
+		report = alvere::mesh_optimiser::optimise(vertices, indices, vertexStride);
+		milliseconds += MillisecondsSince(start);
+	}
+
+	uint32_t indexSize = alvere::mesh_cache::getIndexSize(report.m_verticesAfter);
+
+	output.append("mesh optimise: " + std::to_string(triangleOrder.size()) + " triangles, " + std::to_string(iterations) + " iterations, "
+		+ std::to_string(milliseconds / iterations) + " ms\n");
+	output.append("  vertices: " + std::to_string(report.m_verticesBefore) + " -> " + std::to_string(report.m_verticesAfter) + ", "
+		+ std::to_string(indexSize * 8) + " bit indices\n");
+	output.append("  ACMR (" + std::to_string(ALV_MESH_OPTIMISER_ACMR_CACHE_SIZE) + " entry FIFO): " + std::to_string(report.m_acmrBefore) + " -> " + std::to_string(report.m_acmrAfter) + "\n");
+
+	return output;
+}
+
+static void WriteNoisePpm(const std::string & filepath, unsigned int size, std::mt19937 & random)
+{
+	std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+	file << "P6\n" << size << " " << size << "\n255\n";
+
+	std::vector<char> pixels((std::size_t)size * size * 3);
+	for (char & channel : pixels)
+		channel = (char)(random() & 0xff);
+
+	file.write(pixels.data(), pixels.size());
+}
+
+static alvere::CompositeText RunTextureLoadBenchmark(unsigned int textureCount, unsigned int size)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	textureCount = std::max(textureCount, 1u);
+	size = std::max(size, 1u);
+
+	alvere::GraphicsAPI previousGraphicsAPI = alvere::getGraphicsAPI();
+	alvere::setGraphicsAPI(alvere::GraphicsAPI::Null);
+
+	std::mt19937 random(1234);
+	std::vector<std::string> filepaths;
+	for (unsigned int idx = 0; idx < textureCount; ++idx)
+	{
+		filepaths.push_back("bench_texture_load_" + std::to_string(idx) + ".ppm");
+		WriteNoisePpm(filepaths.back(), size, random);
+	}
+
+	for (const std::string & filepath : filepaths)
+		std::remove(alvere::texture_cache::getCachePath(filepath).c_str());
+
+	//Everything the main thread would be stalled for if the textures were asked for mid frame
+	auto timeSynchronousLoad = [&]()
+	{
+		BenchmarkClock::time_point start = BenchmarkClock::now();
+
+		std::vector<std::unique_ptr<alvere::Texture>> textures;
+		for (const std::string & filepath : filepaths)
+			textures.push_back(alvere::Texture::New(filepath.c_str()));
+
+		return MillisecondsSince(start);
+	};
+
+	//The first load decodes each file and cooks its cache, the second only maps the caches
+	double cookingMilliseconds = timeSynchronousLoad();
+	double cachedMilliseconds = timeSynchronousLoad();
+
+	alvere::TextureLoader & loader = alvere::TextureLoader::get();
+
+	BenchmarkClock::time_point start = BenchmarkClock::now();
+	std::vector<std::unique_ptr<alvere::Texture>> textures;
+	for (const std::string & filepath : filepaths)
+		textures.emplace_back(loader.load(filepath));
+	double requestMilliseconds = MillisecondsSince(start);
+
+	//Frames are as fast as the uploads allow, so this is the least number of frames the budget spreads them over
+	unsigned int frames = 0;
+	double longestUploadMilliseconds = 0.0;
+	while (loader.getLoadingCount() > 0)
+	{
+		BenchmarkClock::time_point uploadStart = BenchmarkClock::now();
+		loader.uploadPending();
+		longestUploadMilliseconds = std::max(longestUploadMilliseconds, MillisecondsSince(uploadStart));
+		++frames;
+		std::this_thread::yield();
+	}
+	double asynchronousMilliseconds = MillisecondsSince(start);
+
+	unsigned int failed = 0;
+	std::size_t keptBytes = 0;
+	for (const std::unique_ptr<alvere::Texture> & texture : textures)
+	{
+		if (texture == nullptr)
+		{
+			++failed;
+			continue;
+		}
+
+		if (texture->pixelData() != nullptr)
+			keptBytes += (std::size_t)texture->getDimensions().x * texture->getDimensions().y * texture->channelCount();
+	}
+
+	textures.clear();
+
+	for (const std::string & filepath : filepaths)
+	{
+		std::remove(filepath.c_str());
+		std::remove(alvere::texture_cache::getCachePath(filepath).c_str());
+	}
+
+	alvere::setGraphicsAPI(previousGraphicsAPI);
+
+	std::size_t decodedBytes = (std::size_t)textureCount * size * size * 4;
+
+	output.append("texture load: " + std::to_string(textureCount) + " " + std::to_string(size) + "x" + std::to_string(size) + " textures, "
+		+ std::to_string(loader.getUploadBudget() / 1024) + " KB upload budget\n");
+	output.append("  synchronous: " + std::to_string(cookingMilliseconds) + " ms decoding and cooking, " + std::to_string(cachedMilliseconds) + " ms from the caches\n");
+	output.append("  asynchronous from the caches: " + std::to_string(requestMilliseconds) + " ms to return the placeholders, longest upload "
+		+ std::to_string(longestUploadMilliseconds) + " ms, " + std::to_string(asynchronousMilliseconds) + " ms and " + std::to_string(frames) + " frames until all were uploaded"
+		+ (failed > 0 ? ", " + std::to_string(failed) + " FAILED" : "") + "\n");
+	output.append("  CPU pixels kept after upload: " + std::to_string(keptBytes / 1024) + " KB, against " + std::to_string(decodedBytes / 1024) + " KB decoded\n");
+
+	return output;
+}
+
+void RegisterBenchmarkCommands()
+{
+	if (s_benchmarkCommands.empty() == false)
+	{
+		return;
+	}
+
+	alvere::console::UIntParam broadphaseCount("collider count", "Number of moving colliders to spawn. Defaults to 10000.", false);
+	alvere::console::UIntParam broadphaseTicks("ticks", "Number of ticks to time. Defaults to 60.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.broadphase",
+		"Times S_EntityCollision on a grid of moving colliders.",
+		std::vector<alvere::console::IParam *>{ &broadphaseCount, &broadphaseTicks },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunBroadphaseBenchmark(GetArgOrDefault(args, 0, 10000), GetArgOrDefault(args, 1, 60));
+		}));
+
+	alvere::console::UIntParam integrationCount("body count", "Number of bodies to spawn. Defaults to 100000.", false);
+	alvere::console::UIntParam integrationTicks("ticks", "Number of ticks to run. Defaults to 60.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.integration",
+		"Checks S_PhysicsIntegration matches the separate physics systems bit for bit, then times both.",
+		std::vector<alvere::console::IParam *>{ &integrationCount, &integrationTicks },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunIntegrationBenchmark(GetArgOrDefault(args, 0, 100000), GetArgOrDefault(args, 1, 60));
+		}));
+
+	alvere::console::UIntParam tilemapCollisionCount("body count", "Number of bodies to spawn. Defaults to 20000.", false);
+	alvere::console::UIntParam tilemapCollisionTicks("ticks", "Number of ticks to run. Defaults to 60.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.tilemap_collision",
+		"Checks S_TilemapCollisionResolution gives the same result across the thread pool as it does serially, then times both.",
+		std::vector<alvere::console::IParam *>{ &tilemapCollisionCount, &tilemapCollisionTicks },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunTilemapCollisionBenchmark(GetArgOrDefault(args, 0, 20000), GetArgOrDefault(args, 1, 60));
+		}));
+
+	alvere::console::UIntParam sleepCount("body count", "Number of bodies to spawn. Defaults to 20000.", false);
+	alvere::console::UIntParam sleepTicks("ticks", "Number of ticks to run. Defaults to 120.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.sleep",
+		"Times the physics pipeline with and without S_Sleep on a map mostly out of view of the camera.",
+		std::vector<alvere::console::IParam *>{ &sleepCount, &sleepTicks },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunSleepBenchmark(GetArgOrDefault(args, 0, 20000), GetArgOrDefault(args, 1, 120));
+		}));
+
+	alvere::console::UIntParam spriteFormatCount("sprite count", "Number of sprites to write. Defaults to 65536.", false);
+	alvere::console::UIntParam spriteFormatIterations("iterations", "Number of times to write them all. Defaults to 60.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.sprite_formats",
+		"Compares the bytes written and the CPU time per sprite of the sprite batcher's vertex formats.",
+		std::vector<alvere::console::IParam *>{ &spriteFormatCount, &spriteFormatIterations },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunSpriteFormatBenchmark(GetArgOrDefault(args, 0, 65536), GetArgOrDefault(args, 1, 60));
+		}));
+
+	alvere::console::UIntParam spriteSortCount("sprite count", "Number of sprites to sort. Defaults to 100000.", false);
+	alvere::console::UIntParam spriteSortIterations("iterations", "Number of times to sort them. Defaults to 60.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.sprite_sort",
+		"Checks the sprite batcher's radix sort orders its keys the same as std::sort for each sort mode, then times both.",
+		std::vector<alvere::console::IParam *>{ &spriteSortCount, &spriteSortIterations },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunSpriteSortBenchmark(GetArgOrDefault(args, 0, 100000), GetArgOrDefault(args, 1, 60));
+		}));
+
+	alvere::console::UIntParam spriteBatchingCount("sprite count", "Number of sprites to draw. Defaults to 100000.", false);
+	alvere::console::UIntParam spriteBatchingTextures("texture count", "Number of textures to spread them across. Defaults to 32.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.sprite_batching",
+		"Counts the draws, state changes and bytes uploaded by the sprite batcher for each vertex format and sort mode, using the null graphics backend.",
+		std::vector<alvere::console::IParam *>{ &spriteBatchingCount, &spriteBatchingTextures },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunSpriteBatchingBenchmark(GetArgOrDefault(args, 0, 100000), GetArgOrDefault(args, 1, 32));
+		}));
+
+	alvere::console::UIntParam renderThreadCount("sprite count", "Number of sprites to simulate and draw. Defaults to 100000.", false);
+	alvere::console::UIntParam renderThreadFrames("frames", "Number of frames to run. Defaults to 120.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.render_thread",
+		"Times simulating and drawing sprites on one thread against recording command lists for a render thread, using the null graphics backend.",
+		std::vector<alvere::console::IParam *>{ &renderThreadCount, &renderThreadFrames },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunRenderThreadBenchmark(GetArgOrDefault(args, 0, 100000), GetArgOrDefault(args, 1, 120));
+		}));
+
+	alvere::console::UIntParam rendererSortCount("draw count", "Number of draws to sort. Defaults to 100000.", false);
+	alvere::console::UIntParam rendererSortIterations("iterations", "Number of times to sort them. Defaults to 60.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.renderer_sort",
+		"Counts the program, material and mesh changes of a synthetic scene sorted by mesh alone and by the renderer's state keys, and times both sorts.",
+		std::vector<alvere::console::IParam *>{ &rendererSortCount, &rendererSortIterations },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunRendererSortBenchmark(GetArgOrDefault(args, 0, 100000), GetArgOrDefault(args, 1, 60));
+		}));
+
+	alvere::console::UIntParam meshLoadGridSize("grid size", "Quads along each side of the generated mesh. Defaults to 256.", false);
+	alvere::console::UIntParam meshLoadIterations("iterations", "Number of times to load it each way. Defaults to 10.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.mesh_load",
+		"Times loading a generated grid mesh through Assimp against mapping its mesh cache.",
+		std::vector<alvere::console::IParam *>{ &meshLoadGridSize, &meshLoadIterations },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunMeshLoadBenchmark(GetArgOrDefault(args, 0, 256), GetArgOrDefault(args, 1, 10));
+		}));
+
+	alvere::console::UIntParam meshOptimiseGridSize("grid size", "Quads along each side of the generated mesh. Defaults to 128.", false);
+	alvere::console::UIntParam meshOptimiseIterations("iterations", "Number of times to optimise it. Defaults to 10.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.mesh_optimise",
+		"Welds and reorders a shuffled triangle soup grid for the vertex caches, and reports its vertex count and ACMR before and after.",
+		std::vector<alvere::console::IParam *>{ &meshOptimiseGridSize, &meshOptimiseIterations },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunMeshOptimiseBenchmark(GetArgOrDefault(args, 0, 128), GetArgOrDefault(args, 1, 10));
+		}));
+
+	alvere::console::UIntParam textureLoadCount("texture count", "Number of textures to load. Defaults to 32.", false);
+	alvere::console::UIntParam textureLoadSize("size", "Width and height of each texture. Defaults to 512.", false);
+
+	s_benchmarkCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"bench.texture_load",
+		"Times loading generated textures on the main thread, with and without their texture caches, against the texture loader's workers and upload budget, using the null graphics backend.",
+		std::vector<alvere::console::IParam *>{ &textureLoadCount, &textureLoadSize },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			return RunTextureLoadBenchmark(GetArgOrDefault(args, 0, 32), GetArgOrDefault(args, 1, 512));
+		}));
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+//Registers console commands that time engine and game systems against large synthetic workloads.
+//The commands live as long as the application, so this only needs calling once after the console is initialised.
+void RegisterBenchmarkCommands();
@@ -0,0 +1,86 @@
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <alvere/debug/command_console/arg.hpp>
+#include <alvere/debug/command_console/command.hpp>
+#include <alvere/debug/command_console/command_console.hpp>
+#include <alvere/debug/command_console/param.hpp>
+#include <alvere/graphics/texture.hpp>
+#include <alvere/graphics/texture_cache.hpp>
+
+#include "tools.hpp"
+
+static std::vector<std::unique_ptr<alvere::console::Command>> s_toolCommands;
+
+static bool IsCookableImage(const std::filesystem::path & path)
+{
+	std::string extension = path.extension().string();
+	return extension == ".png" || extension == ".jpg" || extension == ".bmp" || extension == ".tga";
+}
+
+static alvere::CompositeText CookTextures(const std::string & sourcePath, bool premultiply)
+{
+	alvere::CompositeText output(alvere::console::gui::defaultTextFormatting());
+
+	std::vector<std::string> sourcePaths;
+
+	std::error_code error;
+	if (std::filesystem::is_directory(sourcePath, error))
+	{
+		for (const std::filesystem::directory_entry & entry : std::filesystem::recursive_directory_iterator(sourcePath, error))
+		{
+			if (entry.is_regular_file() && IsCookableImage(entry.path()))
+			{
+				sourcePaths.push_back(entry.path().string());
+			}
+		}
+	}
+	else
+	{
+		sourcePaths.push_back(sourcePath);
+	}
+
+	//Cooked the way the game loads them, so the caches are used rather than recooked on first load
+	const int channelCount = (int)alvere::Texture::Channels::RGBAlpha;
+
+	unsigned int cooked = 0;
+	for (const std::string & path : sourcePaths)
+	{
+		if (alvere::texture_cache::cook(path, channelCount, premultiply))
+		{
+			++cooked;
+		}
+		else
+		{
+			output.append("  failed to cook " + path + "\n");
+		}
+	}
+
+	output.append("cooked " + std::to_string(cooked) + " of " + std::to_string(sourcePaths.size()) + " textures"
+		+ (premultiply ? " with premultiplied alpha\n" : "\n"));
+
+	return output;
+}
+
+void RegisterToolCommands()
+{
+	if (s_toolCommands.empty() == false)
+	{
+		return;
+	}
+
+	alvere::console::StringParam cookPath("path", "An image, or a directory to cook every image under.", true);
+	alvere::console::BoolParam cookPremultiply("premultiply", "Multiplies colour by alpha, so sprites drawn with them blend as premultiplied. Defaults to false.", false);
+
+	s_toolCommands.emplace_back(std::make_unique<alvere::console::Command>(
+		"texture.cook",
+		"Writes the texture cache next to each image, so loading it only has to map the file.",
+		std::vector<alvere::console::IParam *>{ &cookPath, &cookPremultiply },
+		[](std::vector<const alvere::console::IArg *> args) -> alvere::CompositeText
+		{
+			bool premultiply = args.size() > 1 && args[1] != nullptr && args[1]->getValue<bool>();
+			return CookTextures(args[0]->getValue<std::string>(), premultiply);
+		}));
+}
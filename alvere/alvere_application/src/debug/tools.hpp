@@ -0,0 +1,5 @@
+#pragma once
+
+//Registers console commands for preparing assets, like cooking texture caches ahead of shipping them.
+//The commands live as long as the application, so this only needs calling once after the console is initialised.
+void RegisterToolCommands();
@@ -59,6 +59,8 @@ void WorldExporter::ExportTilemap(std::fstream & file, const C_Tilemap & tilemap
 		WriteString(file, tile.m_spritesheet.m_texture.getFilepath());
 		Write(file, tile.m_spritesheet.m_tileSize);
 		Write(file, tile.m_collides);
+		Write(file, tile.m_collisionCategory);
+		Write(file, tile.m_collisionMask);
 	}
 
 	//Append the map itself
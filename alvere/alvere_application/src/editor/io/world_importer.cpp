@@ -62,6 +62,12 @@ bool WorldImporter::ImportTilemap(std::fstream & file, C_Tilemap & tilemap)
 		Read(file, tile.m_spritesheet.m_tileSize);
 		Read(file, tile.m_collides);
 
+		if (version >= 2u)
+		{
+			Read(file, tile.m_collisionCategory);
+			Read(file, tile.m_collisionMask);
+		}
+
 		tiles[i] = &tileWindow.GetOrAddTile(tile);
 	}
 
@@ -83,5 +89,7 @@ bool WorldImporter::ImportTilemap(std::fstream & file, C_Tilemap & tilemap)
 		Read(file, tileInstance.m_spritesheetCoordinate);
 	}
 
+	tilemap.MarkDirty(tilemap.GetBounds());
+
 	return true;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "imgui/imgui_internal.h"
 #include "dialogs/open_file_dialog.hpp"
 #include "editor/utils/path_utils.hpp"
+#include "components/tilemap/c_tilemap.hpp"
 
 TilePropertiesWindow::TilePropertiesWindow(TileWindow & tileWindow)
 	: m_tileWindow(tileWindow)
@@ -56,6 +57,14 @@ void TilePropertiesWindow::Draw()
 	ImGui::SameLine(textWidth, style.ItemInnerSpacing.x);
 	ImGui::Checkbox("", &tile->m_collides);
 
+	ImGui::TextEx("Category");
+	ImGui::SameLine(textWidth, style.ItemInnerSpacing.x);
+	ImGui::InputScalar("##category", ImGuiDataType_U32, &tile->m_collisionCategory, nullptr, nullptr, "%08X", ImGuiInputTextFlags_CharsHexadecimal);
+
+	ImGui::TextEx("Mask");
+	ImGui::SameLine(textWidth, style.ItemInnerSpacing.x);
+	ImGui::InputScalar("##mask", ImGuiDataType_U32, &tile->m_collisionMask, nullptr, nullptr, "%08X", ImGuiInputTextFlags_CharsHexadecimal);
+
 	ImGui::End();
 }
 
@@ -74,4 +83,7 @@ void TilePropertiesWindow::UserSetTileTexture(EditorTile & tile)
 
 	alvere::Asset<alvere::Texture> texture = alvere::AssetManager::getStatic<alvere::Texture>(std::string(path.begin(), path.end()));
 	tile.m_tile.m_spritesheet = { texture, { 24, 24 } };
+
+	//Any tilemap using this tile has to be rebuilt with the new texture
+	C_Tilemap::MarkTileAppearanceChanged();
 }
\ No newline at end of file
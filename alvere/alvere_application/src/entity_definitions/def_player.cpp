@@ -1,6 +1,7 @@
 
 #include <alvere/utils/assets.hpp>
 #include <alvere\world\component\components\c_transform.hpp>
+#include <alvere/world/component/components/c_previous_transform.hpp>
 #include <alvere\world\component\components\c_sprite.hpp>
 
 #include "entity_definitions/def_player.hpp"
@@ -23,6 +24,7 @@ EntityHandle Def_Player::SpawnInstance(World & world)
 	EntityHandle player = world.SpawnEntity<
 		C_Player,
 		C_Transform,
+		C_PreviousTransform,
 		C_Direction,
 		C_Velocity,
 		C_Friction,
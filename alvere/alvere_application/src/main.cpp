@@ -3,6 +3,8 @@
 #include "states/game_state_machine.hpp"
 #include "states/gameplay_state.hpp"
 #include "states/editor_state.hpp"
+#include "debug/benchmarks.hpp"
+#include "debug/tools.hpp"
 
 using namespace alvere;
 
@@ -15,6 +17,8 @@ struct AlvereApplication : public Application
 		, m_stateMachine(*new GameplayState(*m_window))
 		//, m_stateMachine(*new EditorState(*m_window))
 	{
+		RegisterBenchmarkCommands();
+		RegisterToolCommands();
 	}
 
 	void update(float deltaTime) override
@@ -24,7 +28,7 @@ struct AlvereApplication : public Application
 
 	void render() override
 	{
-		m_stateMachine.Render();
+		m_stateMachine.Render(m_tickInterpolation);
 	}
 };
 
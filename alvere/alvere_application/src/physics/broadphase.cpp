@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <cmath>
+
+#include "physics/broadphase.hpp"
+
+Broadphase::Broadphase(float cellSize)
+	: m_CellSize(cellSize)
+	, m_Frame(0)
+{
+}
+
+void Broadphase::BeginUpdate()
+{
+	++m_Frame;
+}
+
+void Broadphase::UpdateProxy(const alvere::EntityHandle & entity, const alvere::Rect & bounds, std::uint32_t category, std::uint32_t mask)
+{
+	alvere::RectI cells = GetCellRange(bounds);
+
+	auto lookup = m_ProxyLookup.find(entity);
+	if (lookup == m_ProxyLookup.end())
+	{
+		std::size_t proxyIndex;
+		if (m_FreeProxies.empty())
+		{
+			proxyIndex = m_Proxies.size();
+			m_Proxies.emplace_back();
+		}
+		else
+		{
+			proxyIndex = m_FreeProxies.back();
+			m_FreeProxies.pop_back();
+		}
+
+		m_Proxies[proxyIndex] = Proxy{ entity, bounds, cells, category, mask, m_Frame, true };
+		m_ProxyLookup.emplace(entity, proxyIndex);
+
+		InsertIntoCells(proxyIndex, cells);
+		return;
+	}
+
+	Proxy & proxy = m_Proxies[lookup->second];
+	proxy.m_Bounds = bounds;
+	proxy.m_Category = category;
+	proxy.m_Mask = mask;
+	proxy.m_LastUpdated = m_Frame;
+
+	//Most entities stay within the same cells from one tick to the next, in which case the grid is left untouched
+	if (proxy.m_Cells.m_x == cells.m_x && proxy.m_Cells.m_y == cells.m_y
+	 && proxy.m_Cells.m_width == cells.m_width && proxy.m_Cells.m_height == cells.m_height)
+	{
+		return;
+	}
+
+	RemoveFromCells(lookup->second, proxy.m_Cells);
+	InsertIntoCells(lookup->second, cells);
+	proxy.m_Cells = cells;
+}
+
+void Broadphase::EndUpdate()
+{
+	for (std::size_t i = 0; i < m_Proxies.size(); ++i)
+	{
+		if (m_Proxies[i].m_Active && m_Proxies[i].m_LastUpdated != m_Frame)
+		{
+			RemoveProxyAt(i);
+		}
+	}
+}
+
+void Broadphase::RemoveProxy(const alvere::EntityHandle & entity)
+{
+	auto lookup = m_ProxyLookup.find(entity);
+	if (lookup != m_ProxyLookup.end())
+	{
+		RemoveProxyAt(lookup->second);
+	}
+}
+
+void Broadphase::FindPairs(std::vector<BroadphasePair> & pairs) const
+{
+	for (const auto & cell : m_Cells)
+	{
+		const std::vector<std::size_t> & occupants = cell.second;
+
+		for (std::size_t i = 0; i < occupants.size(); ++i)
+		{
+			const Proxy & a = m_Proxies[occupants[i]];
+
+			for (std::size_t j = i + 1; j < occupants.size(); ++j)
+			{
+				const Proxy & b = m_Proxies[occupants[j]];
+
+				if (CollisionFiltersMatch(a.m_Category, a.m_Mask, b.m_Category, b.m_Mask) == false)
+				{
+					continue;
+				}
+
+				//Two proxies can share many cells, so the pair is only reported from the lowest cell they both cover
+				int ownerX = std::max(a.m_Cells.m_x, b.m_Cells.m_x);
+				int ownerY = std::max(a.m_Cells.m_y, b.m_Cells.m_y);
+				if (CellKey(ownerX, ownerY) != cell.first)
+				{
+					continue;
+				}
+
+				if (Overlaps(a.m_Bounds, b.m_Bounds))
+				{
+					pairs.push_back({ a.m_Entity, b.m_Entity });
+				}
+			}
+		}
+	}
+}
+
+void Broadphase::Query(const alvere::Rect & area, std::vector<alvere::EntityHandle> & results) const
+{
+	alvere::RectI cells = GetCellRange(area);
+
+	for (int y = cells.getBottom(); y < cells.getTop(); ++y)
+	{
+		for (int x = cells.getLeft(); x < cells.getRight(); ++x)
+		{
+			auto cell = m_Cells.find(CellKey(x, y));
+			if (cell == m_Cells.end())
+			{
+				continue;
+			}
+
+			for (std::size_t proxyIndex : cell->second)
+			{
+				const Proxy & proxy = m_Proxies[proxyIndex];
+
+				//Same rule as FindPairs, only report from the first cell the proxy and the area share
+				if (CellKey(std::max(proxy.m_Cells.m_x, cells.m_x), std::max(proxy.m_Cells.m_y, cells.m_y)) != cell->first)
+				{
+					continue;
+				}
+
+				if (Overlaps(proxy.m_Bounds, area))
+				{
+					results.push_back(proxy.m_Entity);
+				}
+			}
+		}
+	}
+}
+
+alvere::RectI Broadphase::GetCellRange(const alvere::Rect & bounds) const
+{
+	int left = (int) std::floor(bounds.getLeft() / m_CellSize);
+	int bottom = (int) std::floor(bounds.getBottom() / m_CellSize);
+	int right = (int) std::floor(bounds.getRight() / m_CellSize);
+	int top = (int) std::floor(bounds.getTop() / m_CellSize);
+
+	return alvere::RectI(left, bottom, right - left + 1, top - bottom + 1);
+}
+
+void Broadphase::InsertIntoCells(std::size_t proxyIndex, const alvere::RectI & cells)
+{
+	for (int y = cells.getBottom(); y < cells.getTop(); ++y)
+	{
+		for (int x = cells.getLeft(); x < cells.getRight(); ++x)
+		{
+			m_Cells[CellKey(x, y)].push_back(proxyIndex);
+		}
+	}
+}
+
+void Broadphase::RemoveFromCells(std::size_t proxyIndex, const alvere::RectI & cells)
+{
+	for (int y = cells.getBottom(); y < cells.getTop(); ++y)
+	{
+		for (int x = cells.getLeft(); x < cells.getRight(); ++x)
+		{
+			auto cell = m_Cells.find(CellKey(x, y));
+			if (cell == m_Cells.end())
+			{
+				continue;
+			}
+
+			std::vector<std::size_t> & occupants = cell->second;
+			auto occupant = std::find(occupants.begin(), occupants.end(), proxyIndex);
+			if (occupant != occupants.end())
+			{
+				*occupant = occupants.back();
+				occupants.pop_back();
+			}
+
+			if (occupants.empty())
+			{
+				m_Cells.erase(cell);
+			}
+		}
+	}
+}
+
+void Broadphase::RemoveProxyAt(std::size_t proxyIndex)
+{
+	Proxy & proxy = m_Proxies[proxyIndex];
+
+	RemoveFromCells(proxyIndex, proxy.m_Cells);
+	m_ProxyLookup.erase(proxy.m_Entity);
+
+	proxy.m_Active = false;
+	proxy.m_Entity.reset();
+	m_FreeProxies.push_back(proxyIndex);
+}
+
+std::int64_t Broadphase::CellKey(int x, int y)
+{
+	return ((std::int64_t) x << 32) | (std::uint32_t) y;
+}
+
+bool Broadphase::Overlaps(const alvere::Rect & a, const alvere::Rect & b)
+{
+	return a.getLeft() < b.getRight() && b.getLeft() < a.getRight()
+		&& a.getBottom() < b.getTop() && b.getBottom() < a.getTop();
+}
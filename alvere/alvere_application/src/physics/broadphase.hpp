@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <alvere/utils/shapes.hpp>
+#include <alvere/world/entity/entity_handle.hpp>
+
+#include "physics/collision_layers.hpp"
+
+struct BroadphasePair
+{
+	alvere::EntityHandle m_A;
+	alvere::EntityHandle m_B;
+};
+
+//Uniform grid over entity bounds. Proxies are only moved between cells when the range of cells
+//they cover changes, so entities moving within their cells cost a single comparison per update.
+class Broadphase
+{
+	struct Proxy
+	{
+		alvere::EntityHandle m_Entity;
+		alvere::Rect m_Bounds;
+		alvere::RectI m_Cells;
+		std::uint32_t m_Category;
+		std::uint32_t m_Mask;
+		unsigned int m_LastUpdated;
+		bool m_Active;
+	};
+
+	float m_CellSize;
+	unsigned int m_Frame;
+
+	std::vector<Proxy> m_Proxies;
+	std::vector<std::size_t> m_FreeProxies;
+	std::unordered_map<alvere::EntityHandle, std::size_t, alvere::EntityHandle::Hash> m_ProxyLookup;
+
+	std::unordered_map<std::int64_t, std::vector<std::size_t>> m_Cells;
+
+public:
+
+	Broadphase(float cellSize = 4.0f);
+
+	//Proxies that are not updated between BeginUpdate() and EndUpdate() are removed by EndUpdate()
+	void BeginUpdate();
+	void UpdateProxy(const alvere::EntityHandle & entity, const alvere::Rect & bounds, std::uint32_t category = CollisionLayer_All, std::uint32_t mask = CollisionLayer_All);
+	void EndUpdate();
+
+	void RemoveProxy(const alvere::EntityHandle & entity);
+
+	//Pairs are only reported when both bounds overlap and each proxy's mask accepts the other's category
+	void FindPairs(std::vector<BroadphasePair> & pairs) const;
+
+	//Appends every entity whose bounds overlap the area. Entities are reported once.
+	void Query(const alvere::Rect & area, std::vector<alvere::EntityHandle> & results) const;
+
+	std::size_t GetProxyCount() const { return m_ProxyLookup.size(); }
+	std::size_t GetCellCount() const { return m_Cells.size(); }
+
+private:
+
+	alvere::RectI GetCellRange(const alvere::Rect & bounds) const;
+
+	void InsertIntoCells(std::size_t proxyIndex, const alvere::RectI & cells);
+	void RemoveFromCells(std::size_t proxyIndex, const alvere::RectI & cells);
+	void RemoveProxyAt(std::size_t proxyIndex);
+
+	static std::int64_t CellKey(int x, int y);
+	static bool Overlaps(const alvere::Rect & a, const alvere::Rect & b);
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+//Bits used for the category and mask of tiles and collider instances.
+//A category says which layers something is on, a mask says which layers it collides with.
+enum CollisionLayers : std::uint32_t
+{
+	CollisionLayer_None = 0u,
+	CollisionLayer_Default = 1u << 0,
+	CollisionLayer_All = ~0u,
+};
+
+//Two things only collide when each one's category is in the other's mask
+inline bool CollisionFiltersMatch(std::uint32_t categoryA, std::uint32_t maskA, std::uint32_t categoryB, std::uint32_t maskB)
+{
+	return (categoryA & maskB) != 0 && (categoryB & maskA) != 0;
+}
@@ -0,0 +1,198 @@
+#include <cmath>
+
+#include "physics/integration.hpp"
+
+#ifdef ALV_PHYSICS_INTEGRATION_SSE
+#include <emmintrin.h>
+#endif
+
+void IntegrationBodies::Clear()
+{
+	m_VelocityX.clear();
+	m_VelocityY.clear();
+	m_MoveDirection.clear();
+	m_JumpTimeRemaining.clear();
+	m_Flags.clear();
+}
+
+void IntegrationBodies::Resize(std::size_t count)
+{
+	m_VelocityX.resize(count);
+	m_VelocityY.resize(count);
+	m_MoveDirection.resize(count);
+	m_JumpTimeRemaining.resize(count);
+	m_Flags.resize(count);
+}
+
+void IntegrateBodies(IntegrationBodies & bodies, const IntegrationParameters & parameters, float deltaTime)
+{
+#ifdef ALV_PHYSICS_INTEGRATION_SSE
+	IntegrateBodiesSSE(bodies, parameters, deltaTime);
+#else
+	IntegrateBodiesScalar(bodies, parameters, deltaTime);
+#endif
+}
+
+//Every operation below has to stay in the same order as the original systems, otherwise the rounding changes
+void IntegrateBodiesScalar(IntegrationBodies & bodies, const IntegrationParameters & parameters, float deltaTime, std::size_t first)
+{
+	float gravityX = parameters.m_Gravity.x * deltaTime;
+	float gravityY = parameters.m_Gravity.y * deltaTime;
+	float frictionX = parameters.m_Friction.x * deltaTime;
+	float frictionY = parameters.m_Friction.y * deltaTime;
+
+	for (std::size_t i = first; i < bodies.GetCount(); ++i)
+	{
+		std::uint32_t flags = bodies.m_Flags[i];
+		float velocityX = bodies.m_VelocityX[i];
+		float velocityY = bodies.m_VelocityY[i];
+
+		//S_Movement
+		if (flags & IntegrationFlag_Movement)
+		{
+			float speed = bodies.m_MoveDirection[i] * parameters.m_HorizontalSpeed;
+
+			if ((speed > 0.0f && velocityX < speed)
+			 || (speed < 0.0f && velocityX > speed))
+			{
+				velocityX += speed * parameters.m_Acceleration * deltaTime;
+			}
+		}
+
+		//S_Jump
+		if (flags & IntegrationFlag_Jump)
+		{
+			float & remaining = bodies.m_JumpTimeRemaining[i];
+
+			if ((flags & IntegrationFlag_JumpHeld) == 0)
+			{
+				remaining = -1.0f;
+			}
+			else
+			{
+				if (flags & IntegrationFlag_OnGround)
+				{
+					remaining = parameters.m_JumpDuration;
+				}
+
+				if (remaining > 0.0f)
+				{
+					remaining -= deltaTime;
+					velocityY = parameters.m_JumpStrength;
+				}
+			}
+		}
+
+		//S_Gravity
+		if (flags & IntegrationFlag_Gravity)
+		{
+			velocityX += gravityX;
+			velocityY += gravityY;
+		}
+
+		//S_Friction
+		if (flags & IntegrationFlag_Friction)
+		{
+			if (std::abs(velocityX) < frictionX) velocityX = 0.0f;
+			else if (velocityX < 0.0f) velocityX += frictionX;
+			else velocityX -= frictionX;
+
+			if (std::abs(velocityY) < frictionY) velocityY = 0.0f;
+			else if (velocityY < 0.0f) velocityY += frictionY;
+			else velocityY -= frictionY;
+		}
+
+		bodies.m_VelocityX[i] = velocityX;
+		bodies.m_VelocityY[i] = velocityY;
+	}
+}
+
+#ifdef ALV_PHYSICS_INTEGRATION_SSE
+
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128 FlagMask(__m128i flags, std::uint32_t flag)
+{
+	__m128i bit = _mm_set1_epi32((int) flag);
+	return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(flags, bit), bit));
+}
+
+static inline __m128 ApplyFriction(__m128 velocity, __m128 friction, __m128 enabled)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+	__m128 stopped = _mm_cmplt_ps(_mm_and_ps(velocity, absMask), friction);
+	__m128 negative = _mm_cmplt_ps(velocity, zero);
+
+	__m128 slowed = Select(negative, _mm_add_ps(velocity, friction), _mm_sub_ps(velocity, friction));
+	__m128 result = Select(stopped, zero, slowed);
+
+	return Select(enabled, result, velocity);
+}
+
+//No FMA here on purpose, a fused multiply-add rounds once instead of twice and would no longer match the scalar path
+void IntegrateBodiesSSE(IntegrationBodies & bodies, const IntegrationParameters & parameters, float deltaTime)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	const __m128 horizontalSpeed = _mm_set1_ps(parameters.m_HorizontalSpeed);
+	const __m128 acceleration = _mm_set1_ps(parameters.m_Acceleration);
+	const __m128 jumpStrength = _mm_set1_ps(parameters.m_JumpStrength);
+	const __m128 jumpDuration = _mm_set1_ps(parameters.m_JumpDuration);
+	const __m128 noJump = _mm_set1_ps(-1.0f);
+	const __m128 gravityX = _mm_set1_ps(parameters.m_Gravity.x * deltaTime);
+	const __m128 gravityY = _mm_set1_ps(parameters.m_Gravity.y * deltaTime);
+	const __m128 frictionX = _mm_set1_ps(parameters.m_Friction.x * deltaTime);
+	const __m128 frictionY = _mm_set1_ps(parameters.m_Friction.y * deltaTime);
+
+	std::size_t count = bodies.GetCount();
+	std::size_t vectorCount = count - count % 4;
+
+	for (std::size_t i = 0; i < vectorCount; i += 4)
+	{
+		__m128i flags = _mm_loadu_si128((const __m128i *) &bodies.m_Flags[i]);
+		__m128 velocityX = _mm_loadu_ps(&bodies.m_VelocityX[i]);
+		__m128 velocityY = _mm_loadu_ps(&bodies.m_VelocityY[i]);
+
+		//S_Movement
+		__m128 speed = _mm_mul_ps(_mm_loadu_ps(&bodies.m_MoveDirection[i]), horizontalSpeed);
+		__m128 accelerate = _mm_or_ps(_mm_and_ps(_mm_cmpgt_ps(speed, zero), _mm_cmplt_ps(velocityX, speed)),
+									  _mm_and_ps(_mm_cmplt_ps(speed, zero), _mm_cmpgt_ps(velocityX, speed)));
+		accelerate = _mm_and_ps(accelerate, FlagMask(flags, IntegrationFlag_Movement));
+		velocityX = Select(accelerate, _mm_add_ps(velocityX, _mm_mul_ps(_mm_mul_ps(speed, acceleration), dt)), velocityX);
+
+		//S_Jump
+		__m128 hasJump = FlagMask(flags, IntegrationFlag_Jump);
+		__m128 held = FlagMask(flags, IntegrationFlag_JumpHeld);
+		__m128 previousRemaining = _mm_loadu_ps(&bodies.m_JumpTimeRemaining[i]);
+
+		__m128 remaining = Select(_mm_and_ps(held, FlagMask(flags, IntegrationFlag_OnGround)), jumpDuration, previousRemaining);
+		__m128 jumping = _mm_and_ps(_mm_and_ps(hasJump, held), _mm_cmpgt_ps(remaining, zero));
+		remaining = Select(jumping, _mm_sub_ps(remaining, dt), remaining);
+		remaining = Select(held, remaining, noJump);
+		velocityY = Select(jumping, jumpStrength, velocityY);
+
+		_mm_storeu_ps(&bodies.m_JumpTimeRemaining[i], Select(hasJump, remaining, previousRemaining));
+
+		//S_Gravity
+		__m128 gravity = FlagMask(flags, IntegrationFlag_Gravity);
+		velocityX = Select(gravity, _mm_add_ps(velocityX, gravityX), velocityX);
+		velocityY = Select(gravity, _mm_add_ps(velocityY, gravityY), velocityY);
+
+		//S_Friction
+		__m128 friction = FlagMask(flags, IntegrationFlag_Friction);
+		velocityX = ApplyFriction(velocityX, frictionX, friction);
+		velocityY = ApplyFriction(velocityY, frictionY, friction);
+
+		_mm_storeu_ps(&bodies.m_VelocityX[i], velocityX);
+		_mm_storeu_ps(&bodies.m_VelocityY[i], velocityY);
+	}
+
+	IntegrateBodiesScalar(bodies, parameters, deltaTime, vectorCount);
+}
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <alvere/math/vectors.hpp>
+
+//SSE2 is always available on x64, and on x86 when MSVC is targeting it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define ALV_PHYSICS_INTEGRATION_SSE
+#endif
+
+enum IntegrationFlags : std::uint32_t
+{
+	IntegrationFlag_Movement = 1 << 0,
+	IntegrationFlag_Jump = 1 << 1,
+	IntegrationFlag_JumpHeld = 1 << 2,
+	IntegrationFlag_OnGround = 1 << 3,
+	IntegrationFlag_Gravity = 1 << 4,
+	IntegrationFlag_Friction = 1 << 5,
+};
+
+struct IntegrationParameters
+{
+	float m_HorizontalSpeed;
+	float m_Acceleration;
+	float m_JumpStrength;
+	float m_JumpDuration;
+	alvere::Vector2 m_Gravity;
+	alvere::Vector2 m_Friction;
+};
+
+//Structure of arrays for every body taking part in integration. Every array is always the same length.
+//Positions are left out on purpose, they live in C_Transform alongside two matrices, so copying them out
+//and back in costs more than adding the velocity on while the transform is being written to anyway.
+struct IntegrationBodies
+{
+	std::vector<float> m_VelocityX;
+	std::vector<float> m_VelocityY;
+
+	//-1, 0 or 1 depending on which way the body is being moved
+	std::vector<float> m_MoveDirection;
+	std::vector<float> m_JumpTimeRemaining;
+	std::vector<std::uint32_t> m_Flags;
+
+	void Clear();
+	void Resize(std::size_t count);
+	std::size_t GetCount() const { return m_Flags.size(); }
+};
+
+//Applies movement, jump, gravity and friction to every body's velocity in one pass. The result is bit for bit
+//the same as S_Movement, S_Jump, S_Gravity and S_Friction run one after the other.
+void IntegrateBodies(IntegrationBodies & bodies, const IntegrationParameters & parameters, float deltaTime);
+
+void IntegrateBodiesScalar(IntegrationBodies & bodies, const IntegrationParameters & parameters, float deltaTime, std::size_t first = 0);
+
+#ifdef ALV_PHYSICS_INTEGRATION_SSE
+void IntegrateBodiesSSE(IntegrationBodies & bodies, const IntegrationParameters & parameters, float deltaTime);
+#endif
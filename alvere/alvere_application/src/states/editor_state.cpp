@@ -21,7 +21,7 @@ GameState * EditorState::Update(float deltaTime)
 	return nullptr;
 }
 
-void EditorState::Render()
+void EditorState::Render(float tickInterpolation)
 {
 	m_editor.Render();
 }
\ No newline at end of file
@@ -23,5 +23,5 @@ public:
 	EditorState(alvere::Window & window);
 
 	GameState * Update(float deltaTime) override;
-	void Render() override;
+	void Render(float tickInterpolation) override;
 };
\ No newline at end of file
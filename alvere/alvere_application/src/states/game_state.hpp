@@ -7,5 +7,5 @@ public:
 	virtual ~GameState() = default;
 
 	virtual GameState * Update(float deltaTime) = 0;
-	virtual void Render() = 0;
+	virtual void Render(float tickInterpolation) = 0;
 };
\ No newline at end of file
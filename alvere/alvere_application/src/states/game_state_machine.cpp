@@ -19,7 +19,7 @@ void GameStateMachine::Update(float deltaTime)
 	m_currentState = nextState;
 }
 
-void GameStateMachine::Render()
+void GameStateMachine::Render(float tickInterpolation)
 {
-	m_currentState->Render();
+	m_currentState->Render(tickInterpolation);
 }
\ No newline at end of file
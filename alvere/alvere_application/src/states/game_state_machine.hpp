@@ -11,5 +11,5 @@ public:
 	GameStateMachine(GameState & initialState);
 
 	void Update(float deltaTime);
-	void Render();
+	void Render(float tickInterpolation);
 };
\ No newline at end of file
@@ -13,6 +13,7 @@
 
 #include <alvere/world/component/components/c_camera.hpp>
 #include <alvere/world/component/components/c_transform.hpp>
+#include <alvere/world/component/components/c_previous_transform.hpp>
 
 #include "gameplay_state.hpp"
 #include "states/editor_state.hpp"
@@ -24,9 +25,10 @@
 
 #include "systems/tilemap/s_tilemap_renderer.hpp"
 #include "systems/physics/s_tilemap_collision_resolution.hpp"
-#include "systems/physics/s_gravity.hpp"
-#include "systems/physics/s_velocity.hpp"
-#include "systems/physics/s_friction.hpp"
+#include "systems/physics/s_entity_collision.hpp"
+#include "systems/physics/s_physics_pipeline.hpp"
+#include "systems/physics/s_physics_integration.hpp"
+#include "systems/physics/s_sleep.hpp"
 #include "systems/input/s_player_input.hpp"
 #include "systems/rendering/s_spritesheet.hpp"
 #include "systems/rendering/s_collider_renderer.hpp"
@@ -34,20 +36,17 @@
 #include "systems/s_mirror_sprite_direction.hpp"
 #include "systems/s_direction_from_movement.hpp"
 #include "systems/s_entity_follower.hpp"
-#include "systems/s_movement.hpp"
-#include "systems/s_jump.hpp"
 
 GameplayState::GameplayState(alvere::Window & window)
 	: m_window(window), m_toggleEditor(window, alvere::Key::I), m_halfWorldUnitsOnX(32 * 0.5f)
 {
 	alvere::RunTests();
 
-	alvere::EntityHandle cameraEntity;
 	{ //Camera instance
 		float screenRatio = window.getRenderingContext().getAspectRatio();
 
-		cameraEntity = Def_Camera().SpawnInstance(m_world);
-		m_sceneCamera = &m_world.GetComponent<alvere::C_Camera>(cameraEntity);
+		m_cameraEntity = Def_Camera().SpawnInstance(m_world);
+		m_sceneCamera = &m_world.GetComponent<alvere::C_Camera>(m_cameraEntity);
 		m_sceneCamera->setOrthographic(-m_halfWorldUnitsOnX, m_halfWorldUnitsOnX, m_halfWorldUnitsOnX * screenRatio, -m_halfWorldUnitsOnX * screenRatio, -1.0f, 1.0f);
 		m_uiCamera.setOrthographic(0, 800, 800, 0, -1.0f, 1.0f);
 	}
@@ -56,13 +55,17 @@ GameplayState::GameplayState(alvere::Window & window)
 
 	m_world.AddSystem<alvere::S_Destroy>();
 	m_world.AddSystem<S_PlayerInput>(m_window);
-	m_world.AddSystem<S_Movement>(15.0f, 10.0f);
 	m_world.AddSystem<S_DirectionFromMovement>();
-	m_world.AddSystem<S_Jump>(20.0f, 0.2f);
-	m_world.AddSystem<S_Gravity>(alvere::Vector2(0.0f, -70.0f));
-	m_world.AddSystem<S_Friction>(alvere::Vector2(100.0f, 0.0f));
-	m_world.AddSystem<S_Velocity>();
-	m_world.AddSystem<S_TilemapCollisionResolution>(m_world);
+
+	//Runs before physics so anything woken this tick is simulated straight away
+	m_world.AddSystem<S_Sleep>();
+
+	//Physics runs at its own fixed rate and in a fixed order, so it lives in the pipeline rather than the world
+	m_physics = m_world.AddSystem<S_PhysicsPipeline>(60.0f);
+	m_physics->AddSystem<S_PhysicsIntegration>(IntegrationParameters{ 15.0f, 10.0f, 20.0f, 0.2f, { 0.0f, -70.0f }, { 100.0f, 0.0f } });
+	m_physics->AddSystem<S_TilemapCollisionResolution>(m_world, &m_threadPool);
+	m_physics->AddSystem<S_EntityCollision>();
+
 	m_world.AddSystem<S_EntityFollower>(m_world);
 	m_world.AddSystem<alvere::S_Camera>();
 
@@ -70,7 +73,7 @@ GameplayState::GameplayState(alvere::Window & window)
 	m_world.AddSystem<S_Animation>();
 	m_world.AddSystem<S_Spritesheet>();
 	m_world.AddSystem<S_TilemapRenderer>(*m_sceneCamera);
-	m_world.AddSystem<alvere::S_SpriteRenderer>(*m_sceneCamera);
+	m_spriteRenderer = m_world.AddSystem<alvere::S_SpriteRenderer>(*m_sceneCamera);
 	//m_world.AddSystem<S_ColliderRenderer>(*m_sceneCamera, alvere::Sprite(*alvere::AssetManager::getStatic<alvere::Texture>("res/img/misc/collider.png")));
 
 	PlatformerScene platformerScene(m_world);
@@ -88,7 +91,7 @@ GameplayState::GameplayState(alvere::Window & window)
 			const std::unordered_set<alvere::EntityHandle, alvere::EntityHandle::Hash> entities = archetypes[0].get().GetEntities();
 			for (alvere::EntityHandle entity : entities)
 			{
-				C_EntityFollower & cameraFollower = m_world.GetComponent<C_EntityFollower>(cameraEntity);
+				C_EntityFollower & cameraFollower = m_world.GetComponent<C_EntityFollower>(m_cameraEntity);
 				cameraFollower.m_FollowTarget = entity;
 				break;
 			}
@@ -154,7 +157,24 @@ GameState * GameplayState::Update(float deltaTime)
 	return nullptr;
 }
 
-void GameplayState::Render()
+void GameplayState::Render(float tickInterpolation)
 {
+	float interpolation = m_physics->GetInterpolation(tickInterpolation);
+	m_spriteRenderer->SetInterpolation(interpolation);
+
+	//The camera has to follow the interpolated pose of its target too, otherwise the target jitters on screen
+	const C_EntityFollower & cameraFollower = m_world.GetComponent<C_EntityFollower>(m_cameraEntity);
+	if (cameraFollower.m_FollowTarget.isValid())
+	{
+		const alvere::EntityHandle & target = cameraFollower.m_FollowTarget;
+		const alvere::C_PreviousTransform * targetPrevious = target->m_Archetype->TryGetComponent<alvere::C_PreviousTransform>(target);
+
+		if (targetPrevious != nullptr)
+		{
+			const alvere::C_Transform & targetTransform = m_world.GetComponent<alvere::C_Transform>(target);
+			m_sceneCamera->setPosition(targetPrevious->interpolatePosition(targetTransform.m_transform, interpolation));
+		}
+	}
+
 	m_world.Render();
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <alvere\world\world.hpp>
 #include <alvere\graphics\camera.hpp>
 #include <alvere\input\key_button.hpp>
+#include <alvere/utils/thread_pool.hpp>
 
 #include "game_state.hpp"
 
@@ -13,17 +14,31 @@ namespace alvere
 	class Window;
 }
 
+namespace alvere
+{
+	class S_SpriteRenderer;
+}
+
+class S_PhysicsPipeline;
+
 class GameplayState : public GameState
 {
 	alvere::Window & m_window;
 
 	alvere::Scene m_scene;
 
+	//Declared before the world so it outlives the systems that use it
+	alvere::ThreadPool m_threadPool;
+
 	alvere::World m_world;
+	alvere::EntityHandle m_cameraEntity;
 	alvere::Camera * m_sceneCamera;
 	alvere::Camera m_uiCamera;
 	float m_halfWorldUnitsOnX;
 
+	S_PhysicsPipeline * m_physics;
+	alvere::S_SpriteRenderer * m_spriteRenderer;
+
 	alvere::input::KeyButton m_toggleEditor;
 
 	alvere::WindowResizeEvent::Handler m_windowResizeEventHandler;
@@ -36,5 +51,5 @@ public:
 
 	GameState * Update(float deltaTime) override;
 
-	void Render() override;
+	void Render(float tickInterpolation) override;
 };
\ No newline at end of file
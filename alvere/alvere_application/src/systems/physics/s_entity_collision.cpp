@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cmath>
+
+#include <alvere/world/archetype/archetype.hpp>
+#include <alvere/world/component/components/c_transform.hpp>
+
+#include "s_entity_collision.hpp"
+#include "components/physics/c_collider.hpp"
+#include "components/physics/c_sleeping.hpp"
+
+S_EntityCollision::S_EntityCollision(float cellSize)
+	: m_Query(alvere::Archetype::Query().Include<alvere::C_Transform, C_Collider>().Exclude<C_Sleeping>())
+	, m_Broadphase(cellSize)
+{
+}
+
+void S_EntityCollision::Update(alvere::World & world, float deltaTime)
+{
+	GatherBodies(world);
+
+	m_Pairs.clear();
+	m_Broadphase.FindPairs(m_Pairs);
+
+	FindContacts();
+}
+
+void S_EntityCollision::GatherBodies(alvere::World & world)
+{
+	m_Bodies.clear();
+	m_WorldColliders.clear();
+	m_BodyLookup.clear();
+
+	world.QueryArchetypes(m_Query, m_Archetypes);
+
+	m_Broadphase.BeginUpdate();
+
+	for (alvere::Archetype & archetype : m_Archetypes)
+	{
+		for (const alvere::EntityHandle & entity : archetype.GetEntities())
+		{
+			const alvere::C_Transform & transform = archetype.GetComponent<alvere::C_Transform>(entity);
+			const C_Collider & collider = archetype.GetComponent<C_Collider>(entity);
+
+			if (collider.m_ColliderInstances.empty())
+			{
+				continue;
+			}
+
+			alvere::Vector2 position = transform->getPosition();
+
+			//The broadphase only needs the bounds around all of an entity's colliders
+			alvere::Vector2 lower = position + collider.m_ColliderInstances[0].m_LocalBounds.getBottomLeft();
+			alvere::Vector2 upper = position + collider.m_ColliderInstances[0].m_LocalBounds.getTopRight();
+
+			//The broadphase filters on everything the entity's instances are on and collide with, the narrowphase checks each instance
+			std::uint32_t category = CollisionLayer_None;
+			std::uint32_t mask = CollisionLayer_None;
+
+			Body body{ entity, m_WorldColliders.size(), collider.m_ColliderInstances.size() };
+
+			for (const ColliderInstance & instance : collider.m_ColliderInstances)
+			{
+				alvere::Rect worldBounds(position + instance.m_LocalBounds.getBottomLeft(), alvere::Vector2(instance.m_LocalBounds.m_width, instance.m_LocalBounds.m_height));
+				m_WorldColliders.push_back({ worldBounds, instance.m_Category, instance.m_Mask });
+
+				category |= instance.m_Category;
+				mask |= instance.m_Mask;
+
+				lower = alvere::Vector2(std::min(lower.x, worldBounds.getLeft()), std::min(lower.y, worldBounds.getBottom()));
+				upper = alvere::Vector2(std::max(upper.x, worldBounds.getRight()), std::max(upper.y, worldBounds.getTop()));
+			}
+
+			m_BodyLookup.emplace(entity, m_Bodies.size());
+			m_Bodies.emplace_back(body);
+
+			m_Broadphase.UpdateProxy(entity, alvere::Rect(lower, upper - lower), category, mask);
+		}
+	}
+
+	m_Broadphase.EndUpdate();
+}
+
+void S_EntityCollision::FindContacts()
+{
+	m_Contacts.clear();
+
+	for (const BroadphasePair & pair : m_Pairs)
+	{
+		const Body & a = m_Bodies[m_BodyLookup.at(pair.m_A)];
+		const Body & b = m_Bodies[m_BodyLookup.at(pair.m_B)];
+
+		//Keep the deepest overlap between any of the two entities' collider instances
+		bool touching = false;
+		alvere::Vector2 deepest(0.0f, 0.0f);
+
+		for (std::size_t i = 0; i < a.m_ColliderCount; ++i)
+		{
+			for (std::size_t j = 0; j < b.m_ColliderCount; ++j)
+			{
+				const WorldCollider & colliderA = m_WorldColliders[a.m_FirstCollider + i];
+				const WorldCollider & colliderB = m_WorldColliders[b.m_FirstCollider + j];
+
+				if (CollisionFiltersMatch(colliderA.m_Category, colliderA.m_Mask, colliderB.m_Category, colliderB.m_Mask) == false)
+				{
+					continue;
+				}
+
+				alvere::Vector2 penetration;
+				if (CalculatePenetration(colliderA.m_Bounds, colliderB.m_Bounds, penetration) == false)
+				{
+					continue;
+				}
+
+				if (touching == false || penetration.magnitudeSq() > deepest.magnitudeSq())
+				{
+					deepest = penetration;
+					touching = true;
+				}
+			}
+		}
+
+		if (touching)
+		{
+			m_Contacts.push_back({ a.m_Entity, b.m_Entity, deepest });
+		}
+	}
+}
+
+bool S_EntityCollision::CalculatePenetration(const alvere::Rect & a, const alvere::Rect & b, alvere::Vector2 & penetration)
+{
+	alvere::Vector2 aHalfSize(a.m_width / 2.0f, a.m_height / 2.0f);
+	alvere::Vector2 bHalfSize(b.m_width / 2.0f, b.m_height / 2.0f);
+
+	alvere::Vector2 dist = (a.getBottomLeft() + aHalfSize) - (b.getBottomLeft() + bHalfSize);
+	alvere::Vector2 depth = aHalfSize + bHalfSize - alvere::Vector2(std::abs(dist.x), std::abs(dist.y));
+
+	if (depth.x <= 0.0f || depth.y <= 0.0f)
+	{
+		return false;
+	}
+
+	//Same as the tilemap resolution, push out along whichever axis has the least depth
+	penetration = alvere::Vector2(0.0f, 0.0f);
+	if (depth.x < depth.y)
+	{
+		penetration.x = dist.x > 0.0f ? depth.x : -depth.x;
+	}
+	else
+	{
+		penetration.y = dist.y > 0.0f ? depth.y : -depth.y;
+	}
+
+	return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <alvere/math/vectors.hpp>
+#include <alvere/utils/shapes.hpp>
+#include <alvere/world/world.hpp>
+#include <alvere/world/system/updated_system.hpp>
+#include <alvere/world/archetype/archetype_query.hpp>
+
+#include "physics/broadphase.hpp"
+
+struct EntityContact
+{
+	alvere::EntityHandle m_A;
+	alvere::EntityHandle m_B;
+
+	//Smallest vector that would move A out of B
+	alvere::Vector2 m_Penetration;
+};
+
+//Finds overlapping entity colliders. The broadphase grid narrows the candidates down to pairs whose
+//overall bounds overlap, then the narrowphase tests their individual collider instances against each other.
+//Collider instances whose categories and masks don't match are rejected before any geometry is tested.
+//Contacts are only reported, resolving them is left to whichever system cares about them.
+class S_EntityCollision : public alvere::UpdatedSystem
+{
+	struct Body
+	{
+		alvere::EntityHandle m_Entity;
+		std::size_t m_FirstCollider;
+		std::size_t m_ColliderCount;
+	};
+
+	struct WorldCollider
+	{
+		alvere::Rect m_Bounds;
+		std::uint32_t m_Category;
+		std::uint32_t m_Mask;
+	};
+
+	alvere::Archetype::Query m_Query;
+	std::vector<std::reference_wrapper<alvere::Archetype>> m_Archetypes;
+
+	Broadphase m_Broadphase;
+
+	std::vector<Body> m_Bodies;
+	std::vector<WorldCollider> m_WorldColliders;
+	std::unordered_map<alvere::EntityHandle, std::size_t, alvere::EntityHandle::Hash> m_BodyLookup;
+
+	std::vector<BroadphasePair> m_Pairs;
+	std::vector<EntityContact> m_Contacts;
+
+public:
+
+	S_EntityCollision(float cellSize = 4.0f);
+
+	void Update(alvere::World & world, float deltaTime) override;
+
+	const std::vector<BroadphasePair> & GetPairs() const { return m_Pairs; }
+	const std::vector<EntityContact> & GetContacts() const { return m_Contacts; }
+
+	const Broadphase & GetBroadphase() const { return m_Broadphase; }
+
+private:
+
+	void GatherBodies(alvere::World & world);
+	void FindContacts();
+
+	static bool CalculatePenetration(const alvere::Rect & a, const alvere::Rect & b, alvere::Vector2 & penetration);
+};
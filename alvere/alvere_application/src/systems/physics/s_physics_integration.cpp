@@ -0,0 +1,129 @@
+#include <typeinfo>
+
+#include <alvere/world/archetype/archetype.hpp>
+#include <alvere/world/component/components/c_transform.hpp>
+
+#include "s_physics_integration.hpp"
+#include "components/physics/c_velocity.hpp"
+#include "components/physics/c_movement.hpp"
+#include "components/physics/c_gravity.hpp"
+#include "components/physics/c_friction.hpp"
+#include "components/physics/c_tilemap_collision.hpp"
+#include "components/physics/c_sleeping.hpp"
+
+S_PhysicsIntegration::S_PhysicsIntegration(const IntegrationParameters & parameters)
+	: m_Parameters(parameters)
+	, m_Query(alvere::Archetype::Query().Include<alvere::C_Transform, C_Velocity>().Exclude<C_Sleeping>())
+{
+}
+
+void S_PhysicsIntegration::Update(alvere::World & world, float deltaTime)
+{
+	Gather(world);
+
+	IntegrateBodies(m_Bodies, m_Parameters, deltaTime);
+
+	Scatter(deltaTime);
+}
+
+void S_PhysicsIntegration::Gather(alvere::World & world)
+{
+	world.QueryArchetypes(m_Query, m_Archetypes);
+
+	m_Ranges.clear();
+
+	std::size_t bodyCount = 0;
+	for (alvere::Archetype & archetype : m_Archetypes)
+	{
+		bodyCount += archetype.GetEntityCount();
+	}
+
+	m_Bodies.Resize(bodyCount);
+
+	std::size_t body = 0;
+	for (alvere::Archetype & archetype : m_Archetypes)
+	{
+		std::size_t entityCount = archetype.GetEntityCount();
+		if (entityCount == 0)
+		{
+			continue;
+		}
+
+		//Which systems apply is decided by the components present, which is the same for every entity in the archetype
+		const auto & providers = archetype.GetProviders();
+		bool hasMovement = providers.find(typeid(C_Movement)) != providers.end();
+		bool hasTilemapCollision = providers.find(typeid(C_TilemapCollision)) != providers.end();
+
+		std::uint32_t flags = 0;
+		if (hasMovement) flags |= IntegrationFlag_Movement;
+		if (hasMovement && hasTilemapCollision) flags |= IntegrationFlag_Jump;
+		if (providers.find(typeid(C_Gravity)) != providers.end()) flags |= IntegrationFlag_Gravity;
+		if (providers.find(typeid(C_Friction)) != providers.end()) flags |= IntegrationFlag_Friction;
+
+		m_Ranges.push_back({ &archetype, flags });
+
+		auto velocity = archetype.GetProvider<C_Velocity>().begin();
+
+		for (std::size_t i = body; i < body + entityCount; ++i, ++velocity)
+		{
+			m_Bodies.m_VelocityX[i] = velocity->m_Velocity.x;
+			m_Bodies.m_VelocityY[i] = velocity->m_Velocity.y;
+			m_Bodies.m_MoveDirection[i] = 0.0f;
+			m_Bodies.m_JumpTimeRemaining[i] = -1.0f;
+			m_Bodies.m_Flags[i] = flags;
+		}
+
+		if (hasMovement)
+		{
+			auto movement = archetype.GetProvider<C_Movement>().begin();
+			for (std::size_t i = body; i < body + entityCount; ++i, ++movement)
+			{
+				m_Bodies.m_MoveDirection[i] = movement->m_Horizontal < 0.0f ? -1.0f : (movement->m_Horizontal > 0.0f ? 1.0f : 0.0f);
+				m_Bodies.m_JumpTimeRemaining[i] = movement->m_JumpTimeRemaining;
+				m_Bodies.m_Flags[i] |= movement->m_Jump ? IntegrationFlag_JumpHeld : 0;
+			}
+		}
+
+		if (hasTilemapCollision)
+		{
+			auto tilemapCollision = archetype.GetProvider<C_TilemapCollision>().begin();
+			for (std::size_t i = body; i < body + entityCount; ++i, ++tilemapCollision)
+			{
+				m_Bodies.m_Flags[i] |= tilemapCollision->m_OnGround ? IntegrationFlag_OnGround : 0;
+			}
+		}
+
+		body += entityCount;
+	}
+}
+
+void S_PhysicsIntegration::Scatter(float deltaTime)
+{
+	std::size_t body = 0;
+
+	for (const ArchetypeRange & range : m_Ranges)
+	{
+		alvere::Archetype & archetype = *range.m_Archetype;
+		std::size_t first = body;
+
+		auto transform = archetype.GetProvider<alvere::C_Transform>().begin();
+		auto velocity = archetype.GetProvider<C_Velocity>().begin();
+
+		for (std::size_t i = 0; i < archetype.GetEntityCount(); ++i, ++body, ++transform, ++velocity)
+		{
+			velocity->m_Velocity = alvere::Vector2(m_Bodies.m_VelocityX[body], m_Bodies.m_VelocityY[body]);
+
+			//S_Velocity
+			(*transform)->move(velocity->m_Velocity * deltaTime);
+		}
+
+		if (range.m_Flags & IntegrationFlag_Jump)
+		{
+			auto movement = archetype.GetProvider<C_Movement>().begin();
+			for (std::size_t i = first; i < body; ++i, ++movement)
+			{
+				movement->m_JumpTimeRemaining = m_Bodies.m_JumpTimeRemaining[i];
+			}
+		}
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+#include <alvere/world/world.hpp>
+#include <alvere/world/system/updated_system.hpp>
+#include <alvere/world/archetype/archetype_query.hpp>
+
+#include "physics/integration.hpp"
+
+//Does the work of S_Movement, S_Jump, S_Gravity, S_Friction and S_Velocity in a single pass.
+//Bodies are gathered from every C_Transform + C_Velocity archetype into structure of arrays form,
+//integrated by IntegrateBodies and then written back in the same order, moving each transform as it goes.
+class S_PhysicsIntegration : public alvere::UpdatedSystem
+{
+	struct ArchetypeRange
+	{
+		alvere::Archetype * m_Archetype;
+		std::uint32_t m_Flags;
+	};
+
+	IntegrationParameters m_Parameters;
+
+	alvere::Archetype::Query m_Query;
+	std::vector<std::reference_wrapper<alvere::Archetype>> m_Archetypes;
+	std::vector<ArchetypeRange> m_Ranges;
+
+	IntegrationBodies m_Bodies;
+
+public:
+
+	S_PhysicsIntegration(const IntegrationParameters & parameters);
+
+	void Update(alvere::World & world, float deltaTime) override;
+
+	const IntegrationParameters & GetParameters() const { return m_Parameters; }
+
+private:
+
+	void Gather(alvere::World & world);
+	void Scatter(float deltaTime);
+};
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <cmath>
+
+#include <alvere/world/archetype/archetype.hpp>
+#include <alvere/world/archetype/archetype_provider_iterator.hpp>
+#include <alvere/world/component/components/c_transform.hpp>
+#include <alvere/world/component/components/c_previous_transform.hpp>
+
+#include "s_physics_pipeline.hpp"
+#include "components/physics/c_velocity.hpp"
+#include "components/physics/c_sleeping.hpp"
+
+S_PhysicsPipeline::S_PhysicsPipeline(float stepRate, float maxSubstepDistance, unsigned int maxSubsteps, unsigned int maxStepsPerTick)
+	: m_StepDuration(1.0f / stepRate)
+	, m_MaxSubstepDistance(maxSubstepDistance)
+	, m_MaxSubsteps(maxSubsteps)
+	, m_MaxStepsPerTick(maxStepsPerTick)
+	, m_Accumulator(0.0f)
+	, m_LastTickDuration(0.0f)
+	, m_LastSubstepCount(0)
+	, m_SnapshotQuery(alvere::Archetype::Query().Include<alvere::C_Transform, alvere::C_PreviousTransform>().Exclude<C_Sleeping>())
+	, m_VelocityQuery(alvere::Archetype::Query().Include<C_Velocity>().Exclude<C_Sleeping>())
+{
+}
+
+void S_PhysicsPipeline::Update(alvere::World & world, float deltaTime)
+{
+	m_LastTickDuration = deltaTime;
+	m_Accumulator += deltaTime;
+
+	unsigned int steps = 0;
+	while (m_Accumulator >= m_StepDuration && steps < m_MaxStepsPerTick)
+	{
+		m_Accumulator -= m_StepDuration;
+		++steps;
+
+		SnapshotTransforms(world);
+
+		m_LastSubstepCount = CalculateSubstepCount(world);
+		float substepDuration = m_StepDuration / m_LastSubstepCount;
+
+		for (unsigned int substep = 0; substep < m_LastSubstepCount; ++substep)
+		{
+			for (std::unique_ptr<alvere::UpdatedSystem> & system : m_Systems)
+			{
+				system->Update(world, substepDuration);
+			}
+		}
+	}
+
+	//If we've fallen too far behind, drop the time instead of trying to catch up forever
+	m_Accumulator = std::min(m_Accumulator, m_StepDuration);
+}
+
+float S_PhysicsPipeline::GetInterpolation(float tickInterpolation) const
+{
+	float alpha = (m_Accumulator + tickInterpolation * m_LastTickDuration) / m_StepDuration;
+	return std::min(std::max(alpha, 0.0f), 1.0f);
+}
+
+void S_PhysicsPipeline::SnapshotTransforms(alvere::World & world)
+{
+	world.QueryArchetypes(m_SnapshotQuery, m_Archetypes);
+
+	for (alvere::Archetype & archetype : m_Archetypes)
+	{
+		alvere::ArchetypeProviderIterator<alvere::C_Transform, alvere::C_PreviousTransform> iterator(archetype.GetEntityCount(), archetype.GetProvider<alvere::C_Transform>(), archetype.GetProvider<alvere::C_PreviousTransform>());
+
+		for (; iterator; ++iterator)
+		{
+			auto components = iterator.GetComponents();
+			alvere::C_Transform & transform = std::get<0>(components);
+			alvere::C_PreviousTransform & previous = std::get<1>(components);
+
+			previous.snapshot(transform.m_transform);
+		}
+	}
+}
+
+unsigned int S_PhysicsPipeline::CalculateSubstepCount(alvere::World & world)
+{
+	world.QueryArchetypes(m_VelocityQuery, m_Archetypes);
+
+	float maxSpeedSq = 0.0f;
+	for (alvere::Archetype & archetype : m_Archetypes)
+	{
+		alvere::ArchetypeProviderIterator<C_Velocity> iterator(archetype.GetEntityCount(), archetype.GetProvider<C_Velocity>());
+
+		for (; iterator; ++iterator)
+		{
+			const C_Velocity & velocity = std::get<0>(iterator.GetComponents());
+			maxSpeedSq = std::max(maxSpeedSq, velocity.m_Velocity.magnitudeSq());
+		}
+	}
+
+	float stepDistance = std::sqrt(maxSpeedSq) * m_StepDuration;
+	unsigned int substeps = (unsigned int) std::ceil(stepDistance / m_MaxSubstepDistance);
+
+	return std::min(std::max(substeps, 1u), m_MaxSubsteps);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <alvere/world/world.hpp>
+#include <alvere/world/system/updated_system.hpp>
+#include <alvere/world/archetype/archetype_query.hpp>
+
+//Runs the physics systems in a fixed order at their own fixed rate, independent of the game tick rate.
+//Each step is split into substeps when the fastest body would otherwise move further than m_MaxSubstepDistance,
+//so fast bodies can't tunnel through tiles. Entities with a C_PreviousTransform have their pose recorded
+//before every step so they can be drawn interpolated between steps.
+class S_PhysicsPipeline : public alvere::UpdatedSystem
+{
+	std::vector<std::unique_ptr<alvere::UpdatedSystem>> m_Systems;
+
+	float m_StepDuration;
+	float m_MaxSubstepDistance;
+	unsigned int m_MaxSubsteps;
+	unsigned int m_MaxStepsPerTick;
+
+	float m_Accumulator;
+	float m_LastTickDuration;
+	unsigned int m_LastSubstepCount;
+
+	alvere::Archetype::Query m_SnapshotQuery;
+	alvere::Archetype::Query m_VelocityQuery;
+	std::vector<std::reference_wrapper<alvere::Archetype>> m_Archetypes;
+
+public:
+
+	S_PhysicsPipeline(float stepRate = 60.0f, float maxSubstepDistance = 0.5f, unsigned int maxSubsteps = 8, unsigned int maxStepsPerTick = 4);
+
+	//Systems run in the order they are added
+	template <typename T, typename... Args>
+	T * AddSystem(Args &&... args);
+
+	void Update(alvere::World & world, float deltaTime) override;
+
+	//Converts how far the frame is between game ticks into how far it is between physics steps
+	float GetInterpolation(float tickInterpolation) const;
+
+	void SetStepRate(float stepRate) { m_StepDuration = 1.0f / stepRate; }
+	float GetStepDuration() const { return m_StepDuration; }
+	unsigned int GetLastSubstepCount() const { return m_LastSubstepCount; }
+
+private:
+
+	void SnapshotTransforms(alvere::World & world);
+	unsigned int CalculateSubstepCount(alvere::World & world);
+};
+
+template <typename T, typename... Args>
+T * S_PhysicsPipeline::AddSystem(Args &&... args)
+{
+	T * system = new T(std::forward<Args>(args)...);
+	m_Systems.emplace_back(system);
+	return system;
+}
@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <cmath>
+#include <typeinfo>
+
+#include <alvere/world/archetype/archetype.hpp>
+#include <alvere/world/archetype/archetype_provider_iterator.hpp>
+#include <alvere/world/component/components/c_camera.hpp>
+#include <alvere/world/component/components/c_transform.hpp>
+#include <alvere/world/component/components/c_previous_transform.hpp>
+
+#include "s_sleep.hpp"
+#include "components/physics/c_collider.hpp"
+#include "components/physics/c_sleep.hpp"
+#include "components/physics/c_sleeping.hpp"
+#include "components/physics/c_velocity.hpp"
+
+//Resting colliders are pushed out until they only just touch, so grow the bounds a little when looking for contacts
+static const float s_contactMargin = 0.05f;
+
+S_Sleep::S_Sleep(float sleepSpeed, unsigned int sleepTicks, float sleepDistance, float wakeDistance, float cellSize)
+	: m_SleepSpeedSq(sleepSpeed * sleepSpeed)
+	, m_SleepTicks(sleepTicks)
+	, m_SleepDistance(sleepDistance)
+	, m_WakeDistance(wakeDistance)
+	, m_CameraQuery(alvere::Archetype::Query().Include<alvere::C_Camera>())
+	, m_AwakeQuery(alvere::Archetype::Query().Include<alvere::C_Transform, C_Velocity, C_Sleep>().Exclude<C_Sleeping>())
+	, m_ColliderQuery(alvere::Archetype::Query().Include<alvere::C_Transform, C_Collider, C_Velocity>().Exclude<C_Sleeping>())
+	, m_SleepingGrid(cellSize)
+{
+}
+
+void S_Sleep::Update(alvere::World & world, float deltaTime)
+{
+	GatherCameras(world);
+
+	FindEntitiesToWake(world);
+	for (alvere::EntityHandle & entity : m_ToWake)
+	{
+		//The grid can still hold entities that were woken some other way or destroyed while asleep
+		m_SleepingGrid.RemoveProxy(entity);
+
+		if (entity.isValid() && IsSleeping(entity))
+		{
+			Wake(world, entity);
+		}
+	}
+
+	FindEntitiesToSleep(world);
+	for (SleepRequest & request : m_ToSleep)
+	{
+		Sleep(world, request.m_Entity, request.m_Reason);
+	}
+}
+
+bool S_Sleep::IsSleeping(const alvere::EntityHandle & entity)
+{
+	const auto & providers = entity->m_Archetype->GetProviders();
+	return providers.find(typeid(C_Sleeping)) != providers.end();
+}
+
+void S_Sleep::Wake(alvere::World & world, alvere::EntityHandle & entity)
+{
+	if (IsSleeping(entity))
+	{
+		world.RemoveComponent<C_Sleeping>(entity);
+	}
+
+	C_Sleep * sleep = entity->m_Archetype->TryGetComponent<C_Sleep>(entity);
+	if (sleep != nullptr)
+	{
+		sleep->m_StillTicks = 0;
+	}
+}
+
+void S_Sleep::ApplyImpulse(alvere::World & world, alvere::EntityHandle & entity, alvere::Vector2 impulse)
+{
+	Wake(world, entity);
+
+	world.GetComponent<C_Velocity>(entity).m_Velocity += impulse;
+}
+
+void S_Sleep::GatherCameras(alvere::World & world)
+{
+	m_Cameras.clear();
+	world.QueryArchetypes(m_CameraQuery, m_Archetypes);
+
+	for (alvere::Archetype & archetype : m_Archetypes)
+	{
+		alvere::ArchetypeProviderIterator<alvere::C_Camera> iterator(archetype.GetEntityCount(), archetype.GetProvider<alvere::C_Camera>());
+
+		for (; iterator; ++iterator)
+		{
+			const alvere::C_Camera & camera = std::get<0>(iterator.GetComponents());
+			m_Cameras.emplace_back(camera.getPosition());
+		}
+	}
+}
+
+void S_Sleep::FindEntitiesToSleep(alvere::World & world)
+{
+	m_ToSleep.clear();
+	world.QueryArchetypes(m_AwakeQuery, m_Archetypes);
+
+	for (alvere::Archetype & archetype : m_Archetypes)
+	{
+		for (const alvere::EntityHandle & entity : archetype.GetEntities())
+		{
+			C_Sleep & sleep = archetype.GetComponent<C_Sleep>(entity);
+			const C_Velocity & velocity = archetype.GetComponent<C_Velocity>(entity);
+
+			sleep.m_StillTicks = velocity.m_Velocity.magnitudeSq() < m_SleepSpeedSq ? sleep.m_StillTicks + 1 : 0;
+
+			//Without any cameras there is nothing to be far away from
+			alvere::Vector2 position = archetype.GetComponent<alvere::C_Transform>(entity)->getPosition();
+			bool farFromCameras = m_Cameras.empty() == false && IsNearCamera(position, m_SleepDistance) == false;
+
+			if (sleep.m_StillTicks >= m_SleepTicks)
+			{
+				m_ToSleep.push_back({ entity, C_Sleeping::Reason::Idle });
+			}
+			else if (farFromCameras)
+			{
+				m_ToSleep.push_back({ entity, C_Sleeping::Reason::Distant });
+			}
+		}
+	}
+}
+
+void S_Sleep::FindEntitiesToWake(alvere::World & world)
+{
+	m_ToWake.clear();
+
+	if (m_SleepingGrid.GetProxyCount() == 0)
+	{
+		return;
+	}
+
+	m_InView.clear();
+	for (alvere::Vector2 camera : m_Cameras)
+	{
+		alvere::Vector2 extents(m_WakeDistance, m_WakeDistance);
+		m_SleepingGrid.Query(alvere::Rect(camera - extents, extents * 2.0f), m_InView);
+	}
+
+	//Only bodies put to sleep for being far away wake when a camera comes near. Waking idle ones here would wake
+	//everything resting on screen each tick, just for it to fall back asleep and change archetype again.
+	//Stale proxies are passed through too, so Update() removes them from the grid.
+	for (alvere::EntityHandle & entity : m_InView)
+	{
+		if (entity.isValid() == false
+		 || IsSleeping(entity) == false
+		 || world.GetComponent<C_Sleeping>(entity).m_Reason == C_Sleeping::Reason::Distant)
+		{
+			m_ToWake.emplace_back(entity);
+		}
+	}
+
+	world.QueryArchetypes(m_ColliderQuery, m_Archetypes);
+
+	for (alvere::Archetype & archetype : m_Archetypes)
+	{
+		for (const alvere::EntityHandle & entity : archetype.GetEntities())
+		{
+			//Otherwise two entities resting against each other would keep waking each other up
+			if (archetype.GetComponent<C_Velocity>(entity).m_Velocity.magnitudeSq() < m_SleepSpeedSq)
+			{
+				continue;
+			}
+
+			alvere::Rect bounds = CalculateBounds(archetype, entity);
+
+			//Anything woken out here would only fall straight back asleep
+			if (m_Cameras.empty() == false && IsNearCamera(bounds.getBottomLeft(), m_SleepDistance) == false)
+			{
+				continue;
+			}
+
+			alvere::Vector2 margin(s_contactMargin, s_contactMargin);
+			m_SleepingGrid.Query(alvere::Rect(bounds.getBottomLeft() - margin, alvere::Vector2(bounds.m_width, bounds.m_height) + margin * 2.0f), m_ToWake);
+		}
+	}
+}
+
+void S_Sleep::Sleep(alvere::World & world, alvere::EntityHandle & entity, C_Sleeping::Reason reason)
+{
+	alvere::Archetype & archetype = *entity->m_Archetype;
+
+	m_SleepingGrid.UpdateProxy(entity, CalculateBounds(archetype, entity));
+
+	//Stop drawing it part way between its last two poses
+	alvere::C_PreviousTransform * previous = archetype.TryGetComponent<alvere::C_PreviousTransform>(entity);
+	if (previous != nullptr)
+	{
+		previous->snapshot(archetype.GetComponent<alvere::C_Transform>(entity).m_transform);
+	}
+
+	world.AddComponent<C_Sleeping>(entity);
+	world.GetComponent<C_Sleeping>(entity).m_Reason = reason;
+}
+
+bool S_Sleep::IsNearCamera(alvere::Vector2 position, float distance) const
+{
+	for (alvere::Vector2 camera : m_Cameras)
+	{
+		if (std::abs(position.x - camera.x) <= distance && std::abs(position.y - camera.y) <= distance)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+alvere::Rect S_Sleep::CalculateBounds(const alvere::Archetype & archetype, const alvere::EntityHandle & entity)
+{
+	alvere::Vector2 position = archetype.GetComponent<alvere::C_Transform>(entity)->getPosition();
+
+	const C_Collider * collider = archetype.TryGetComponent<C_Collider>(entity);
+	if (collider == nullptr || collider->m_ColliderInstances.empty())
+	{
+		return alvere::Rect(position, alvere::Vector2(0.0f, 0.0f));
+	}
+
+	alvere::Vector2 lower = position + collider->m_ColliderInstances[0].m_LocalBounds.getBottomLeft();
+	alvere::Vector2 upper = position + collider->m_ColliderInstances[0].m_LocalBounds.getTopRight();
+
+	for (const ColliderInstance & instance : collider->m_ColliderInstances)
+	{
+		lower = alvere::Vector2(std::min(lower.x, position.x + instance.m_LocalBounds.getLeft()), std::min(lower.y, position.y + instance.m_LocalBounds.getBottom()));
+		upper = alvere::Vector2(std::max(upper.x, position.x + instance.m_LocalBounds.getRight()), std::max(upper.y, position.y + instance.m_LocalBounds.getTop()));
+	}
+
+	return alvere::Rect(lower, upper - lower);
+}
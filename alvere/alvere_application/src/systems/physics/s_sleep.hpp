@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+
+#include <alvere/math/vectors.hpp>
+#include <alvere/utils/shapes.hpp>
+#include <alvere/world/world.hpp>
+#include <alvere/world/system/updated_system.hpp>
+#include <alvere/world/archetype/archetype_query.hpp>
+
+#include "components/physics/c_sleeping.hpp"
+#include "physics/broadphase.hpp"
+
+//Puts C_Sleep entities to sleep by tagging them with C_Sleeping, which the physics systems exclude.
+//An entity falls asleep after moving slower than the sleep speed for enough ticks in a row, or when it is
+//further than the sleep distance from every camera. Distances are measured along the furthest axis, like the view.
+//Sleeping entities are kept in their own grid so waking them only costs as much as the awake entities and cameras
+//that look at it. They wake when a moving collider touches them, or when Wake() or ApplyImpulse() is called on them.
+//Entities that fell asleep for being far away also wake when a camera comes within the wake distance.
+class S_Sleep : public alvere::UpdatedSystem
+{
+	struct SleepRequest
+	{
+		alvere::EntityHandle m_Entity;
+		C_Sleeping::Reason m_Reason;
+	};
+
+	float m_SleepSpeedSq;
+	unsigned int m_SleepTicks;
+	float m_SleepDistance;
+	float m_WakeDistance;
+
+	alvere::Archetype::Query m_CameraQuery;
+	alvere::Archetype::Query m_AwakeQuery;
+	alvere::Archetype::Query m_ColliderQuery;
+	std::vector<std::reference_wrapper<alvere::Archetype>> m_Archetypes;
+
+	Broadphase m_SleepingGrid;
+
+	std::vector<alvere::Vector2> m_Cameras;
+	std::vector<SleepRequest> m_ToSleep;
+	std::vector<alvere::EntityHandle> m_ToWake;
+	std::vector<alvere::EntityHandle> m_InView;
+
+public:
+
+	//The wake distance should be less than the sleep distance so entities on the edge don't flip every tick
+	S_Sleep(float sleepSpeed = 0.1f, unsigned int sleepTicks = 30, float sleepDistance = 48.0f, float wakeDistance = 40.0f, float cellSize = 8.0f);
+
+	void Update(alvere::World & world, float deltaTime) override;
+
+	std::size_t GetSleepingCount() const { return m_SleepingGrid.GetProxyCount(); }
+
+	static bool IsSleeping(const alvere::EntityHandle & entity);
+
+	static void Wake(alvere::World & world, alvere::EntityHandle & entity);
+
+	//Adds to the entity's velocity, waking it first if it is asleep
+	static void ApplyImpulse(alvere::World & world, alvere::EntityHandle & entity, alvere::Vector2 impulse);
+
+private:
+
+	void GatherCameras(alvere::World & world);
+	void FindEntitiesToSleep(alvere::World & world);
+	void FindEntitiesToWake(alvere::World & world);
+
+	void Sleep(alvere::World & world, alvere::EntityHandle & entity, C_Sleeping::Reason reason);
+
+	bool IsNearCamera(alvere::Vector2 position, float distance) const;
+
+	static alvere::Rect CalculateBounds(const alvere::Archetype & archetype, const alvere::EntityHandle & entity);
+};
@@ -4,47 +4,82 @@
 #include <alvere/world/archetype/archetype_provider_iterator.hpp>
 
 #include "s_tilemap_collision_resolution.hpp"
-
-void S_TilemapCollisionResolution::Update(float deltaTime, alvere::C_Transform & transform, C_Velocity & velocity, const C_Collider & collider, C_TilemapCollision & tilemapCollision)
+#include "components/physics/c_sleeping.hpp"
+
+S_TilemapCollisionResolution::S_TilemapCollisionResolution(alvere::World & world, alvere::ThreadPool * threadPool)
+	: m_World(world)
+	, m_ThreadPool(threadPool)
+	, m_TilemapQuery(alvere::Archetype::Query().Include<C_Tilemap>())
+	, m_EntityQuery(alvere::Archetype::Query().Include<alvere::C_Transform, C_Velocity, C_Collider, C_TilemapCollision>().Exclude<C_Sleeping>())
+	, m_Scratch(threadPool != nullptr ? threadPool->getThreadCount() : 1)
 {
-	//Reset all physics flags
-	tilemapCollision.m_OnGround = false;
-
-	//Find all the tilemaps in the world
-	alvere::Archetype::Query query;
-	query.Include<C_Tilemap>();
+}
 
-	std::vector<std::reference_wrapper<alvere::Archetype>> matchingArchetypes;
-	m_World.QueryArchetypes(query, matchingArchetypes);
+void S_TilemapCollisionResolution::Update(alvere::World & world, float deltaTime)
+{
+	//Find all the tilemaps in the world once, rather than for every entity
+	m_Tilemaps.clear();
+	m_World.QueryArchetypes(m_TilemapQuery, m_Archetypes);
 
-	for (alvere::Archetype & archetype : matchingArchetypes)
+	for (alvere::Archetype & archetype : m_Archetypes)
 	{
 		alvere::ArchetypeProviderIterator<C_Tilemap> iterator(archetype.GetEntityCount(), archetype.GetProvider<C_Tilemap>());
 
 		for (; iterator; ++iterator)
 		{
-			auto queryTuple = iterator.GetComponents();
-			C_Tilemap & tilemap = std::get<0>(queryTuple);
+			m_Tilemaps.push_back(&std::get<0>(iterator.GetComponents()).get());
+		}
+	}
+
+	m_World.QueryArchetypes(m_EntityQuery, m_Archetypes);
+
+	for (alvere::Archetype & archetype : m_Archetypes)
+	{
+		auto transforms = archetype.GetProvider<alvere::C_Transform>().begin();
+		auto velocities = archetype.GetProvider<C_Velocity>().begin();
+		auto colliders = archetype.GetProvider<C_Collider>().begin();
+		auto tilemapCollisions = archetype.GetProvider<C_TilemapCollision>().begin();
+
+		auto resolveRange = [&](std::size_t begin, std::size_t end, unsigned int thread)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				ResolveCollision(tilemapCollisions[i], colliders[i], transforms[i], velocities[i], m_Scratch[thread]);
+			}
+		};
 
-			ResolveCollision(tilemap, tilemapCollision, collider, transform, velocity);
+		if (m_ThreadPool != nullptr)
+		{
+			//Resolving a single entity is cheap, so don't bother splitting small archetypes up
+			m_ThreadPool->parallelFor(archetype.GetEntityCount(), resolveRange, 64);
+		}
+		else
+		{
+			resolveRange(0, archetype.GetEntityCount(), 0);
 		}
 	}
 }
 
-void S_TilemapCollisionResolution::ResolveCollision(const C_Tilemap & tilemap, C_TilemapCollision & tilemapCollision, const C_Collider & collider, alvere::C_Transform & transform, C_Velocity & velocity)
+void S_TilemapCollisionResolution::ResolveCollision(C_TilemapCollision & tilemapCollision, const C_Collider & collider, alvere::C_Transform & transform, C_Velocity & velocity, std::vector<alvere::Vector2i> & scratch)
 {
-	for (const ColliderInstance & colliderInstance : collider.m_ColliderInstances)
+	//Reset all physics flags
+	tilemapCollision.m_OnGround = false;
+
+	for (const C_Tilemap * tilemap : m_Tilemaps)
 	{
-		ResolveCollisionWithCollider(tilemap, tilemapCollision, colliderInstance, transform, velocity);
+		for (const ColliderInstance & colliderInstance : collider.m_ColliderInstances)
+		{
+			ResolveCollisionWithCollider(*tilemap, tilemapCollision, colliderInstance, transform, velocity, scratch);
+		}
 	}
 }
 
-void S_TilemapCollisionResolution::ResolveCollisionWithCollider(const C_Tilemap & tilemap, C_TilemapCollision & tilemapCollision, const ColliderInstance & collider, alvere::C_Transform & transform, C_Velocity & velocity)
+void S_TilemapCollisionResolution::ResolveCollisionWithCollider(const C_Tilemap & tilemap, C_TilemapCollision & tilemapCollision, const ColliderInstance & collider, alvere::C_Transform & transform, C_Velocity & velocity, std::vector<alvere::Vector2i> & collidedTiles)
 {
 	alvere::Vector2 transformPosition = transform->getPosition();
 
 	//Store positions of collided tiles
-	std::vector<alvere::Vector2i> collidedTiles;
+	collidedTiles.clear();
 
 	//Grab collider info
 	alvere::Vector2 colliderLocalLowerBound = collider.m_LocalBounds.getBottomLeft();
@@ -70,7 +105,7 @@ void S_TilemapCollisionResolution::ResolveCollisionWithCollider(const C_Tilemap
 		for (int x = lower[0]; x <= upper[0]; ++x)
 		{
 			alvere::Vector2i queryPosition{ x, y };
-			if (tilemap.TileCollides_s(queryPosition))
+			if (tilemap.TileCollides_s(queryPosition, collider.m_Category, collider.m_Mask))
 			{
 				collidedTiles.emplace_back(queryPosition);
 			}
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <vector>
+
 #include <alvere/math/vectors.hpp>
 #include <alvere/world/world.hpp>
-#include <alvere/world/system/query_updated_system.hpp>
+#include <alvere/utils/thread_pool.hpp>
+#include <alvere/world/system/updated_system.hpp>
+#include <alvere/world/archetype/archetype_query.hpp>
 #include <alvere/world/component/components/c_transform.hpp>
 
 #include "tilemap/tile.hpp"
@@ -11,22 +15,29 @@
 #include "components/physics/c_velocity.hpp"
 #include "components/physics/c_collider.hpp"
 
-class S_TilemapCollisionResolution : public alvere::QueryUpdatedSystem<alvere::C_Transform, C_Velocity, const C_Collider, C_TilemapCollision>
+//Pushes entities out of any solid tiles they overlap. Entities are split across the thread pool; each one only
+//reads the tilemaps and writes its own transform, velocity and collision flags, so the result matches a serial run.
+class S_TilemapCollisionResolution : public alvere::UpdatedSystem
 {
-
 	alvere::World & m_World;
+	alvere::ThreadPool * m_ThreadPool;
+
+	alvere::Archetype::Query m_TilemapQuery;
+	alvere::Archetype::Query m_EntityQuery;
+	std::vector<std::reference_wrapper<alvere::Archetype>> m_Archetypes;
+	std::vector<const C_Tilemap *> m_Tilemaps;
+
+	//Collided tiles for each thread, reused between entities and ticks to avoid allocating
+	std::vector<std::vector<alvere::Vector2i>> m_Scratch;
 
 public:
 
-	S_TilemapCollisionResolution(alvere::World & world)
-		: m_World( world )
-	{
-	}
+	S_TilemapCollisionResolution(alvere::World & world, alvere::ThreadPool * threadPool = nullptr);
 
-	void Update(float deltaTime, alvere::C_Transform & transform, C_Velocity & velocity, const C_Collider & collider, C_TilemapCollision & tilemapCollision);
+	void Update(alvere::World & world, float deltaTime) override;
 
-	void ResolveCollision(const C_Tilemap & tilemap, C_TilemapCollision & tilemapCollision, const C_Collider & collider, alvere::C_Transform & transform, C_Velocity & velocity);
-	void ResolveCollisionWithCollider(const C_Tilemap & tilemap, C_TilemapCollision & tilemapCollision, const ColliderInstance & collider, alvere::C_Transform & transform, C_Velocity & velocity);
+	void ResolveCollision(C_TilemapCollision & tilemapCollision, const C_Collider & collider, alvere::C_Transform & transform, C_Velocity & velocity, std::vector<alvere::Vector2i> & scratch);
+	void ResolveCollisionWithCollider(const C_Tilemap & tilemap, C_TilemapCollision & tilemapCollision, const ColliderInstance & collider, alvere::C_Transform & transform, C_Velocity & velocity, std::vector<alvere::Vector2i> & collidedTiles);
 	alvere::Vector2 CalculateResolutionVectorFromTile(const C_Tilemap & level, alvere::Vector2 colliderCenter, alvere::Vector2 colliderSize, alvere::Vector2i tilePosition);
 
-};
+};
\ No newline at end of file
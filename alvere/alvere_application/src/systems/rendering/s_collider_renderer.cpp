@@ -4,7 +4,8 @@ S_ColliderRenderer::S_ColliderRenderer(alvere::Camera & camera, const alvere::Sp
 	: m_camera(camera)
 	, m_Sprite(sprite)
 {
-	m_spriteBatcher = alvere::SpriteBatcher::New();
+	//A debug overlay, so it doesn't need the GPU storage the default capacity reserves. Going over just splits the draw.
+	m_spriteBatcher = alvere::SpriteBatcher::New(1024);
 }
 
 void S_ColliderRenderer::Render(alvere::World & world)
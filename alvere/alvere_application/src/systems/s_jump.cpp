@@ -3,26 +3,25 @@
 S_Jump::S_Jump(float strength, float duration)
 	: m_Strength(strength)
 	, m_Duration(duration)
-	, m_DurationRemaining(-1)
 {
 }
 
-void S_Jump::Update(float deltaTime, const C_TilemapCollision & tilemapCollision, const C_Movement & movement, C_Velocity & velocity)
+void S_Jump::Update(float deltaTime, const C_TilemapCollision & tilemapCollision, C_Movement & movement, C_Velocity & velocity)
 {
 	if (movement.m_Jump == false)
 	{
-		m_DurationRemaining = -1;
+		movement.m_JumpTimeRemaining = -1;
 		return;
 	}
 
 	if (tilemapCollision.m_OnGround)
 	{
-		m_DurationRemaining = m_Duration;
+		movement.m_JumpTimeRemaining = m_Duration;
 	}
 	
-	if (m_DurationRemaining > 0.0f)
+	if (movement.m_JumpTimeRemaining > 0.0f)
 	{
-		m_DurationRemaining -= deltaTime;
+		movement.m_JumpTimeRemaining -= deltaTime;
 		velocity.m_Velocity.y = m_Strength;
 	}
 }
\ No newline at end of file
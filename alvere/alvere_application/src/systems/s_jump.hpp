@@ -7,16 +7,14 @@
 #include "components/physics/c_movement.hpp"
 #include "components/physics/c_velocity.hpp"
 
-class S_Jump : public alvere::QueryUpdatedSystem<const C_TilemapCollision, const C_Movement, C_Velocity>
+class S_Jump : public alvere::QueryUpdatedSystem<const C_TilemapCollision, C_Movement, C_Velocity>
 {
 	const float m_Strength;
 	const float m_Duration;
 
-	float m_DurationRemaining;
-
 public:
 
 	S_Jump(float strength, float duration);
 
-	void Update(float deltaTime, const C_TilemapCollision & tilemapCollision, const C_Movement & movement, C_Velocity & velocity);
+	void Update(float deltaTime, const C_TilemapCollision & tilemapCollision, C_Movement & movement, C_Velocity & velocity);
 };
\ No newline at end of file
@@ -1,21 +1,129 @@
+#include <algorithm>
+#include <cmath>
+
 #include "s_tilemap_renderer.hpp"
 #include "tilemap/tile.hpp"
 
 
 S_TilemapRenderer::S_TilemapRenderer(alvere::Camera & camera)
 	: m_camera(camera)
-	, m_spriteBatcher(alvere::SpriteBatcher::New())
 	, m_fallbackTexture(alvere::Texture::New("res/img/tiles/missing_tile.png"))
+	, m_atlasVersion(0)
+	, m_frame(0)
+	, m_chunksRebuilt(0)
 {
 }
 
+void S_TilemapRenderer::Render(alvere::World & world)
+{
+	++m_frame;
+	m_chunksRebuilt = 0;
+
+	alvere::QueryRenderedSystem<const C_Tilemap>::Render(world);
+
+	for (auto iter = m_caches.begin(); iter != m_caches.end();)
+	{
+		iter = iter->second.m_lastRenderedFrame != m_frame
+			? m_caches.erase(iter)
+			: std::next(iter);
+	}
+}
+
 void S_TilemapRenderer::Render(const C_Tilemap & tilemap)
 {
-	m_spriteBatcher->begin(m_camera.getProjectionViewMatrix());
+	TilemapCache & cache = m_caches[&tilemap];
+	cache.m_lastRenderedFrame = m_frame;
 
-	for (std::size_t y = 0; y < tilemap.m_size[1]; ++y)
+	alvere::Vector2i chunkCount = tilemap.GetChunkCount();
+	if (cache.m_chunkCount[0] != chunkCount[0] || cache.m_chunkCount[1] != chunkCount[1])
 	{
-		for (std::size_t x = 0; x < tilemap.m_size[0]; ++x)
+		cache.m_chunks.clear();
+		cache.m_chunks.resize(chunkCount[0] * chunkCount[1]);
+		cache.m_chunkCount = chunkCount;
+	}
+
+	UpdateAtlas(tilemap);
+
+	const alvere::Matrix4 & projectionView = m_camera.getProjectionViewMatrix();
+
+	//Only chunks in view are drawn or rebuilt. Anything edited off screen keeps its old version and is rebuilt once it comes into view.
+	alvere::Rect view = m_camera.getVisibleBounds();
+	alvere::Vector2 chunkSize = tilemap.m_tileSize * (float)C_Tilemap::CHUNK_SIZE;
+
+	int minX = std::max(0, (int)std::floor(view.getLeft() / chunkSize.x));
+	int minY = std::max(0, (int)std::floor(view.getBottom() / chunkSize.y));
+	int maxX = std::min(chunkCount[0], (int)std::ceil(view.getRight() / chunkSize.x));
+	int maxY = std::min(chunkCount[1], (int)std::ceil(view.getTop() / chunkSize.y));
+
+	for (int y = minY; y < maxY; ++y)
+	{
+		for (int x = minX; x < maxX; ++x)
+		{
+			Chunk & chunk = cache.m_chunks[x + y * chunkCount[0]];
+
+			//Editing how a tile looks can change any chunk that uses it, and rebuilding the atlas moves every tile
+			if (chunk.m_batch == nullptr
+			 || chunk.m_version != tilemap.GetChunkVersion({ x, y })
+			 || chunk.m_tileAppearanceVersion != C_Tilemap::GetTileAppearanceVersion()
+			 || chunk.m_atlasVersion != m_atlasVersion)
+			{
+				RebuildChunk(tilemap, { x, y }, chunk);
+			}
+
+			chunk.m_batch->draw(projectionView);
+		}
+	}
+}
+
+void S_TilemapRenderer::UpdateAtlas(const C_Tilemap & tilemap)
+{
+	bool added = false;
+
+	for (const Tile & tile : tilemap.m_tiles)
+	{
+		const alvere::Texture * texture = tile.m_spritesheet.m_texture.getAssetPtr();
+
+		//Textures too large for a page are remembered too, so they aren't retried every frame
+		if (texture != nullptr && m_atlasTextures.insert(texture).second)
+		{
+			m_atlas.add(*texture);
+			added = true;
+		}
+	}
+
+	if (added == false)
+	{
+		return;
+	}
+
+	if (m_atlasTextures.insert(m_fallbackTexture.get()).second)
+	{
+		m_atlas.add(*m_fallbackTexture);
+	}
+
+	m_atlas.build();
+	++m_atlasVersion;
+}
+
+void S_TilemapRenderer::RebuildChunk(const C_Tilemap & tilemap, alvere::Vector2i chunkPosition, Chunk & chunk)
+{
+	if (chunk.m_batch == nullptr)
+	{
+		chunk.m_batch = alvere::StaticSpriteBatch::New();
+	}
+
+	chunk.m_version = tilemap.GetChunkVersion(chunkPosition);
+	chunk.m_tileAppearanceVersion = C_Tilemap::GetTileAppearanceVersion();
+	chunk.m_atlasVersion = m_atlasVersion;
+	++m_chunksRebuilt;
+
+	alvere::RectI bounds = tilemap.GetChunkBounds(chunkPosition);
+
+	chunk.m_batch->begin();
+
+	for (int y = bounds.getBottom(); y < bounds.getTop(); ++y)
+	{
+		for (int x = bounds.getLeft(); x < bounds.getRight(); ++x)
 		{
 			TileInstance & instance = tilemap.m_map[x + y * tilemap.m_size[0]];
 
@@ -24,17 +132,18 @@ void S_TilemapRenderer::Render(const C_Tilemap & tilemap)
 			if (instance.m_tile == nullptr)
 			{
 				//Cannot render a tile that doesn't exist, so instead render the fallback
-				m_spriteBatcher->submit(m_fallbackTexture.get(), position);
+				alvere::TextureAtlas::Region fallback = m_atlas.remap(*m_fallbackTexture, m_fallbackTexture->getBounds());
+				chunk.m_batch->submit(fallback.m_texture, position, fallback.m_source);
 				continue;
 			}
 
 			Spritesheet & spritesheet = instance.m_tile->m_spritesheet;
 
-			alvere::RectI sourceRect = spritesheet.GetSourceRect(instance.m_spritesheetCoordinate);
+			alvere::TextureAtlas::Region region = spritesheet.GetSourceRegion(instance.m_spritesheetCoordinate, m_atlas);
 
-			m_spriteBatcher->submit(spritesheet.m_texture.getAssetPtr(), position, sourceRect);
+			chunk.m_batch->submit(region.m_texture, position, region.m_source);
 		}
 	}
 
-	m_spriteBatcher->end();
-}
\ No newline at end of file
+	chunk.m_batch->end();
+}
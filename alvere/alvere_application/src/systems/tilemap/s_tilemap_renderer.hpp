@@ -1,22 +1,74 @@
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include <alvere/world/system/query_rendered_system.hpp>
-#include <alvere\graphics\sprite_batcher.hpp>
+#include <alvere\graphics\static_sprite_batch.hpp>
 #include <alvere\graphics\camera.hpp>
+#include <alvere\graphics\texture_atlas.hpp>
 
 #include "components/tilemap/c_tilemap.hpp"
 
+//Draws tilemaps from vertex data baked per chunk and kept on the GPU between frames.
+//A chunk is only rebuilt when its version in the tilemap changes, so a static map costs no per-tile work to draw.
+//Chunks outside the camera's view are skipped, so the cost follows the screen area rather than the map size.
+//Tile textures are packed into an atlas as they are first seen, so a chunk normally draws from a single texture.
 class S_TilemapRenderer : public alvere::QueryRenderedSystem<const C_Tilemap>
 {
-	alvere::Camera & m_camera;
+	struct Chunk
+	{
+		std::unique_ptr<alvere::StaticSpriteBatch> m_batch;
+		unsigned int m_version = 0;
+
+		//Tracked per chunk rather than per tilemap, so chunks that were off screen during an edit still catch up
+		unsigned int m_tileAppearanceVersion = 0;
+
+		//Chunks hold pointers to the atlas pages, so they must be rebuilt before being drawn after the atlas is
+		unsigned int m_atlasVersion = 0;
+	};
 
-	std::unique_ptr<alvere::SpriteBatcher> m_spriteBatcher;
+	struct TilemapCache
+	{
+		std::vector<Chunk> m_chunks;
+		alvere::Vector2i m_chunkCount = { 0, 0 };
+		unsigned int m_lastRenderedFrame = 0;
+	};
+
+	alvere::Camera & m_camera;
 
 	std::unique_ptr<alvere::Texture> m_fallbackTexture;
 
+	alvere::TextureAtlas m_atlas;
+	std::unordered_set<const alvere::Texture *> m_atlasTextures;
+	unsigned int m_atlasVersion;
+
+	//Keyed by the component's address. If it moves the cache is rebuilt, and caches for tilemaps that are
+	//no longer drawn are thrown away at the end of the frame.
+	std::unordered_map<const C_Tilemap *, TilemapCache> m_caches;
+	unsigned int m_frame;
+
+	unsigned int m_chunksRebuilt;
+
 public:
 
 	S_TilemapRenderer(alvere::Camera & camera);
 
+	void Render(alvere::World & world) override;
+
 	void Render(const C_Tilemap & tilemap) override;
-};
\ No newline at end of file
+
+	//Number of chunks that had to be rebuilt during the last frame
+	unsigned int GetChunksRebuilt() const { return m_chunksRebuilt; }
+
+	std::size_t GetAtlasPageCount() const { return m_atlas.getPageCount(); }
+
+private:
+
+	//Packs any tile textures the atlas hasn't seen yet
+	void UpdateAtlas(const C_Tilemap & tilemap);
+
+	void RebuildChunk(const C_Tilemap & tilemap, alvere::Vector2i chunkPosition, Chunk & chunk);
+};
@@ -6,6 +6,16 @@ alvere::RectI Spritesheet::GetSourceRect(alvere::Vector2i spritesheetCoord) cons
 	return alvere::RectI(position[0], position[1], m_tileSize[0], m_tileSize[1]);
 }
 
+alvere::TextureAtlas::Region Spritesheet::GetSourceRegion(alvere::Vector2i spritesheetCoord, const alvere::TextureAtlas & atlas) const
+{
+	if (m_texture.getAssetPtr() == nullptr)
+	{
+		return { nullptr, GetSourceRect(spritesheetCoord) };
+	}
+
+	return atlas.remap(*m_texture, GetSourceRect(spritesheetCoord));
+}
+
 bool Spritesheet::operator==(const Spritesheet & rhs)
 {
 	return m_texture == rhs.m_texture
@@ -2,6 +2,7 @@
 
 #include <alvere/utils/assets.hpp>
 #include <alvere/graphics/texture.hpp>
+#include <alvere/graphics/texture_atlas.hpp>
 #include <alvere/math/vectors.hpp>
 
 struct Spritesheet
@@ -11,5 +12,8 @@ struct Spritesheet
 
 	alvere::RectI GetSourceRect(alvere::Vector2i spritesheetCoord) const;
 
+	//The page and source rect to draw with if the texture has been packed into the atlas
+	alvere::TextureAtlas::Region GetSourceRegion(alvere::Vector2i spritesheetCoord, const alvere::TextureAtlas & atlas) const;
+
 	bool operator==(const Spritesheet & rhs);
 };
\ No newline at end of file
@@ -3,5 +3,7 @@
 bool Tile::operator==(const Tile & rhs)
 {
 	return m_collides == rhs.m_collides
+		&& m_collisionCategory == rhs.m_collisionCategory
+		&& m_collisionMask == rhs.m_collisionMask
 		&& m_spritesheet == rhs.m_spritesheet;
 }
\ No newline at end of file
@@ -1,14 +1,21 @@
 #pragma once
 
+#include <cstdint>
+
 #include <alvere/math/vectors.hpp>
 
 #include "spritesheet.hpp"
+#include "physics/collision_layers.hpp"
 
 struct Tile
 {
 	bool m_collides;
 	Spritesheet m_spritesheet;
 
+	//Only used when m_collides is set
+	std::uint32_t m_collisionCategory = CollisionLayer_Default;
+	std::uint32_t m_collisionMask = CollisionLayer_All;
+
 	bool operator==(const Tile & rhs);
 };
 
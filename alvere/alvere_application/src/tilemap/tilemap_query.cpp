@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "tilemap/tilemap_query.hpp"
+#include "components/tilemap/c_tilemap.hpp"
+
+TilemapQuery::TilemapQuery(const C_Tilemap & tilemap, std::uint32_t category, std::uint32_t mask)
+	: m_Tilemap(tilemap)
+	, m_Category(category)
+	, m_Mask(mask)
+{
+}
+
+bool TilemapQuery::Raycast(alvere::Vector2 origin, alvere::Vector2 direction, float maxDistance, TilemapRaycastHit & hit) const
+{
+	const float infinity = std::numeric_limits<float>::infinity();
+
+	alvere::Vector2i tile = m_Tilemap.WorldToTilemap(origin);
+
+	if (IsSolid(tile))
+	{
+		hit = TilemapRaycastHit{ tile, origin, alvere::Vector2(0.0f, 0.0f), 0.0f };
+		return true;
+	}
+
+	float directionLength = direction.magnitude();
+	if (directionLength == 0.0f || maxDistance <= 0.0f)
+	{
+		return false;
+	}
+
+	direction /= directionLength;
+
+	//Everything below is done in tile space where each tile is a unit square,
+	//with t being the fraction of the ray travelled so far
+	alvere::Vector2 localOrigin = m_Tilemap.WorldToLocal(origin);
+	alvere::Vector2 localRay = m_Tilemap.WorldToLocal(direction * maxDistance);
+
+	int step[2];
+	float tMax[2];
+	float tDelta[2];
+
+	for (int i = 0; i < 2; ++i)
+	{
+		if (localRay[i] > 0.0f)
+		{
+			step[i] = 1;
+			tDelta[i] = 1.0f / localRay[i];
+			tMax[i] = (tile[i] + 1 - localOrigin[i]) * tDelta[i];
+		}
+		else if (localRay[i] < 0.0f)
+		{
+			step[i] = -1;
+			tDelta[i] = -1.0f / localRay[i];
+			tMax[i] = (localOrigin[i] - tile[i]) * tDelta[i];
+		}
+		else
+		{
+			step[i] = 0;
+			tDelta[i] = infinity;
+			tMax[i] = infinity;
+		}
+	}
+
+	alvere::RectI bounds = m_Tilemap.GetBounds();
+
+	while (true)
+	{
+		int axis = tMax[0] < tMax[1] ? 0 : 1;
+		float t = tMax[axis];
+
+		if (t > 1.0f)
+		{
+			return false;
+		}
+
+		tile[axis] += step[axis];
+		tMax[axis] += tDelta[axis];
+
+		//Once the ray has left the map while heading away from it, there is nothing left to hit
+		if ((step[0] > 0 && tile[0] >= bounds.getRight()) || (step[0] < 0 && tile[0] < bounds.getLeft())
+		 || (step[1] > 0 && tile[1] >= bounds.getTop()) || (step[1] < 0 && tile[1] < bounds.getBottom()))
+		{
+			return false;
+		}
+
+		if (IsSolid(tile))
+		{
+			alvere::Vector2 normal(0.0f, 0.0f);
+			normal[axis] = (float) -step[axis];
+
+			hit.m_Tile = tile;
+			hit.m_Distance = t * maxDistance;
+			hit.m_Point = origin + direction * hit.m_Distance;
+			hit.m_Normal = normal;
+			return true;
+		}
+	}
+}
+
+std::size_t TilemapQuery::OverlapBox(const alvere::Rect & box, alvere::RectI * spans, std::size_t maxSpans) const
+{
+	alvere::RectI area = GetOverlappedTiles(box);
+
+	std::size_t spanCount = 0;
+
+	for (int y = area.getBottom(); y < area.getTop(); ++y)
+	{
+		int spanStart = -1;
+
+		for (int x = area.getLeft(); x <= area.getRight(); ++x)
+		{
+			bool solid = x < area.getRight() && IsSolid({ x, y });
+
+			if (solid && spanStart == -1)
+			{
+				spanStart = x;
+			}
+			else if (solid == false && spanStart != -1)
+			{
+				if (spanCount == maxSpans)
+				{
+					return spanCount;
+				}
+
+				spans[spanCount++] = alvere::RectI(spanStart, y, x - spanStart, 1);
+				spanStart = -1;
+			}
+		}
+	}
+
+	return spanCount;
+}
+
+bool TilemapQuery::IsBoxFree(const alvere::Rect & box) const
+{
+	alvere::RectI area = GetOverlappedTiles(box);
+
+	for (int y = area.getBottom(); y < area.getTop(); ++y)
+	{
+		for (int x = area.getLeft(); x < area.getRight(); ++x)
+		{
+			if (IsSolid({ x, y }))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool TilemapQuery::SweepBox(const alvere::Rect & box, alvere::Vector2 displacement, TilemapSweepHit & hit) const
+{
+	const float infinity = std::numeric_limits<float>::infinity();
+
+	alvere::Rect endBox(box.getBottomLeft() + displacement, alvere::Vector2(box.m_width, box.m_height));
+	alvere::RectI area = alvere::RectI::overlap(alvere::RectI::encapsulate(GetTileRange(box), GetTileRange(endBox)), m_Tilemap.GetBounds());
+
+	//Sweeping the box against a tile is the same as casting its center against the tile grown by the box half size
+	alvere::Vector2 localHalfSize = m_Tilemap.WorldToLocal(alvere::Vector2(box.m_width, box.m_height)) / 2.0f;
+	alvere::Vector2 localCenter = m_Tilemap.WorldToLocal(box.getBottomLeft()) + localHalfSize;
+	alvere::Vector2 localDisplacement = m_Tilemap.WorldToLocal(displacement);
+
+	bool found = false;
+	hit.m_Time = infinity;
+
+	for (int y = area.getBottom(); y < area.getTop(); ++y)
+	{
+		for (int x = area.getLeft(); x < area.getRight(); ++x)
+		{
+			if (IsSolid({ x, y }) == false)
+			{
+				continue;
+			}
+
+			float tEnter = -infinity;
+			float tExit = infinity;
+			int enterAxis = -1;
+			bool missed = false;
+
+			for (int i = 0; i < 2; ++i)
+			{
+				float min = (i == 0 ? x : y) - localHalfSize[i];
+				float max = (i == 0 ? x : y) + 1 + localHalfSize[i];
+
+				if (localDisplacement[i] == 0.0f)
+				{
+					if (localCenter[i] <= min || localCenter[i] >= max)
+					{
+						missed = true;
+						break;
+					}
+
+					continue;
+				}
+
+				float t1 = (min - localCenter[i]) / localDisplacement[i];
+				float t2 = (max - localCenter[i]) / localDisplacement[i];
+
+				if (t1 > t2)
+				{
+					std::swap(t1, t2);
+				}
+
+				if (t1 > tEnter)
+				{
+					tEnter = t1;
+					enterAxis = i;
+				}
+
+				tExit = std::min(tExit, t2);
+			}
+
+			if (missed || tEnter >= tExit || tEnter > 1.0f || tExit <= 0.0f)
+			{
+				continue;
+			}
+
+			float time = std::max(tEnter, 0.0f);
+
+			if (time >= hit.m_Time)
+			{
+				continue;
+			}
+
+			alvere::Vector2 normal(0.0f, 0.0f);
+			if (tEnter >= 0.0f && enterAxis != -1)
+			{
+				normal[enterAxis] = localDisplacement[enterAxis] > 0.0f ? -1.0f : 1.0f;
+			}
+
+			found = true;
+			hit.m_Tile = { x, y };
+			hit.m_Normal = normal;
+			hit.m_Time = time;
+		}
+	}
+
+	return found;
+}
+
+alvere::RectI TilemapQuery::GetOverlappedTiles(const alvere::Rect & box) const
+{
+	return alvere::RectI::overlap(GetTileRange(box), m_Tilemap.GetBounds());
+}
+
+alvere::RectI TilemapQuery::GetTileRange(const alvere::Rect & box) const
+{
+	alvere::Vector2i lower = m_Tilemap.WorldToTilemap(box.getBottomLeft());
+
+	//The top and right edges are exclusive, so a box resting exactly on a tile edge does not count as overlapping it
+	alvere::Vector2 localUpper = m_Tilemap.WorldToLocal(box.getTopRight());
+	alvere::Vector2i upper{ (int) std::ceil(localUpper.x), (int) std::ceil(localUpper.y) };
+
+	return alvere::RectI(lower, alvere::Vector2i::max(upper - lower, { 0, 0 }));
+}
+
+bool TilemapQuery::IsSolid(alvere::Vector2i tile) const
+{
+	return m_Tilemap.TileCollides_s(tile, m_Category, m_Mask);
+}
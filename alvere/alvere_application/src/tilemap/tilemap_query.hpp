@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <alvere/math/vectors.hpp>
+#include <alvere/utils/shapes.hpp>
+
+#include "physics/collision_layers.hpp"
+
+struct C_Tilemap;
+
+struct TilemapRaycastHit
+{
+	alvere::Vector2i m_Tile;
+	alvere::Vector2 m_Point;
+	alvere::Vector2 m_Normal;
+	float m_Distance;
+};
+
+struct TilemapSweepHit
+{
+	alvere::Vector2i m_Tile;
+	alvere::Vector2 m_Normal;
+
+	//Fraction of the displacement [0, 1] that can be travelled before touching the tile
+	float m_Time;
+};
+
+//Read-only spatial queries against the solid tiles of a tilemap.
+//Only tiles whose collision filter matches the query's category and mask count as solid.
+//None of these allocate, so they are safe to run for every agent every tick.
+class TilemapQuery
+{
+	const C_Tilemap & m_Tilemap;
+	std::uint32_t m_Category;
+	std::uint32_t m_Mask;
+
+public:
+
+	TilemapQuery(const C_Tilemap & tilemap, std::uint32_t category = CollisionLayer_All, std::uint32_t mask = CollisionLayer_All);
+
+	//Walks the grid cells the ray passes through (Amanatides & Woo) and reports the first solid one.
+	//If the origin is already inside a solid tile the hit has a distance of zero and no normal.
+	bool Raycast(alvere::Vector2 origin, alvere::Vector2 direction, float maxDistance, TilemapRaycastHit & hit) const;
+
+	//Writes each horizontal run of solid tiles overlapping the box as a one tile high rect into spans.
+	//Returns the number of spans written, which is never more than maxSpans.
+	std::size_t OverlapBox(const alvere::Rect & box, alvere::RectI * spans, std::size_t maxSpans) const;
+
+	bool IsBoxFree(const alvere::Rect & box) const;
+
+	//Moves the box along displacement and reports the earliest solid tile it touches.
+	//Tiles the box already overlaps at the start report a time of zero and no normal.
+	bool SweepBox(const alvere::Rect & box, alvere::Vector2 displacement, TilemapSweepHit & hit) const;
+
+	//Tiles overlapped by the box, treating the box as open on its top and right edges, clamped to the tilemap bounds
+	alvere::RectI GetOverlappedTiles(const alvere::Rect & box) const;
+
+private:
+
+	alvere::RectI GetTileRange(const alvere::Rect & box) const;
+
+	bool IsSolid(alvere::Vector2i tile) const;
+};